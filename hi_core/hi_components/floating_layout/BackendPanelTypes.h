@@ -627,6 +627,16 @@ public:
 		g.setFont(GLOBAL_BOLD_FONT());
 		auto top = area.removeFromTop(32).reduced(4);
 		g.drawText(pool->getStatistics(), top, Justification::left);
+
+		// The shared cache is process-wide, so it's shown next to the pool statistics instead of being part of them
+		auto sharedStatistics = PoolHelpers::getSharedCacheStatistics(static_cast<const DataType*>(nullptr));
+
+		if (sharedStatistics.isNotEmpty())
+		{
+			top.removeFromRight(2 * 28 + 4);
+			g.setFont(GLOBAL_FONT());
+			g.drawText("Shared cache: " + sharedStatistics, top, Justification::right);
+		}
 	}
 
 	void cellDoubleClicked(int rowNumber, int /*columnId*/, const MouseEvent&)
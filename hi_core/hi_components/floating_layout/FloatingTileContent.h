@@ -362,6 +362,7 @@ public:
 			SampleMapPoolTable,
 			MidiFilePoolTable,
 			PerformanceStatistics,
+			CpuProfileTable,
 			ActivityLed,
             MatrixPeakMeterPanel,
 			ActivationPanel,
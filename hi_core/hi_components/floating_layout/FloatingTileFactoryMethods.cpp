@@ -108,6 +108,7 @@ void FloatingTileContent::Factory::registerFrontendPanelTypes()
 	registerType<AboutPagePanel>(PopupMenuOptions::AboutPage);
 	registerType<MidiKeyboardPanel>(PopupMenuOptions::MidiKeyboard);
 	registerType<PerformanceLabelPanel>(PopupMenuOptions::PerformanceStatistics);
+	registerType<CpuProfilerPanel>(PopupMenuOptions::CpuProfileTable);
 	registerType<MidiOverlayPanel>(PopupMenuOptions::MidiPlayerOverlay);
 	registerType<ActivityLedPanel>(PopupMenuOptions::ActivityLed);
     registerType<CustomSettingsWindowPanel>(PopupMenuOptions::PluginSettings);
@@ -587,6 +588,7 @@ void FloatingTileContent::Factory::handlePopupMenu(PopupMenu& m, FloatingTile* p
 
 			addToPopupMenu(fm, PopupMenuOptions::InterfaceContent, "Main Interface");
 			addToPopupMenu(fm, PopupMenuOptions::PerformanceStatistics, "Performance Statistics");
+			addToPopupMenu(fm, PopupMenuOptions::CpuProfileTable, "CPU Profiler");
 			addToPopupMenu(fm, PopupMenuOptions::ActivityLed, "MIDI Activity LED");
 			addToPopupMenu(fm, PopupMenuOptions::PluginSettings, "Plugin Settings");
 			addToPopupMenu(fm, PopupMenuOptions::MidiSourceList, "Midi Source List");
@@ -713,6 +715,7 @@ void FloatingTileContent::Factory::handlePopupMenu(PopupMenu& m, FloatingTile* p
 	case PopupMenuOptions::ActivityLed:		    parent->setNewContent(GET_PANEL_NAME(ActivityLedPanel)); break;
 	case PopupMenuOptions::PluginSettings:		parent->setNewContent(GET_PANEL_NAME(CustomSettingsWindowPanel)); break;
 	case PopupMenuOptions::PerformanceStatistics: parent->setNewContent(GET_PANEL_NAME(PerformanceLabelPanel)); break;
+	case PopupMenuOptions::CpuProfileTable:		parent->setNewContent(GET_PANEL_NAME(CpuProfilerPanel)); break;
 	case PopupMenuOptions::MidiSourceList:		parent->setNewContent(GET_PANEL_NAME(MidiSourcePanel)); break;
 	case PopupMenuOptions::MidiChannelList:		parent->setNewContent(GET_PANEL_NAME(MidiChannelPanel)); break;
 	case PopupMenuOptions::MidiLearnPanel:		parent->setNewContent(GET_PANEL_NAME(MidiLearnPanel)); break;
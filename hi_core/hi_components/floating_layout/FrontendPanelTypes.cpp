@@ -878,6 +878,92 @@ bool PerformanceLabelPanel::showTitleInPresentationMode() const
 	return false;
 }
 
+CpuProfilerPanel::CpuProfilerPanel(FloatingTile* parent) :
+	FloatingTileContent(parent)
+{
+	setDefaultPanelColour(PanelColourId::bgColour, Colour(0xFF262626));
+	setDefaultPanelColour(PanelColourId::textColour, Colours::white.withAlpha(0.8f));
+	setDefaultPanelColour(PanelColourId::itemColour1, Colour(SIGNAL_COLOUR).withAlpha(0.3f));
+
+	startTimer(500);
+}
+
+void CpuProfilerPanel::timerCallback()
+{
+	statistics = getMainController()->getCpuProfiler().getStatistics();
+	repaint();
+}
+
+void CpuProfilerPanel::paint(Graphics& g)
+{
+	g.fillAll(findPanelColour(PanelColourId::bgColour));
+
+	auto f = getFont();
+	auto rowHeight = (int)f.getHeight() + 6;
+	auto textColour = findPanelColour(PanelColourId::textColour);
+	auto barColour = findPanelColour(PanelColourId::itemColour1);
+
+	g.setFont(f);
+
+	auto b = getLocalBounds().reduced(5, 0);
+
+	auto drawRow = [&](Rectangle<int> r, const StringArray& columns)
+	{
+		auto idArea = r.removeFromLeft(r.getWidth() / 3);
+		g.drawText(columns[0], idArea, Justification::centredLeft, true);
+
+		auto w = r.getWidth() / (columns.size() - 1);
+
+		for (int i = 1; i < columns.size(); i++)
+			g.drawText(columns[i], r.removeFromLeft(w), Justification::centredRight, true);
+	};
+
+	g.setColour(textColour);
+	drawRow(b.removeFromTop(rowHeight), { "Module", "Avg (us)", "P50", "P99", "Max", "Budget", "Peak" });
+
+	g.setColour(textColour.withAlpha(0.2f));
+	g.drawHorizontalLine(b.getY(), (float)b.getX(), (float)b.getRight());
+
+	for (const auto& s : statistics)
+	{
+		if (b.getHeight() < rowHeight)
+			break;
+
+		auto r = b.removeFromTop(rowHeight);
+
+		g.setColour(barColour);
+		g.fillRect(r.withWidth(roundToInt((float)r.getWidth() * jlimit(0.0f, 1.0f, (float)s.averageBudget * 0.01f))));
+
+		g.setColour(textColour);
+
+		drawRow(r, { s.id,
+					 String(s.average, 1),
+					 String(s.p50, 1),
+					 String(s.p99, 1),
+					 String(s.max, 1),
+					 String(s.averageBudget, 1) + "%",
+					 String(s.peakBudget, 1) + "%" });
+	}
+
+	if (statistics.isEmpty())
+	{
+		g.setColour(textColour.withAlpha(0.5f));
+		g.drawText("No measurements", b, Justification::centred);
+	}
+}
+
+void CpuProfilerPanel::mouseDown(const MouseEvent& e)
+{
+	if (e.getNumberOfClicks() == 1)
+		SystemClipboard::copyTextToClipboard(JSON::toString(getMainController()->getCpuProfiler().toJSON()));
+}
+
+void CpuProfilerPanel::mouseDoubleClick(const MouseEvent&)
+{
+	getMainController()->getCpuProfiler().reset();
+	timerCallback();
+}
+
 TooltipPanel::TooltipPanel(FloatingTile* parent) :
 	FloatingTileContent(parent)
 {
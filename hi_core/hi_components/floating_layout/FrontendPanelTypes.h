@@ -443,6 +443,56 @@ private:
 	ScopedPointer<Label> statisticLabel;
 };
 
+/**
+Type-ID: `CpuProfiler`
+
+A table that shows the render time statistics of every module (the average, median, 99th percentile and maximum time
+per block as well as the average and peak share of the block budget). Click on the table to copy the statistics as JSON
+to the clipboard, double click to reset them. If you need more customization, use the scripting call `Engine.getCpuProfile()`.
+
+### Used base properties:
+
+| ID | Description |
+| --- | --- |
+`ColourData::textColour`  | the text colour
+`ColourData::bgColour`    | the background colour
+`ColourData::itemColour1` | the colour of the budget bars
+`Font`					  | the font
+`FontSize`				  | the font size
+
+### Example JSON
+
+```
+const var data = {
+"Type": "CpuProfiler",
+"FontSize": 13,
+"ColourData": {
+"textColour": "0xFFEEEEEE"
+}
+};
+```
+
+*/
+class CpuProfilerPanel : public Component,
+	public Timer,
+	public FloatingTileContent
+{
+public:
+
+	CpuProfilerPanel(FloatingTile* parent);
+
+	SET_PANEL_NAME("CpuProfiler");
+
+	void timerCallback() override;
+	void paint(Graphics& g) override;
+	void mouseDown(const MouseEvent& e) override;
+	void mouseDoubleClick(const MouseEvent& e) override;
+
+private:
+
+	Array<CpuProfiler::Statistics> statistics;
+};
+
 
 /** Type-ID: `PresetBrowser`
 
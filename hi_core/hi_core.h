@@ -300,6 +300,15 @@ Set this to the number of macros you want in your project. */
 #define HISE_NUM_MACROS 8
 #endif
 
+/** Config: HISE_USE_COMPILED_MACRO_CONNECTIONS
+
+If enabled, the macro connections are compiled into a flat list whenever they change, so moving a macro doesn't need to
+resolve the parameter data of its targets. The targets are notified the same way in both modes. Set this to 0 to resolve every
+parameter when a macro moves. */
+#ifndef HISE_USE_COMPILED_MACRO_CONNECTIONS
+#define HISE_USE_COMPILED_MACRO_CONNECTIONS 1
+#endif
+
 /** Config: ENABLE_SCRIPTING_SAFE_CHECKS
 
 Set this to 0 to deactivate the safe checks for scripting
@@ -494,6 +503,60 @@ If enabled, the plugin will ignore any plugin parameter definitions from the scr
 #define HISE_MACROS_ARE_PLUGIN_PARAMETERS 0
 #endif
 
+/** Config: HISE_USE_LAZY_IMAGE_POOL
+
+If enabled, the embedded PNG images of the image pool will not be decoded when the plugin is loaded. Instead they are decoded on a background thread
+(or when they are painted the first time) and evicted with a LRU policy if the decoded images exceed HISE_LAZY_IMAGE_POOL_MEMORY_MB.
+
+ */
+#ifndef HISE_USE_LAZY_IMAGE_POOL
+#define HISE_USE_LAZY_IMAGE_POOL 0
+#endif
+
+/** Config: HISE_LAZY_IMAGE_POOL_MEMORY_MB
+
+The maximum amount of memory (in megabytes) that the decoded images of the lazy image pool can use before the least recently used images are evicted.
+
+ */
+#ifndef HISE_LAZY_IMAGE_POOL_MEMORY_MB
+#define HISE_LAZY_IMAGE_POOL_MEMORY_MB 512
+#endif
+
+/** Config: HISE_USE_INCREMENTAL_PRESET_LOAD
+
+If enabled, user presets are compared against the current state before loading. If only the values of UI controls differ, the changed
+controls are applied directly without killing the voices and suspending the audio processing. You can also change this at runtime
+with UserPresetHandler.setUseIncrementalPresetLoading(). If a changed control is connected to anything but a master effect (directly
+or through a macro), the preset is loaded the normal way.
+
+ */
+#ifndef HISE_USE_INCREMENTAL_PRESET_LOAD
+#define HISE_USE_INCREMENTAL_PRESET_LOAD 0
+#endif
+
+/** Config: HISE_ENABLE_CPU_PROFILER
+
+If enabled, the render time of every sound generator, effect, modulation chain, script callback and DSP network is measured
+and aggregated into histograms that you can query with Engine.getCpuProfile() or the CPU Profiler floating tile. The overhead
+is about 100ns per measured module and block, but you can set this to 0 to remove the profiler completely.
+
+ */
+#ifndef HISE_ENABLE_CPU_PROFILER
+#define HISE_ENABLE_CPU_PROFILER 1
+#endif
+
+/** Config: HISE_SAMPLE_ACCURATE_AUTOMATION
+
+If enabled, the host automation of plugin parameters is sent through a lock-free queue and applied as timestamped event
+by the sound generator that owns the automated module, so dense automation curves aren't quantised to the block size.
+Plugin parameters that fire a script callback are throttled. You can also change this at runtime with
+HostAutomationLane::setEnabled().
+
+ */
+#ifndef HISE_SAMPLE_ACCURATE_AUTOMATION
+#define HISE_SAMPLE_ACCURATE_AUTOMATION 0
+#endif
+
 #ifndef HISE_INCLUDE_BEATPORT
 #define HISE_INCLUDE_BEATPORT 0
 #endif
@@ -0,0 +1,524 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+namespace CpuProfilerHelpers
+{
+static std::atomic<uint32> instanceCounter { 0 };
+
+/** Caches the ring buffer of the current thread so that the lookup is only required once. */
+struct ThreadCache
+{
+	uint32 instanceId = 0;
+	void* buffer = nullptr;
+};
+
+static thread_local ThreadCache threadCache;
+
+// The owner of a buffer is temporarily set to this address while drain() releases it
+static char releaseMarker = 0;
+static Thread::ThreadID getReleaseMarker() noexcept { return static_cast<Thread::ThreadID>(&releaseMarker); }
+
+// 0.1 microseconds ... 100 milliseconds
+static constexpr double MinTime = 0.1;
+static constexpr double NumDecades = 6.0;
+}
+
+var CpuProfiler::Statistics::toJSON() const
+{
+	auto obj = new DynamicObject();
+
+	obj->setProperty("ID", id);
+	obj->setProperty("Category", getCategoryName(category));
+	obj->setProperty("NumCalls", numCalls);
+	obj->setProperty("NumBlocks", numBlocks);
+	obj->setProperty("Average", average);
+	obj->setProperty("P50", p50);
+	obj->setProperty("P99", p99);
+	obj->setProperty("Max", max);
+	obj->setProperty("AverageBudget", averageBudget);
+	obj->setProperty("PeakBudget", peakBudget);
+
+	return var(obj);
+}
+
+CpuProfiler::ThreadBuffer::ThreadBuffer() :
+	threadId(nullptr),
+	writing(false),
+	numWrites(0),
+	fifo(BufferSize)
+{
+	data.calloc(BufferSize);
+}
+
+void CpuProfiler::ThreadBuffer::push(const Measurement& m) noexcept
+{
+	int start1, size1, start2, size2;
+	fifo.prepareToWrite(1, start1, size1, start2, size2);
+
+	if (size1 > 0)
+		data[start1] = m;
+	else if (size2 > 0)
+		data[start2] = m;
+
+	fifo.finishedWrite(size1 + size2);
+	numWrites.fetch_add(1, std::memory_order_release);
+}
+
+void CpuProfiler::Entry::addBlock(double microseconds, double budget)
+{
+	numBlocks++;
+	sum += microseconds;
+	max = jmax(max, microseconds);
+
+	if (budget > 0.0)
+	{
+		auto b = 100.0 * microseconds / budget;
+		budgetSum += b;
+		peakBudget = jmax(peakBudget, b);
+	}
+
+	histogram[getBinForTime(microseconds)]++;
+}
+
+CpuProfiler::CpuProfiler(MainController* mc_) :
+	mc(mc_),
+	instanceId(++CpuProfilerHelpers::instanceCounter),
+	ticksToMicroseconds(1000000.0 / (double)Time::getHighResolutionTicksPerSecond()),
+	enabled(HISE_ENABLE_CPU_PROFILER),
+	blockIndex(0),
+	numSamplesPerBlock(0),
+	sampleRate(0.0),
+	blockDuration(0.0),
+	numDropped(0)
+{
+	if (isEnabled())
+		startTimer(100);
+}
+
+CpuProfiler::~CpuProfiler()
+{
+	stopTimer();
+}
+
+void CpuProfiler::beginBlock(int numSamples, double newSampleRate) noexcept
+{
+	if (!isEnabled())
+		return;
+
+	blockIndex.fetch_add(1, std::memory_order_relaxed);
+
+	if (numSamples != numSamplesPerBlock.load(std::memory_order_relaxed) ||
+		newSampleRate != sampleRate.load(std::memory_order_relaxed))
+	{
+		numSamplesPerBlock.store(numSamples);
+		sampleRate.store(newSampleRate);
+		blockDuration.store(newSampleRate > 0.0 ? 1000000.0 * (double)numSamples / newSampleRate : 0.0);
+	}
+}
+
+void CpuProfiler::setEnabled(bool shouldBeEnabled)
+{
+#if HISE_ENABLE_CPU_PROFILER
+	enabled.store(shouldBeEnabled);
+
+	if (shouldBeEnabled)
+		startTimer(100);
+	else
+		stopTimer();
+#else
+	ignoreUnused(shouldBeEnabled);
+#endif
+}
+
+Array<CpuProfiler::Statistics> CpuProfiler::getStatistics() const
+{
+	Array<Statistics> list;
+
+	ScopedLock sl(entryLock);
+
+	for (const auto& kv : entries)
+	{
+		const auto& e = kv.second;
+
+		if (e.processor == nullptr || e.numBlocks == 0)
+			continue;
+
+		Statistics s;
+		s.id = e.id;
+		s.category = e.category;
+		s.numCalls = e.numCalls;
+		s.numBlocks = e.numBlocks;
+		s.average = e.sum / (double)e.numBlocks;
+		s.max = e.max;
+		s.averageBudget = e.budgetSum / (double)e.numBlocks;
+		s.peakBudget = e.peakBudget;
+
+		auto p50Index = e.numBlocks / 2;
+		auto p99Index = (e.numBlocks * 99) / 100;
+		int numCounted = 0;
+		bool p50Found = false;
+
+		for (int i = 0; i < NumBins; i++)
+		{
+			numCounted += e.histogram[i];
+
+			if (!p50Found && numCounted > p50Index)
+			{
+				s.p50 = jmin(getTimeForBin(i), e.max);
+				p50Found = true;
+			}
+
+			if (numCounted > p99Index)
+			{
+				s.p99 = jmin(getTimeForBin(i), e.max);
+				break;
+			}
+		}
+
+		list.add(s);
+	}
+
+	struct Sorter
+	{
+		static int compareElements(const Statistics& a, const Statistics& b)
+		{
+			if (a.average > b.average)
+				return -1;
+			if (a.average < b.average)
+				return 1;
+			return 0;
+		}
+	} sorter;
+
+	list.sort(sorter);
+
+	return list;
+}
+
+var CpuProfiler::toJSON() const
+{
+	auto obj = new DynamicObject();
+
+	obj->setProperty("Enabled", isEnabled());
+	obj->setProperty("BlockSize", numSamplesPerBlock.load());
+	obj->setProperty("SampleRate", sampleRate.load());
+	obj->setProperty("BlockDuration", blockDuration.load());
+	obj->setProperty("NumDroppedMeasurements", getNumDroppedMeasurements());
+
+	auto overflow = HiseEventBuffer::getGlobalOverflowStatistics();
+	obj->setProperty("NumCoalescedEvents", overflow.numCoalesced);
+	obj->setProperty("NumDroppedEvents", overflow.numDropped);
+
+	Array<var> modules;
+
+	for (const auto& s : getStatistics())
+		modules.add(s.toJSON());
+
+	obj->setProperty("Modules", var(modules));
+
+	return var(obj);
+}
+
+void CpuProfiler::reset()
+{
+	ScopedLock sl(entryLock);
+	entries.clear();
+	numDropped.store(0);
+}
+
+String CpuProfiler::getCategoryName(Category c)
+{
+	switch (c)
+	{
+	case Category::Synth:			return "Synth";
+	case Category::Effect:			return "Effect";
+	case Category::ModulatorChain:	return "ModulatorChain";
+	case Category::ScriptCallback:	return "ScriptCallback";
+	case Category::DspNetwork:		return "DspNetwork";
+	default:						return {};
+	}
+}
+
+double CpuProfiler::getTimeForBin(int binIndex)
+{
+	using namespace CpuProfilerHelpers;
+	return MinTime * std::pow(10.0, NumDecades * (double)(binIndex + 1) / (double)NumBins);
+}
+
+int CpuProfiler::getBinForTime(double microseconds)
+{
+	using namespace CpuProfilerHelpers;
+
+	if (microseconds <= MinTime)
+		return 0;
+
+	auto normalised = std::log10(microseconds / MinTime) / NumDecades;
+	return jlimit(0, NumBins - 1, (int)(normalised * (double)NumBins));
+}
+
+void CpuProfiler::addToAccumulator(Accumulator& a, int64 ticks) noexcept
+{
+	auto thisBlock = getCurrentBlockIndex();
+
+	if (a.blockIndex != thisBlock)
+	{
+		if (a.numCalls > 0)
+			addMeasurement(a.processor, a.category, a.ticks, a.numCalls, a.blockIndex);
+
+		a.ticks = 0;
+		a.numCalls = 0;
+		a.blockIndex = thisBlock;
+	}
+
+	a.ticks += ticks;
+	a.numCalls++;
+}
+
+void CpuProfiler::addMeasurement(const Processor* p, Category c, int64 ticks, int numCalls, uint32 index) noexcept
+{
+	if (auto b = acquireBufferForCurrentThread())
+	{
+		Measurement m;
+		m.processor = p;
+		m.microseconds = (float)((double)ticks * ticksToMicroseconds);
+		m.blockIndex = index;
+		m.numCalls = (uint16)jmin(numCalls, 0xFFFF);
+		m.category = (uint8)c;
+
+		if (b->fifo.getFreeSpace() > 0)
+			b->push(m);
+		else
+			numDropped.fetch_add(1, std::memory_order_relaxed);
+
+		b->writing.store(false);
+	}
+	else
+		numDropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+CpuProfiler::ThreadBuffer* CpuProfiler::acquireBufferForCurrentThread() noexcept
+{
+	auto& cache = CpuProfilerHelpers::threadCache;
+	auto thisThread = Thread::getCurrentThreadId();
+
+	// Set the writing flag before checking the owner again, so that drain() either sees
+	// the flag or this thread sees that the buffer was released. The flag of a buffer
+	// that belongs to another thread must never be touched.
+	auto tryToUse = [thisThread](ThreadBuffer& b)
+	{
+		if (b.threadId.load() != thisThread)
+			return false;
+
+		b.writing.store(true);
+
+		if (b.threadId.load() == thisThread)
+			return true;
+
+		b.writing.store(false);
+		return false;
+	};
+
+	if (cache.instanceId == instanceId)
+	{
+		if (tryToUse(*static_cast<ThreadBuffer*>(cache.buffer)))
+			return static_cast<ThreadBuffer*>(cache.buffer);
+
+		// The buffer was released because this thread was idle
+		cache.instanceId = 0;
+	}
+
+	// The cache only holds the buffer of the last profiler that this thread used
+	for (auto& b : buffers)
+	{
+		if (tryToUse(b))
+		{
+			cache.instanceId = instanceId;
+			cache.buffer = &b;
+			return &b;
+		}
+	}
+
+	for (auto& b : buffers)
+	{
+		Thread::ThreadID expected = nullptr;
+
+		if (b.threadId.compare_exchange_strong(expected, thisThread) && tryToUse(b))
+		{
+			cache.instanceId = instanceId;
+			cache.buffer = &b;
+			return &b;
+		}
+	}
+
+	// More active threads than buffers, the measurements of this thread will be dropped
+	return nullptr;
+}
+
+void CpuProfiler::releaseIfIdle(ThreadBuffer& b, uint32 numWritesBeforeRead)
+{
+	auto owner = b.threadId.load();
+
+	if (owner == nullptr)
+		return;
+
+	if (numWritesBeforeRead != b.lastNumWrites)
+	{
+		b.lastNumWrites = numWritesBeforeRead;
+		b.numIdleDrains = 0;
+		return;
+	}
+
+	if (++b.numIdleDrains < NumIdleDrainsBeforeRelease)
+		return;
+
+	if (!b.threadId.compare_exchange_strong(owner, CpuProfilerHelpers::getReleaseMarker()))
+		return;
+
+	// The owner started to write again after the buffer was read, so we keep it
+	if (b.writing.load() || b.numWrites.load() != numWritesBeforeRead)
+	{
+		b.threadId.store(owner);
+		b.numIdleDrains = 0;
+		return;
+	}
+
+	// Nobody can write to the buffer now and it was read completely
+	b.fifo.reset();
+	b.numIdleDrains = 0;
+	b.threadId.store(nullptr);
+}
+
+void CpuProfiler::drain()
+{
+	auto budget = blockDuration.load();
+
+	// Don't resolve the processors while the module tree is rebuilt
+	auto canResolve = mc != nullptr &&
+					  mc->getKillStateHandler().isAudioRunning() &&
+					  mc->getMainSynthChain()->isValidAndInitialised();
+
+	std::map<const Processor*, Processor*> liveProcessors;
+	bool liveProcessorsCreated = false;
+
+	ScopedLock sl(entryLock);
+
+	for (auto& b : buffers)
+	{
+		auto numWritesBeforeRead = b.numWrites.load(std::memory_order_acquire);
+
+		int start1, size1, start2, size2;
+		b.fifo.prepareToRead(b.fifo.getNumReady(), start1, size1, start2, size2);
+
+		if (canResolve)
+		{
+			for (int i = 0; i < size1 + size2; i++)
+			{
+				const auto& m = i < size1 ? b.data[start1 + i] : b.data[start2 + i - size1];
+
+				if (m.processor == nullptr)
+					continue;
+
+				Key k(m.processor, (int)m.category);
+
+				auto it = entries.find(k);
+
+				// The processor was deleted and the address was reused
+				if (it != entries.end() && it->second.processor == nullptr)
+				{
+					entries.erase(it);
+					it = entries.end();
+				}
+
+				if (it == entries.end())
+				{
+					if (!liveProcessorsCreated)
+					{
+						Processor::Iterator<Processor> iter(mc->getMainSynthChain());
+
+						while (auto p = iter.getNextProcessor())
+							liveProcessors[p] = p;
+
+						liveProcessorsCreated = true;
+					}
+
+					auto lp = liveProcessors.find(m.processor);
+
+					if (lp == liveProcessors.end())
+						continue;
+
+					Entry e;
+					e.processor = lp->second;
+					e.category = (Category)m.category;
+					e.id = lp->second->getId();
+
+					if (e.category == Category::ModulatorChain)
+					{
+						if (auto parent = lp->second->getParentProcessor(false, false))
+							e.id = parent->getId() + "." + e.id;
+					}
+
+					it = entries.emplace(k, e).first;
+				}
+
+				auto& e = it->second;
+
+				e.numCalls += (int64)m.numCalls;
+
+				if (e.hasPendingBlock && e.currentBlock != m.blockIndex)
+				{
+					e.addBlock(e.currentBlockTime, budget);
+					e.currentBlockTime = 0.0;
+				}
+
+				e.currentBlock = m.blockIndex;
+				e.currentBlockTime += (double)m.microseconds;
+				e.hasPendingBlock = true;
+			}
+		}
+
+		b.fifo.finishedRead(size1 + size2);
+
+		releaseIfIdle(b, numWritesBeforeRead);
+	}
+
+	for (auto it = entries.begin(); it != entries.end();)
+	{
+		if (it->second.processor == nullptr)
+			it = entries.erase(it);
+		else
+			++it;
+	}
+}
+
+}
@@ -0,0 +1,307 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#pragma once
+
+namespace hise { using namespace juce;
+
+class Processor;
+class MainController;
+
+/** A low overhead profiler that measures the render time of every module.
+
+	Unlike the Perfetto traces this is available in every build (unless you set HISE_ENABLE_CPU_PROFILER
+	to 0) so you can ask a customer for a profile of a session in their DAW.
+
+	The audio thread only reads the high resolution clock and pushes a small record into a ring buffer
+	that belongs to the current thread, so there are no locks or allocations in the audio callback.
+	A buffer that wasn't written to for a few seconds is released so that other threads (eg. a new
+	audio device or an offline render thread) can use it. A timer on the message thread drains these buffers, resolves the processor IDs and aggregates
+	the time per block into a histogram, so you can query the median, the 99th percentile and the
+	maximum render time as well as the share of the block budget that each module consumes.
+
+	The times are inclusive: the time of a sound generator contains its modulation chains and effects.
+
+	The overhead is two calls to Time::getHighResolutionTicks() per measurement plus a ring buffer write.
+	This was measured with about 110ns on a virtualised Linux machine (it's less on systems with a cheaper
+	clock, the "CPU Profiler" unit test logs the value for the current system), so a project with 100 measured
+	modules spends about 11us or 0.1% of a 512 sample block at 44.1kHz in the profiler. Modules that are called
+	multiple times per block (eg. the modulation chains for each voice) use an Accumulator that sums up
+	the time and writes only one record per block.
+*/
+class CpuProfiler: private Timer
+{
+public:
+
+	enum class Category
+	{
+		Synth,
+		Effect,
+		ModulatorChain,
+		ScriptCallback,
+		DspNetwork,
+		numCategories
+	};
+
+	/** Sums up the time of multiple calls within one block and writes a single record. */
+	struct Accumulator
+	{
+		Accumulator(Category c) :
+			category(c)
+		{}
+
+		const Processor* processor = nullptr;
+		const Category category;
+
+		int64 ticks = 0;
+		int numCalls = 0;
+		uint32 blockIndex = 0;
+	};
+
+	/** Measures the lifetime of this object and adds it as a single call. */
+	struct ScopedMeasurement
+	{
+		ScopedMeasurement(CpuProfiler& p, const Processor* processor_, Category c) noexcept
+#if HISE_ENABLE_CPU_PROFILER
+			: profiler(p.isEnabled() ? &p : nullptr),
+			  processor(processor_),
+			  category(c),
+			  start(profiler != nullptr ? Time::getHighResolutionTicks() : 0)
+#endif
+		{
+			ignoreUnused(p, processor_, c);
+		}
+
+		~ScopedMeasurement()
+		{
+#if HISE_ENABLE_CPU_PROFILER
+			if (profiler != nullptr)
+				profiler->addMeasurement(processor, category, Time::getHighResolutionTicks() - start, 1, profiler->getCurrentBlockIndex());
+#endif
+		}
+
+	private:
+
+#if HISE_ENABLE_CPU_PROFILER
+		CpuProfiler* profiler;
+		const Processor* processor;
+		const Category category;
+		const int64 start;
+#endif
+	};
+
+	/** Measures the lifetime of this object and adds it to the accumulator. */
+	struct ScopedAccumulation
+	{
+		ScopedAccumulation(CpuProfiler& p, Accumulator& a_) noexcept
+#if HISE_ENABLE_CPU_PROFILER
+			: profiler(p.isEnabled() ? &p : nullptr),
+			  a(a_),
+			  start(profiler != nullptr ? Time::getHighResolutionTicks() : 0)
+#endif
+		{
+			ignoreUnused(p, a_);
+		}
+
+		~ScopedAccumulation()
+		{
+#if HISE_ENABLE_CPU_PROFILER
+			if (profiler != nullptr)
+				profiler->addToAccumulator(a, Time::getHighResolutionTicks() - start);
+#endif
+		}
+
+	private:
+
+#if HISE_ENABLE_CPU_PROFILER
+		CpuProfiler* profiler;
+		Accumulator& a;
+		const int64 start;
+#endif
+	};
+
+	/** The aggregated data of a single module. All times are in microseconds, the budget is in percent. */
+	struct Statistics
+	{
+		var toJSON() const;
+
+		String id;
+		Category category;
+
+		int64 numCalls = 0;
+		int numBlocks = 0;
+
+		double average = 0.0;
+		double p50 = 0.0;
+		double p99 = 0.0;
+		double max = 0.0;
+
+		double averageBudget = 0.0;
+		double peakBudget = 0.0;
+	};
+
+	CpuProfiler(MainController* mc);
+	~CpuProfiler();
+
+	/** Call this at the beginning of each audio callback. */
+	void beginBlock(int numSamples, double sampleRate) noexcept;
+
+	/** Enables or disables the measurements. */
+	void setEnabled(bool shouldBeEnabled);
+
+	bool isEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+
+	/** Returns the statistics of all modules that were measured since the last reset, sorted by their average time. */
+	Array<Statistics> getStatistics() const;
+
+	/** Returns the statistics as JSON object. */
+	var toJSON() const;
+
+	/** Clears all statistics. */
+	void reset();
+
+	/** Returns the number of records that were dropped because a ring buffer was full. */
+	int getNumDroppedMeasurements() const noexcept { return numDropped.load(); }
+
+	static String getCategoryName(Category c);
+
+	/** Converts the histogram bin to the upper edge of its time range in microseconds. */
+	static double getTimeForBin(int binIndex);
+
+	/** Converts the time in microseconds to a histogram bin. */
+	static int getBinForTime(double microseconds);
+
+	static constexpr int NumBins = 128;
+
+	/** The number of threads that can be measured at the same time. */
+	static constexpr int NumThreadBuffers = 8;
+
+	/** The buffer of a thread is released after this many drains without a measurement (5 seconds with the default timer). */
+	static constexpr int NumIdleDrainsBeforeRelease = 50;
+
+	/** Drains the ring buffers. This is called periodically by a timer, but if the message thread is
+		blocked (eg. during an offline render) you can call it manually. Only call this on the message thread.
+	*/
+	void drain();
+
+private:
+
+	struct Measurement
+	{
+		const Processor* processor;
+		float microseconds;
+		uint32 blockIndex;
+		uint16 numCalls;
+		uint8 category;
+	};
+
+	struct ThreadBuffer
+	{
+		ThreadBuffer();
+
+		void push(const Measurement& m) noexcept;
+
+		std::atomic<Thread::ThreadID> threadId;
+
+		// set by the owner thread while it writes, so the buffer isn't released in the middle of a push
+		std::atomic<bool> writing;
+		std::atomic<uint32> numWrites;
+
+		AbstractFifo fifo;
+		HeapBlock<Measurement> data;
+
+		// only used by drain() to detect idle buffers
+		uint32 lastNumWrites = 0;
+		int numIdleDrains = 0;
+	};
+
+	struct Entry
+	{
+		void addBlock(double microseconds, double budget);
+
+		WeakReference<Processor> processor;
+		String id;
+		Category category;
+
+		uint32 currentBlock = 0;
+		double currentBlockTime = 0.0;
+		bool hasPendingBlock = false;
+
+		int64 numCalls = 0;
+		int numBlocks = 0;
+		double sum = 0.0;
+		double max = 0.0;
+		double budgetSum = 0.0;
+		double peakBudget = 0.0;
+
+		int histogram[NumBins] = {};
+	};
+
+	using Key = std::pair<const Processor*, int>;
+
+	uint32 getCurrentBlockIndex() const noexcept { return blockIndex.load(std::memory_order_relaxed); }
+
+	void addToAccumulator(Accumulator& a, int64 ticks) noexcept;
+
+	void addMeasurement(const Processor* p, Category c, int64 ticks, int numCalls, uint32 blockIndex) noexcept;
+
+	/** Returns the buffer of the current thread with its writing flag set. Clear the flag after the push. */
+	ThreadBuffer* acquireBufferForCurrentThread() noexcept;
+
+	/** Releases the buffer if it wasn't written to since the given number of writes. */
+	void releaseIfIdle(ThreadBuffer& b, uint32 numWritesBeforeRead);
+
+	void timerCallback() override { drain(); }
+
+	static constexpr int BufferSize = 8192;
+
+	MainController* mc;
+
+	const uint32 instanceId;
+	const double ticksToMicroseconds;
+
+	std::atomic<bool> enabled;
+	std::atomic<uint32> blockIndex;
+	std::atomic<int> numSamplesPerBlock;
+	std::atomic<double> sampleRate;
+	std::atomic<double> blockDuration;
+	std::atomic<int> numDropped;
+
+	ThreadBuffer buffers[NumThreadBuffers];
+
+	CriticalSection entryLock;
+	std::map<Key, Entry> entries;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CpuProfiler);
+};
+
+}
@@ -0,0 +1,219 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#if HI_RUN_UNIT_TESTS && HISE_ENABLE_CPU_PROFILER
+
+namespace hise { using namespace juce;
+
+/** Checks the histogram bins of the CPU profiler and measures the overhead of a single measurement. */
+class CpuProfilerTest : public UnitTest
+{
+public:
+
+	static constexpr int NumMeasurements = 4096;
+
+	CpuProfilerTest() :
+		UnitTest("CPU Profiler", "Benchmark")
+	{}
+
+	void runTest() override
+	{
+		testBins();
+		testOverhead();
+		testAccumulator();
+		testThreadBufferRelease();
+	}
+
+private:
+
+	void testBins()
+	{
+		beginTest("Testing histogram bins");
+
+		expectEquals(CpuProfiler::getBinForTime(0.0), 0, "zero isn't in the first bin");
+		expectEquals(CpuProfiler::getBinForTime(1e9), CpuProfiler::NumBins - 1, "huge values aren't clamped");
+
+		for (double t = 0.15; t < 100000.0; t *= 1.7)
+		{
+			auto bin = CpuProfiler::getBinForTime(t);
+
+			expect(CpuProfiler::getTimeForBin(bin) >= t, "upper edge too small for " + String(t));
+			expect(bin == 0 || CpuProfiler::getTimeForBin(bin - 1) <= t, "lower edge too big for " + String(t));
+		}
+	}
+
+	void testOverhead()
+	{
+		beginTest("Measuring the overhead of a single measurement");
+
+		CpuProfiler profiler(nullptr);
+		profiler.beginBlock(512, 44100.0);
+
+		auto start = Time::getHighResolutionTicks();
+
+		for (int i = 0; i < NumMeasurements; i++)
+		{
+			CpuProfiler::ScopedMeasurement sm(profiler, nullptr, CpuProfiler::Category::Effect);
+		}
+
+		auto seconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+
+		logMessage("Overhead per measurement: " + String(seconds * 1e9 / (double)NumMeasurements, 1) + "ns");
+
+		expectEquals(profiler.getNumDroppedMeasurements(), 0, "measurements were dropped");
+
+		// Without a drain the ring buffer must overflow eventually
+		for (int i = 0; i < 2 * NumMeasurements; i++)
+		{
+			CpuProfiler::ScopedMeasurement sm(profiler, nullptr, CpuProfiler::Category::Effect);
+		}
+
+		expect(profiler.getNumDroppedMeasurements() > 0, "full buffer didn't drop measurements");
+	}
+
+	void testAccumulator()
+	{
+		beginTest("Testing accumulated measurements");
+
+		CpuProfiler profiler(nullptr);
+		CpuProfiler::Accumulator a(CpuProfiler::Category::ModulatorChain);
+
+		// Only one record per block, so this must never overflow the buffer
+		for (int block = 0; block < NumMeasurements; block++)
+		{
+			profiler.beginBlock(512, 44100.0);
+
+			for (int voice = 0; voice < 16; voice++)
+			{
+				CpuProfiler::ScopedAccumulation sa(profiler, a);
+			}
+
+			expectEquals(a.numCalls, 16, "wrong number of accumulated calls");
+		}
+
+		expectEquals(profiler.getNumDroppedMeasurements(), 0, "accumulated measurements were dropped");
+	}
+
+	/** Adds a single measurement and stays alive until it's deleted, so that it keeps its buffer. */
+	struct MeasurementThread : public Thread
+	{
+		MeasurementThread(CpuProfiler& p) :
+			Thread("Measurement thread"),
+			profiler(p)
+		{
+			startThread();
+			measured.wait(1000);
+		}
+
+		~MeasurementThread()
+		{
+			stopThread(1000);
+		}
+
+		void run() override
+		{
+			{
+				CpuProfiler::ScopedMeasurement sm(profiler, nullptr, CpuProfiler::Category::Effect);
+			}
+
+			measured.signal();
+
+			while (!threadShouldExit())
+				wait(-1);
+		}
+
+		CpuProfiler& profiler;
+		WaitableEvent measured;
+	};
+
+	void testThreadBufferRelease()
+	{
+		beginTest("Testing release of idle thread buffers");
+
+		CpuProfiler profiler(nullptr);
+		profiler.beginBlock(512, 44100.0);
+
+		// The threads run at the same time (otherwise a new thread might reuse the ID of a finished one)
+		auto measureOnNewThreads = [&profiler](int numThreads)
+		{
+			OwnedArray<MeasurementThread> threads;
+
+			for (int i = 0; i < numThreads; i++)
+				threads.add(new MeasurementThread(profiler));
+		};
+
+		// drain() must only be called on the message thread
+		auto drain = [&profiler]()
+		{
+			MessageManagerLock mm;
+			profiler.drain();
+		};
+
+		// The first drain picks up the measurements, then the buffers are idle
+		auto releaseIdleBuffers = [&]()
+		{
+			for (int i = 0; i < CpuProfiler::NumIdleDrainsBeforeRelease + 1; i++)
+				drain();
+		};
+
+		measureOnNewThreads(CpuProfiler::NumThreadBuffers + 1);
+
+		expectEquals(profiler.getNumDroppedMeasurements(), 1, "measurement of a thread without a buffer wasn't dropped");
+
+		releaseIdleBuffers();
+		measureOnNewThreads(CpuProfiler::NumThreadBuffers);
+
+		expectEquals(profiler.getNumDroppedMeasurements(), 1, "idle buffers weren't released");
+
+		releaseIdleBuffers();
+
+		// A thread that keeps measuring must keep its buffer
+		for (int i = 0; i < 2 * CpuProfiler::NumIdleDrainsBeforeRelease; i++)
+		{
+			CpuProfiler::ScopedMeasurement sm(profiler, nullptr, CpuProfiler::Category::Effect);
+			drain();
+		}
+
+		expectEquals(profiler.getNumDroppedMeasurements(), 1, "active thread lost its buffer");
+
+		// This thread still owns a buffer, so there's one less for other threads
+		measureOnNewThreads(CpuProfiler::NumThreadBuffers);
+
+		expectEquals(profiler.getNumDroppedMeasurements(), 2, "buffer of the active thread was released");
+	}
+};
+
+static CpuProfilerTest cpuProfilerTest;
+
+}
+
+#endif
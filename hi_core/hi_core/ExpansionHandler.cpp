@@ -209,7 +209,7 @@ bool ExpansionHandler::createAvailableExpansions()
 {
 	Array<File> folders;
 	getExpansionFolder().findChildFiles(folders, File::findDirectories, false);
-    OwnedArray<Expansion> newList;
+	Array<Expansion*> newExpansions;
 	bool didSomething = false;
 
 	for (auto f : folders)
@@ -231,13 +231,25 @@ bool ExpansionHandler::createAvailableExpansions()
 
 		if (Helpers::isValidExpansion(f))
 		{
-			auto e = createExpansionForFile(f);
+			if (auto e = createUninitialisedExpansion(f))
+				newExpansions.add(e);
+		}
+	}
 
-			if (e != nullptr && !uninitialisedExpansions.contains(e))
-			{
-				expansionList.add(e);
-				didSomething = true;
-			}
+	// The expansions are independent from each other so we can
+	// validate, decrypt and index them concurrently...
+	auto results = initialiseExpansions(newExpansions);
+
+	for (int i = 0; i < newExpansions.size(); i++)
+	{
+		auto e = newExpansions[i];
+
+		handleInitialisationResult(e, results.getReference(i));
+
+		if (!uninitialisedExpansions.contains(e))
+		{
+			expansionList.add(e);
+			didSomething = true;
 		}
 	}
     
@@ -257,16 +269,23 @@ bool ExpansionHandler::forceReinitialisation()
 {
 	bool didSomething = false;
 
-	for (int i = 0; i < expansionList.size(); i++)
+	Array<Expansion*> list;
+
+	for (auto e : expansionList)
+		list.add(e);
+
+	auto results = initialiseExpansions(list);
+
+	for (int i = 0; i < list.size(); i++)
 	{
-		auto e = expansionList[i];
-		auto r = e->initialise();
+		auto e = list[i];
+		auto r = results.getReference(i);
 
 		checkAllowedExpansions(r, e);
 
 		if (!r.wasOk())
 		{
-			e = expansionList.removeAndReturn(i--);
+			expansionList.removeObject(e, false);
 			initialisationErrors.addIfNotAlreadyThere({ e, r });
 			uninitialisedExpansions.add(e);
 			didSomething = true;
@@ -283,7 +302,7 @@ bool ExpansionHandler::forceReinitialisation()
 	return ok;
 }
 
-hise::Expansion* ExpansionHandler::createExpansionForFile(const File& f)
+hise::Expansion* ExpansionHandler::createUninitialisedExpansion(const File& f)
 {
 	Expansion* e = nullptr;
 
@@ -299,20 +318,96 @@ hise::Expansion* ExpansionHandler::createExpansionForFile(const File& f)
 		e = expansionCreateFunction(f);
 #endif
 
-	if (e != nullptr)
+	return e;
+}
+
+Array<Result> ExpansionHandler::initialiseExpansions(const Array<Expansion*>& expansionsToInitialise)
+{
+	const int numExpansions = expansionsToInitialise.size();
+
+	Array<Result> results;
+	Array<double> timings;
+
+	results.insertMultiple(0, Result::ok(), numExpansions);
+	timings.insertMultiple(0, 0.0, numExpansions);
+
+	auto initialiseExpansion = [&](int index)
 	{
-		auto r = e->initialise();
+		auto start = Time::getMillisecondCounterHiRes();
+		results.getReference(index) = expansionsToInitialise[index]->initialise();
+		timings.set(index, Time::getMillisecondCounterHiRes() - start);
+	};
 
-		checkAllowedExpansions(r, e);
+	auto totalStart = Time::getMillisecondCounterHiRes();
+
+	const int numThreads = jmin(numExpansions, SystemStats::getNumCpus());
+
+	if (numThreads <= 1)
+	{
+		for (int i = 0; i < numExpansions; i++)
+			initialiseExpansion(i);
+	}
+	else
+	{
+		ThreadPool pool(numThreads);
+		WaitableEvent allDone;
+		std::atomic<int> numPending = { numExpansions };
 
-		if (r.failed())
+		for (int i = 0; i < numExpansions; i++)
 		{
-			initialisationErrors.addIfNotAlreadyThere({ e, r });
+			pool.addJob([&, i]()
+			{
+				initialiseExpansion(i);
 
-			uninitialisedExpansions.add(e);
-			setErrorMessage(r.getErrorMessage(), false);
+				if (--numPending == 0)
+					allDone.signal();
+			});
+		}
+
+		allDone.wait();
+	}
+
+	if (numExpansions > 0)
+	{
+		auto& logger = getMainController()->getDebugLogger();
+
+		for (int i = 0; i < numExpansions; i++)
+		{
+			String m;
+			m << "Expansion " << expansionsToInitialise[i]->getRootFolder().getFileName() << " initialised in " << String(timings[i], 1) << "ms";
+			logger.logMessage(m);
 		}
+
+		String m;
+		m << String(numExpansions) << " expansions initialised in " << String(Time::getMillisecondCounterHiRes() - totalStart, 1) << "ms using " << String(jmax(1, numThreads)) << " threads";
+		logger.logMessage(m);
 	}
+
+	return results;
+}
+
+bool ExpansionHandler::handleInitialisationResult(Expansion* e, Result r)
+{
+	checkAllowedExpansions(r, e);
+
+	if (r.failed())
+	{
+		initialisationErrors.addIfNotAlreadyThere({ e, r });
+
+		uninitialisedExpansions.add(e);
+		setErrorMessage(r.getErrorMessage(), false);
+		return false;
+	}
+
+	return true;
+}
+
+hise::Expansion* ExpansionHandler::createExpansionForFile(const File& f)
+{
+	auto e = createUninitialisedExpansion(f);
+
+	if (e != nullptr)
+		handleInitialisationResult(e, e->initialise());
 		
 	return e;
 }
@@ -613,11 +708,17 @@ bool ExpansionHandler::rebuildUnitialisedExpansions()
 {
 	bool didSomething = false;
 
-	for (int i = 0; i < uninitialisedExpansions.size(); i++)
-	{
-		auto e = uninitialisedExpansions[i];
+	Array<Expansion*> list;
 
-		auto r = e->initialise();
+	for (auto e : uninitialisedExpansions)
+		list.add(e);
+
+	auto results = initialiseExpansions(list);
+
+	for (int i = 0; i < list.size(); i++)
+	{
+		auto e = list[i];
+		auto r = results.getReference(i);
 
 		checkAllowedExpansions(r, e);
 
@@ -625,7 +726,7 @@ bool ExpansionHandler::rebuildUnitialisedExpansions()
 		{
 			initialisationErrors.removeAllInstancesOf({ e, r });
 
-			e = uninitialisedExpansions.removeAndReturn(i--);
+			uninitialisedExpansions.removeObject(e, false);
 			expansionList.add(e);
 			didSomething = true;
 		}
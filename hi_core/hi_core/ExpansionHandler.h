@@ -423,6 +423,15 @@ private:
 
 	bool rebuildUnitialisedExpansions();
 
+	Expansion* createUninitialisedExpansion(const File& f);
+
+	/** Initialises the given expansions concurrently and returns the results in the same order.
+		The scan / decryption time of each expansion is written to the debug log. */
+	Array<Result> initialiseExpansions(const Array<Expansion*>& expansionsToInitialise);
+
+	/** Checks the result of Expansion::initialise() and adds the expansion to the list of uninitialised expansions if it failed. */
+	bool handleInitialisationResult(Expansion* e, Result r);
+
 	bool enabled = true;
 
 	String keyCode;
@@ -363,6 +363,16 @@ Identifier PoolHelpers::getPrettyName(const MidiFileReference*)
 Identifier PoolHelpers::getPrettyName(const AdditionalDataReference*)
 { RETURN_STATIC_IDENTIFIER("AdditionalDataPool"); }
 
+String PoolHelpers::getSharedCacheStatistics(const Image*)
+{
+#if HISE_USE_LAZY_IMAGE_POOL
+	SharedResourcePointer<LazyImageCache> cache;
+	return cache->getStatistics().toString();
+#else
+	return {};
+#endif
+}
+
 int PoolHelpers::Reference::Comparator::compareElements(const Reference& first, const Reference& second)
 {
 	return first.reference.compare(second.reference);
@@ -800,6 +810,8 @@ void PoolHelpers::Reference::parseReferenceString(const MainController* mc, cons
 
 bool PoolBase::DataProvider::isEmbeddedResource(PoolReference r)
 {
+	ensureRestored();
+
 	return r.isEmbeddedReference() || hashCodes.contains(r.getHashCode());
 }
 
@@ -810,6 +822,11 @@ hise::PoolReference PoolBase::DataProvider::getEmbeddedReference(PoolReference o
 
 juce::Result PoolBase::DataProvider::restorePool(InputStream* ownedInputStream)
 {
+	{
+		ScopedLock sl(lazyRestoreLock);
+		lazyRestoreFunction = {};
+	}
+
 	pool->clearData();
 
 	input = ownedInputStream;
@@ -844,8 +861,31 @@ juce::Result PoolBase::DataProvider::restorePool(InputStream* ownedInputStream)
 	return Result::ok();
 }
 
+void PoolBase::DataProvider::setLazyRestoreFunction(const std::function<Result(DataProvider&)>& f)
+{
+	ScopedLock sl(lazyRestoreLock);
+	lazyRestoreFunction = f;
+}
+
+void PoolBase::DataProvider::ensureRestored()
+{
+	ScopedLock sl(lazyRestoreLock);
+
+	if (lazyRestoreFunction)
+	{
+		auto f = lazyRestoreFunction;
+		lazyRestoreFunction = {};
+
+		auto r = f(*this);
+		jassert(r.wasOk());
+		ignoreUnused(r);
+	}
+}
+
 juce::MemoryInputStream* PoolBase::DataProvider::createInputStream(const String& referenceString)
 {
+	ensureRestored();
+
 	if (metadata.isValid())
 	{
 		auto item = metadata.getChildWithProperty("ID", referenceString);
@@ -962,6 +1002,8 @@ juce::Result PoolBase::DataProvider::writePool(OutputStream* ownedOutputStream,
 
 var PoolBase::DataProvider::createAdditionalData(PoolReference r)
 {
+	ensureRestored();
+
 	auto item = metadata.getChildWithProperty("ID", r.getReferenceString());
 
 	if (item.isValid())
@@ -982,6 +1024,8 @@ var PoolBase::DataProvider::createAdditionalData(PoolReference r)
 
 Array<hise::PoolReference> PoolBase::DataProvider::getListOfAllEmbeddedReferences() const
 {
+	const_cast<DataProvider*>(this)->ensureRestored();
+
 	Array<PoolReference> references;
 
 	for (const auto& c : metadata)
@@ -1026,7 +1070,10 @@ void PoolBase::DataProvider::setCompressor(Compressor* newCompressor)
 { compressor = newCompressor; }
 
 size_t PoolBase::DataProvider::getSizeOfEmbeddedReferences() const
-{ return embeddedSize; }
+{
+	const_cast<DataProvider*>(this)->ensureRestored();
+	return embeddedSize;
+}
 
 PoolBase::Listener::~Listener()
 {}
@@ -1227,10 +1274,30 @@ void PoolBase::DataProvider::Compressor::create(MemoryInputStream* mis, Image* d
 {
 	ScopedPointer<MemoryInputStream> scopedInput = mis;
 
+#if HISE_USE_LAZY_IMAGE_POOL
+	MemoryBlock mb;
+	mis->readIntoMemoryBlock(mb);
+
+	MemoryInputStream encoded(mb, false);
+
+	if (auto ff = ImageFileFormat::findImageFormatForStream(encoded))
+	{
+		// only PNG files can be decoded lazily, everything else is decoded right away
+		if (dynamic_cast<PNGImageFormat*>(ff) != nullptr)
+			*data = LazyImageCache::createLazyImage(MemoryBlock(mb));
+
+		if (data->isNull())
+		{
+			MemoryInputStream fallback(mb, false);
+			*data = ff->decodeImage(fallback);
+		}
+	}
+#else
 	if (auto ff = ImageFileFormat::findImageFormatForStream(*mis))
 	{
 		*data = ff->decodeImage(*mis);
 	}
+#endif
 }
 
 void PoolBase::DataProvider::Compressor::create(MemoryInputStream* mis, AudioSampleBuffer* data) const
@@ -188,6 +188,12 @@ struct PoolHelpers
     static Identifier getPrettyName(const ValueTree* /*img*/);
     static Identifier getPrettyName(const MidiFileReference* /*img*/);
     static Identifier getPrettyName(const AdditionalDataReference* /*img*/);
+
+    /** Returns the statistics of a cache that is shared by all pools of this data type
+        (the lazy image cache), or an empty string if there is no such cache. */
+    template <typename T> static String getSharedCacheStatistics(const T* /*data*/) { return {}; }
+    /** @internal (used by the template instantiations. */
+    static String getSharedCacheStatistics(const Image* /*img*/);
     
     static Image getEmptyImage(int width, int height);
     
@@ -361,6 +367,12 @@ public:
         
         virtual Result restorePool(InputStream* ownedInputStream);
         
+        /** Defers the restoring of the pool until the embedded data is accessed for the first time. */
+        void setLazyRestoreFunction(const std::function<Result(DataProvider&)>& f);
+        
+        /** Restores the pool if it was deferred with setLazyRestoreFunction(). */
+        void ensureRestored();
+        
         virtual MemoryInputStream* createInputStream(const String& referenceString);
         
         virtual Result writePool(OutputStream* ownedOutputStream, double* progress=nullptr);
@@ -386,6 +398,9 @@ public:
         size_t embeddedSize = 0;
         
         ScopedPointer<Compressor> compressor;
+        
+        CriticalSection lazyRestoreLock;
+        std::function<Result(DataProvider&)> lazyRestoreFunction;
     };
     
     /** A interface class that will be notified about changes to the pool.
@@ -61,6 +61,8 @@ public:
 		testMidiBufferCopyMethods();
 		testMidiBufferIterators();
 		testEventBufferMoveOperations();
+		testEventBufferMerge();
+		testEventBufferOverflow();
 		testEventHandler();
 		testEventBufferStack();
 		testStartOffset();
@@ -669,6 +671,118 @@ private:
 
 
 
+	}
+
+	void testEventBufferMerge()
+	{
+		beginTest("Testing HiseEventBuffer merge");
+
+		for (int iteration = 0; iteration < 16; iteration++)
+		{
+			HiseEventBuffer merged;
+			HiseEventBuffer reference;
+			HiseEventBuffer other;
+
+			const int numExisting = r.nextInt(HISE_EVENT_BUFFER_SIZE / 2);
+			const int numToAdd = r.nextInt(HISE_EVENT_BUFFER_SIZE / 2);
+
+			for (int i = 0; i < numExisting; i++)
+			{
+				auto e = generateRandomHiseEvent();
+				e.setTimeStamp(r.nextInt(64));
+				merged.addEvent(e);
+				reference.addEvent(e);
+			}
+
+			for (int i = 0; i < numToAdd; i++)
+			{
+				auto e = generateRandomHiseEvent();
+				e.setTimeStamp(r.nextInt(64));
+				other.addEvent(e);
+			}
+
+			merged.addEvents(other);
+
+			for (const auto& e : other)
+				reference.addEvent(e);
+
+			expect(merged.timeStampsAreSorted(), "Merged buffer isn't sorted");
+			expect(merged == reference, "Merge doesn't match addEvent() for equal timestamps");
+		}
+	}
+
+	void testEventBufferOverflow()
+	{
+		beginTest("Testing HiseEventBuffer overflow");
+
+		HiseEventBuffer b;
+
+		// Fill the buffer with pitch bend values of a single channel
+		for (int i = 0; i < HISE_EVENT_BUFFER_SIZE; i++)
+		{
+			HiseEvent e(HiseEvent::Type::PitchBend, 0, 0, 1);
+			e.setPitchWheelValue(i);
+			e.setTimeStamp(i);
+			b.addEvent(e);
+		}
+
+		expectEquals<int>(b.getNumUsed(), HISE_EVENT_BUFFER_SIZE, "Buffer isn't full");
+
+		HiseEvent lastPitch(HiseEvent::Type::PitchBend, 0, 0, 1);
+		lastPitch.setPitchWheelValue(9000);
+		lastPitch.setTimeStamp(HISE_EVENT_BUFFER_SIZE);
+		b.addEvent(lastPitch);
+
+		expectEquals<int>(b.getNumUsed(), HISE_EVENT_BUFFER_SIZE, "Controller value wasn't merged");
+		expect(b.getEvent(HISE_EVENT_BUFFER_SIZE - 1) == lastPitch, "Last controller value isn't preserved");
+
+		HiseEvent noteOn(HiseEvent::Type::NoteOn, 64, 127, 1);
+		noteOn.setTimeStamp(10);
+		b.addEvent(noteOn);
+
+		bool found = false;
+
+		for (const auto& e : b)
+			found |= e == noteOn;
+
+		expect(found, "Note on was dropped");
+		expect(b.timeStampsAreSorted(), "Buffer isn't sorted");
+
+		auto stats = b.getOverflowStatistics();
+
+		expectEquals<int>((int)stats.numCoalesced, 2, "Wrong number of merged events");
+		expectEquals<int>((int)stats.numDropped, 0, "Events were dropped");
+
+		b.resetOverflowStatistics();
+		expectEquals<int>((int)b.getOverflowStatistics().numCoalesced, 0, "Statistics weren't reset");
+
+		beginTest("Testing controller streams");
+
+		HiseEvent cc1(HiseEvent::Type::Controller, 74, 10, 2);
+		HiseEvent cc2(HiseEvent::Type::Controller, 74, 20, 2);
+		HiseEvent cc3(HiseEvent::Type::Controller, 1, 20, 2);
+		HiseEvent cc4(HiseEvent::Type::Controller, 74, 20, 3);
+
+		expect(HiseEventBuffer::isSameControllerStream(cc1, cc2), "Same CC");
+		expect(!HiseEventBuffer::isSameControllerStream(cc1, cc3), "Different CC number");
+		expect(!HiseEventBuffer::isSameControllerStream(cc1, cc4), "Different channel");
+
+		auto pressure1 = HiseEvent(MidiMessage::channelPressureChange(2, 40));
+		auto pressure2 = HiseEvent(MidiMessage::channelPressureChange(2, 90));
+		auto polyPressure = HiseEvent(MidiMessage::aftertouchChange(2, 60, 90));
+		auto polyPressureSameValue = HiseEvent(MidiMessage::aftertouchChange(2, 40, 40));
+		auto otherPolyPressure = HiseEvent(MidiMessage::aftertouchChange(2, 40, 90));
+
+		expect(pressure1.isMonophonicAftertouch(), "Channel pressure isn't marked");
+		expect(!polyPressureSameValue.isMonophonicAftertouch(), "Poly pressure is marked as channel pressure");
+		expect(pressure1.toMidiMesage().isChannelPressure(), "Channel pressure isn't restored");
+		expect(polyPressureSameValue.toMidiMesage().isAftertouch(), "Poly pressure isn't restored");
+
+		expect(HiseEventBuffer::isSameControllerStream(pressure1, pressure2), "Same channel pressure");
+		expect(!HiseEventBuffer::isSameControllerStream(pressure1, polyPressure), "Channel vs. poly pressure");
+		expect(!HiseEventBuffer::isSameControllerStream(pressure1, polyPressureSameValue), "Channel vs. poly pressure with note == value");
+		expect(HiseEventBuffer::isSameControllerStream(polyPressureSameValue, otherPolyPressure), "Same poly pressure note");
+		expect(!HiseEventBuffer::isContinuousController(noteOn), "Note on isn't a controller");
 	}
 
 	MidiMessage generateRandomMidiMessage()
@@ -798,6 +912,180 @@ private:
 
 static HiseEventUnitTest eventBufferTestInstance;
 
+/** Adds dense MPE streams (pressure, slide and pitch bend on 16 channels plus a few notes) to a
+	HiseEventBuffer and measures the time per block for 1k - 10k events per block.
+
+	Only HISE_EVENT_BUFFER_SIZE events per block survive: everything above that is merged into
+	the last value of its stream, so this checks the notes and the final controller values, not
+	the intermediate ones. */
+class HiseEventBufferBenchmark : public UnitTest
+{
+public:
+
+	static constexpr int BlockSize = 512;
+	static constexpr int NumBlocks = 64;
+	static constexpr int NumSources = 4;
+	static constexpr int NumNotesPerBlock = 32;
+
+	HiseEventBufferBenchmark() :
+		UnitTest("HiseEventBuffer benchmark", "Benchmark")
+	{}
+
+	void runTest() override
+	{
+		for (int numEvents : { 1000, 2500, 5000, 10000 })
+		{
+			runBenchmark(numEvents, true);
+			runBenchmark(numEvents, false);
+		}
+	}
+
+private:
+
+	static int getStreamIndex(const HiseEvent& e)
+	{
+		auto c = e.getChannel() - 1;
+
+		if (e.isPitchWheel())
+			return c * 3;
+		if (e.isAftertouch())
+			return c * 3 + 1;
+		if (e.isController())
+			return c * 3 + 2;
+
+		return -1;
+	}
+
+	void createSources()
+	{
+		for (auto& s : sources)
+			s.clearQuick();
+
+		// Every source (eg. a MIDI input) delivers its events sorted by timestamp
+		for (int i = 0; i < numEventsPerBlock; i++)
+		{
+			auto& s = sources[i % NumSources];
+			auto channel = 1 + r.nextInt(16);
+
+			HiseEvent e;
+
+			if (i < NumNotesPerBlock)
+				e = HiseEvent(HiseEvent::Type::NoteOn, (uint8)(48 + i), 100, (uint8)channel);
+			else
+			{
+				switch (r.nextInt(3))
+				{
+				case 0: e = HiseEvent(HiseEvent::Type::PitchBend, 0, 0, (uint8)channel); e.setPitchWheelValue(r.nextInt(16384)); break;
+				case 1: e = HiseEvent(MidiMessage::channelPressureChange(channel, r.nextInt(128))); break;
+				default: e = HiseEvent(HiseEvent::Type::Controller, 74, (uint8)r.nextInt(128), (uint8)channel); break;
+				}
+			}
+
+			e.setTimeStamp(r.nextInt(BlockSize));
+			s.add(e);
+		}
+
+		for (auto& s : sources)
+			std::stable_sort(s.begin(), s.end());
+	}
+
+	void runBenchmark(int numEvents, bool useMerge)
+	{
+		numEventsPerBlock = numEvents;
+
+		beginTest("Adding " + String(numEvents) + " events per block " + (useMerge ? "(merge)" : "(addEvent)"));
+
+		HiseEventBuffer b;
+		double seconds = 0.0;
+
+		for (int block = 0; block < NumBlocks; block++)
+		{
+			createSources();
+			b.clear();
+			b.resetOverflowStatistics();
+
+			auto start = Time::getHighResolutionTicks();
+
+			if (useMerge)
+			{
+				for (auto& s : sources)
+					b.addEvents(s.begin(), s.size());
+			}
+			else
+			{
+				// interleave the sources like the old per-event path
+				for (int i = 0; i < numEvents; i++)
+					b.addEvent(sources[i % NumSources][i / NumSources]);
+			}
+
+			seconds += Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+
+			expect(b.timeStampsAreSorted(), "Buffer isn't sorted");
+			expectEquals<int>((int)b.getOverflowStatistics().numDropped, 0, "Events were dropped");
+
+			if (block == 0)
+				checkLastValues(b, useMerge);
+		}
+
+		auto stats = b.getOverflowStatistics();
+
+		logMessage("Time per block: " + String(seconds * 1000000.0 / (double)NumBlocks, 1) + "us, kept events: " + String(b.getNumUsed()) + ", merged events: " + String(stats.numCoalesced));
+	}
+
+	void checkLastValues(const HiseEventBuffer& b, bool useMerge)
+	{
+		HiseEvent expected[48];
+		int numNotes = 0;
+
+		auto update = [&](const HiseEvent& e)
+		{
+			auto index = getStreamIndex(e);
+
+			if (index == -1)
+				return;
+
+			if (expected[index].isEmpty() || expected[index].getTimeStamp() <= e.getTimeStamp())
+				expected[index] = e;
+		};
+
+		if (useMerge)
+		{
+			for (auto& s : sources)
+				for (const auto& e : s)
+					update(e);
+		}
+		else
+		{
+			for (int i = 0; i < numEventsPerBlock; i++)
+				update(sources[i % NumSources][i / NumSources]);
+		}
+
+		HiseEvent actual[48];
+
+		for (const auto& e : b)
+		{
+			if (e.isNoteOn())
+				numNotes++;
+
+			auto index = getStreamIndex(e);
+
+			if (index != -1)
+				actual[index] = e;
+		}
+
+		expectEquals(numNotes, NumNotesPerBlock, "Notes were dropped");
+
+		for (int i = 0; i < 48; i++)
+			expect(actual[i] == expected[i], "Last value of stream " + String(i) + " isn't preserved");
+	}
+
+	Random r;
+	int numEventsPerBlock = 0;
+	Array<HiseEvent> sources[NumSources];
+};
+
+static HiseEventBufferBenchmark eventBufferBenchmark;
+
 namespace IDs
 {
 #define DECLARE_ID(name) const juce::Identifier name (#name);
@@ -0,0 +1,398 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+HostAutomationLane::Target::Target(HostAutomationLane& l) :
+	lane(&l)
+{
+	l.addTarget(*this);
+}
+
+HostAutomationLane::Target::~Target()
+{
+	if (auto l = lane.get())
+		l->removeTarget(*this);
+}
+
+void HostAutomationLane::Target::setHostAutomationValue(float value)
+{
+	if (auto l = lane.get())
+	{
+		if (l->push(*this, value))
+			return;
+	}
+
+	applyHostAutomation(value);
+}
+
+HostAutomationLane::HostAutomationLane() :
+	enabled(HISE_SAMPLE_ACCURATE_AUTOMATION),
+	lastBlockStart(0),
+	blockDuration(0.0),
+	sampleRate(0.0),
+	audioThreadId(nullptr),
+	queue(QueueSize),
+	draining(false)
+{
+	for (int i = 0; i < MaxNumTargets; i++)
+	{
+		targets[i] = nullptr;
+		generations[i] = 0;
+	}
+}
+
+HostAutomationLane::~HostAutomationLane()
+{
+	jassert(!insideBlock);
+}
+
+bool HostAutomationLane::push(Target& t, float value)
+{
+	auto offset = Thread::getCurrentThreadId() == audioThreadId.load() ? 0 : getOffsetForCurrentTime();
+	return pushAtOffset(t, value, offset);
+}
+
+bool HostAutomationLane::pushAtOffset(Target& t, float value, int offset)
+{
+	if (!isEnabled() || t.slotIndex == -1)
+		return false;
+
+	if (!isRunning())
+	{
+		// Apply the queued values first so that the order is preserved
+		applyQueuedValues();
+		return false;
+	}
+
+	QueuedValue qv;
+	qv.slotIndex = t.slotIndex;
+	qv.generation = t.generation;
+	qv.value = value;
+	qv.offset = offset;
+
+	return queue.push(std::move(qv));
+}
+
+void HostAutomationLane::processBlock(HiseEventBuffer* eventBuffer, int numSamples, double newSampleRate)
+{
+	if (insideBlock)
+		finishBlock();
+
+	lastBlockStart.store(Time::getHighResolutionTicks());
+	blockDuration.store(newSampleRate > 0.0 ? (double)numSamples / newSampleRate : 0.0);
+	sampleRate.store(newSampleRate);
+	audioThreadId.store(Thread::getCurrentThreadId());
+
+	insideBlock = true;
+	numPending = 0;
+
+	// Another thread is applying the queued values, the rest stays in the queue until the next block
+	if (draining.exchange(true))
+		return;
+
+	QueuedValue qv;
+
+	while (queue.pop(qv))
+	{
+		ScopedTarget t(*this, qv.slotIndex, qv.generation);
+
+		if (!t)
+			continue;
+
+		if (t->shouldThrottleHostAutomation())
+		{
+			addThrottledValue(*t, qv.value);
+			continue;
+		}
+
+		auto owner = eventBuffer != nullptr ? t->getHostAutomationOwner() : nullptr;
+
+		if (owner == nullptr)
+		{
+			t->applyHostAutomation(qv.value);
+			continue;
+		}
+
+		auto offset = jlimit(0, jmax(0, numSamples - 1), qv.offset);
+		offset -= offset % HISE_EVENT_RASTER;
+
+		PendingValue* existing = nullptr;
+
+		for (int i = 0; i < numPending; i++)
+		{
+			if (pending[i].slotIndex == qv.slotIndex && pending[i].generation == qv.generation && pending[i].offset == offset)
+			{
+				existing = pending + i;
+				break;
+			}
+		}
+
+		if (existing != nullptr)
+		{
+			existing->value = qv.value;
+			continue;
+		}
+
+		if (numPending == MaxNumEventsPerBlock || eventBuffer->getNumUsed() >= HISE_EVENT_BUFFER_SIZE)
+		{
+			t->applyHostAutomation(qv.value);
+			continue;
+		}
+
+		pending[numPending] = { qv.slotIndex, qv.generation, owner, qv.value, offset, false };
+		eventBuffer->addEvent(HiseEvent::createParameterChange((uint16)numPending, offset));
+		numPending++;
+	}
+
+	applyThrottledValues(false);
+	draining.store(false);
+}
+
+bool HostAutomationLane::applyEvent(const HiseEvent& e, const Processor* renderingSynth)
+{
+	jassert(e.isParameterChange());
+
+	auto index = e.getParameterChangeIndex();
+
+	if (!insideBlock || !isPositiveAndBelow(index, numPending))
+		return false;
+
+	auto& p = pending[index];
+
+	if (p.applied || p.owner != renderingSynth)
+		return false;
+
+	p.applied = true;
+
+	ScopedTarget t(*this, p.slotIndex, p.generation);
+
+	if (t)
+		t->applyHostAutomation(p.value);
+
+	return true;
+}
+
+void HostAutomationLane::finishBlock()
+{
+	if (!insideBlock)
+		return;
+
+	// The owner didn't render this block (or it was a child of a synth group)
+	for (int i = 0; i < numPending; i++)
+	{
+		if (pending[i].applied)
+			continue;
+
+		ScopedTarget t(*this, pending[i].slotIndex, pending[i].generation);
+
+		if (t)
+			t->applyHostAutomation(pending[i].value);
+	}
+
+	numPending = 0;
+	insideBlock = false;
+}
+
+const Processor* HostAutomationLane::getOwnerSynth(const Processor* p)
+{
+	if (p == nullptr)
+		return nullptr;
+
+	const Processor* owner = dynamic_cast<const ModulatorSynth*>(p) != nullptr ? p : p->getParentProcessor(true, false);
+
+	if (owner == nullptr)
+		return nullptr;
+
+	// The children of a synth group are rendered by the group
+	if (auto group = dynamic_cast<const ModulatorSynthGroup*>(owner->getParentProcessor(true, false)))
+		owner = group;
+
+	// The root container doesn't split its buffer
+	if (dynamic_cast<const ModulatorSynthChain*>(owner) != nullptr)
+		return nullptr;
+
+	return owner;
+}
+
+bool HostAutomationLane::isRunning() const noexcept
+{
+	auto start = lastBlockStart.load();
+
+	if (start == 0)
+		return false;
+
+	auto elapsed = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+	return elapsed < jmax(0.1, 4.0 * blockDuration.load());
+}
+
+int HostAutomationLane::getOffsetForCurrentTime() const noexcept
+{
+	auto elapsed = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - lastBlockStart.load());
+	return jmax(0, roundToInt(elapsed * sampleRate.load()));
+}
+
+void HostAutomationLane::addTarget(Target& t)
+{
+	SpinLock::ScopedLockType sl(targetLock);
+
+	for (int i = 0; i < MaxNumTargets; i++)
+	{
+		if (targets[i] == nullptr)
+		{
+			targets[i] = &t;
+			t.slotIndex = i;
+			t.generation = ++generations[i];
+			return;
+		}
+	}
+
+	// More parameters than slots, the values of this target will be applied directly
+	jassertfalse;
+}
+
+void HostAutomationLane::removeTarget(Target& t)
+{
+	{
+		SpinLock::ScopedLockType sl(targetLock);
+
+		if (t.slotIndex != -1)
+		{
+			targets[t.slotIndex] = nullptr;
+			t.slotIndex = -1;
+		}
+	}
+
+	// Wait for the values that were resolved before the slot was cleared. The pending and
+	// throttled values of this target are skipped because the slot doesn't resolve anymore.
+	while (t.numApplying.load() > 0)
+		Thread::yield();
+}
+
+HostAutomationLane::Target* HostAutomationLane::getTarget(int slotIndex, uint16 generation) const noexcept
+{
+	if (!isPositiveAndBelow(slotIndex, MaxNumTargets))
+		return nullptr;
+
+	auto t = targets[slotIndex];
+
+	// The slot was reused by another target after the value was queued
+	if (t == nullptr || t->generation != generation)
+		return nullptr;
+
+	return t;
+}
+
+HostAutomationLane::ScopedTarget::ScopedTarget(HostAutomationLane& l, int slotIndex, uint16 generation)
+{
+	SpinLock::ScopedLockType sl(l.targetLock);
+
+	t = l.getTarget(slotIndex, generation);
+
+	if (t != nullptr)
+		t->numApplying.fetch_add(1);
+}
+
+HostAutomationLane::ScopedTarget::~ScopedTarget()
+{
+	if (t != nullptr)
+		t->numApplying.fetch_sub(1);
+}
+
+void HostAutomationLane::addThrottledValue(Target& t, float value)
+{
+	t.throttledValue = value;
+
+	if (t.throttlePending)
+		return;
+
+	if (numThrottled == MaxNumThrottledTargets)
+	{
+		t.applyHostAutomation(value);
+		return;
+	}
+
+	t.throttlePending = true;
+	throttledTargets[numThrottled++] = { t.slotIndex, t.generation };
+}
+
+void HostAutomationLane::applyThrottledValues(bool force)
+{
+	if (numThrottled == 0)
+		return;
+
+	auto now = Time::getMillisecondCounterHiRes();
+
+	for (int i = 0; i < numThrottled;)
+	{
+		ScopedTarget t(*this, throttledTargets[i].slotIndex, throttledTargets[i].generation);
+
+		// The target was removed
+		if (!t)
+		{
+			throttledTargets[i] = throttledTargets[--numThrottled];
+			continue;
+		}
+
+		if (force || now - t->lastThrottledCallback >= ThrottleMilliseconds)
+		{
+			t->lastThrottledCallback = now;
+			t->throttlePending = false;
+			throttledTargets[i] = throttledTargets[--numThrottled];
+			t->applyHostAutomation(t->throttledValue);
+		}
+		else
+			i++;
+	}
+}
+
+void HostAutomationLane::applyQueuedValues()
+{
+	// The audio thread is draining the queue and applies the values
+	if (draining.exchange(true))
+		return;
+
+	QueuedValue qv;
+
+	while (queue.pop(qv))
+	{
+		ScopedTarget t(*this, qv.slotIndex, qv.generation);
+
+		if (t)
+			t->applyHostAutomation(qv.value);
+	}
+
+	applyThrottledValues(true);
+	draining.store(false);
+}
+
+}
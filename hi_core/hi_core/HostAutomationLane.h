@@ -0,0 +1,225 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#pragma once
+
+namespace hise { using namespace juce;
+
+class Processor;
+
+/** A lock-free lane that applies host automation with sub-block accuracy.
+
+	Plugin parameters that derive from HostAutomationLane::Target don't apply the value in setValue() but push it
+	into a lock-free queue. At the start of the next audio callback the values are added as ParameterChange events
+	to the master event buffer, so the sound generator that owns the automated module splits its rendering at the
+	event and applies the value between two sub-blocks, just like it does with note-on messages.
+
+	JUCE doesn't pass the sample offset of an automation value to setValue(), so the offset is derived from the time
+	since the last audio callback: values that are set on the audio thread are applied at the start of the next block,
+	values from any other thread keep their spacing with a constant latency of one block instead of being quantised to
+	the block size.
+
+	Values that would fire a script callback are throttled: only the most recent value is applied and at most once
+	every ThrottleMilliseconds (the last value is always delivered).
+
+	If the audio callback isn't running (eg. while the plugin is suspended or during a preset load), the lane is bypassed
+	and the values are applied directly. You can enable the lane with HISE_SAMPLE_ACCURATE_AUTOMATION.
+*/
+class HostAutomationLane
+{
+public:
+
+	static constexpr int MaxNumTargets = 2048;
+	static constexpr int MaxNumEventsPerBlock = 128;
+	static constexpr int MaxNumThrottledTargets = 256;
+	static constexpr int QueueSize = 2048;
+	static constexpr double ThrottleMilliseconds = 30.0;
+
+	/** A subclass of this is a plugin parameter that can be automated through the lane. */
+	struct Target
+	{
+		Target(HostAutomationLane& lane);
+		virtual ~Target();
+
+		/** Applies the value. This is called on the audio thread if the value went through the lane. */
+		virtual void applyHostAutomation(float value) = 0;
+
+		/** Return the sound generator that applies the value between its sub-blocks (use getOwnerSynth() for this)
+			or nullptr if the value should be applied at the start of the block.
+		*/
+		virtual const Processor* getHostAutomationOwner() const = 0;
+
+		/** Return true if applying the value fires a script callback. */
+		virtual bool shouldThrottleHostAutomation() const { return false; }
+
+		/** Pushes the value into the lane or applies it directly if that's not possible. */
+		void setHostAutomationValue(float value);
+
+	private:
+
+		friend class HostAutomationLane;
+
+		WeakReference<HostAutomationLane> lane;
+		int slotIndex = -1;
+		uint16 generation = 0;
+
+		// The number of threads that resolved this target and are applying a value
+		std::atomic<int> numApplying { 0 };
+
+		float throttledValue = 0.0f;
+		bool throttlePending = false;
+		double lastThrottledCallback = 0.0;
+
+		JUCE_DECLARE_NON_COPYABLE(Target);
+	};
+
+	HostAutomationLane();
+	~HostAutomationLane();
+
+	/** Pushes the value into the lane. This can be called from any thread. Returns false if the value can't go
+		through the lane and must be applied directly.
+	*/
+	bool push(Target& t, float value);
+
+	/** Pushes the value with the given sample offset into the next block. */
+	bool pushAtOffset(Target& t, float value, int offset);
+
+	/** Call this at the beginning of each audio callback after the MIDI input was added to the event buffer.
+		This adds a ParameterChange event for every pending value. If the buffer is nullptr, the values are
+		applied directly.
+	*/
+	void processBlock(HiseEventBuffer* eventBuffer, int numSamples, double sampleRate);
+
+	/** Applies the value of the ParameterChange event if the given sound generator owns it. */
+	bool applyEvent(const HiseEvent& e, const Processor* renderingSynth);
+
+	/** Applies all values that were not consumed by a sound generator. Call this at the end of each audio callback. */
+	void finishBlock();
+
+	void setEnabled(bool shouldBeEnabled) { enabled.store(shouldBeEnabled); }
+
+	bool isEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+
+	/** Returns the sound generator that renders the given module in sub-blocks or nullptr if there is none. */
+	static const Processor* getOwnerSynth(const Processor* p);
+
+private:
+
+	struct QueuedValue
+	{
+		int slotIndex;
+		uint16 generation;
+		float value;
+		int offset;
+	};
+
+	struct PendingValue
+	{
+		int slotIndex;
+		uint16 generation;
+		const Processor* owner;
+		float value;
+		int offset;
+		bool applied;
+	};
+
+	struct ThrottledTarget
+	{
+		int slotIndex;
+		uint16 generation;
+	};
+
+	/** Resolves the target of a slot and keeps it alive while a value is applied. The target lock
+		is only held during the lookup, so the target can't be removed until this goes out of scope.
+	*/
+	struct ScopedTarget
+	{
+		ScopedTarget(HostAutomationLane& l, int slotIndex, uint16 generation);
+		~ScopedTarget();
+
+		Target* operator->() const noexcept { return t; }
+		Target& operator*() const noexcept { return *t; }
+		explicit operator bool() const noexcept { return t != nullptr; }
+
+	private:
+
+		Target* t = nullptr;
+
+		JUCE_DECLARE_NON_COPYABLE(ScopedTarget);
+	};
+
+	bool isRunning() const noexcept;
+
+	int getOffsetForCurrentTime() const noexcept;
+
+	void addTarget(Target& t);
+
+	void removeTarget(Target& t);
+
+	Target* getTarget(int slotIndex, uint16 generation) const noexcept;
+
+	void addThrottledValue(Target& t, float value);
+
+	void applyThrottledValues(bool force);
+
+	void applyQueuedValues();
+
+	std::atomic<bool> enabled;
+	std::atomic<int64> lastBlockStart;
+	std::atomic<double> blockDuration;
+	std::atomic<double> sampleRate;
+	std::atomic<Thread::ThreadID> audioThreadId;
+
+	MultithreadedLockfreeQueue<QueuedValue, MultithreadedQueueHelpers::Configuration::NoAllocationsTokenlessUsageAllowed> queue;
+
+	// Only locked while a target is added, removed or resolved, never while a value is applied
+	SpinLock targetLock;
+
+	// Set by the thread that drains the queue (and owns the throttled targets)
+	std::atomic<bool> draining;
+
+	bool insideBlock = false;
+
+	Target* targets[MaxNumTargets];
+	uint16 generations[MaxNumTargets];
+
+	PendingValue pending[MaxNumEventsPerBlock];
+	int numPending = 0;
+
+	ThrottledTarget throttledTargets[MaxNumThrottledTargets];
+	int numThrottled = 0;
+
+	JUCE_DECLARE_WEAK_REFERENCEABLE(HostAutomationLane);
+	JUCE_DECLARE_NON_COPYABLE(HostAutomationLane);
+};
+
+}
@@ -0,0 +1,289 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#if HI_RUN_UNIT_TESTS
+
+namespace hise { using namespace juce;
+
+/** Checks the timestamps, coalescing and throttling of the host automation lane. */
+class HostAutomationLaneTest : public UnitTest
+{
+public:
+
+	static constexpr int BlockSize = 512;
+	static constexpr double SampleRate = 44100.0;
+
+	HostAutomationLaneTest() :
+		UnitTest("Testing host automation lane")
+	{}
+
+	void runTest() override
+	{
+		testTimestamps();
+		testThrottling();
+		testDirectApplication();
+		testTargetChangesInsideBlock();
+	}
+
+private:
+
+	struct TestTarget : public HostAutomationLane::Target
+	{
+		TestTarget(HostAutomationLane& l, const Processor* owner_, bool throttle_=false) :
+			Target(l),
+			owner(owner_),
+			throttle(throttle_)
+		{}
+
+		void applyHostAutomation(float value) override { values.add(value); }
+		const Processor* getHostAutomationOwner() const override { return owner; }
+		bool shouldThrottleHostAutomation() const override { return throttle; }
+
+		const Processor* owner;
+		const bool throttle;
+		Array<float> values;
+	};
+
+	static const Processor* getFakeSynth(int index)
+	{
+		// The lane only compares the owner pointers
+		return reinterpret_cast<const Processor*>((pointer_sized_int)(index + 1) * 64);
+	}
+
+	void testTimestamps()
+	{
+		beginTest("Testing timestamps and coalescing");
+
+		HostAutomationLane lane;
+		lane.setEnabled(true);
+
+		TestTarget a(lane, getFakeSynth(0)), b(lane, getFakeSynth(1));
+
+		expect(!lane.pushAtOffset(a, 0.1f, 0), "stopped lane accepted a value");
+		expectEquals(a.values.size(), 0, "value was applied twice");
+
+		HiseEventBuffer buffer;
+
+		lane.processBlock(&buffer, BlockSize, SampleRate);
+		lane.finishBlock();
+
+		expect(lane.pushAtOffset(a, 0.2f, 0), "value wasn't queued");
+		lane.pushAtOffset(a, 0.3f, 100);
+		lane.pushAtOffset(a, 0.4f, 100 + HISE_EVENT_RASTER - 1 - 100 % HISE_EVENT_RASTER);
+		lane.pushAtOffset(b, 0.5f, 100);
+		lane.pushAtOffset(b, 0.6f, BlockSize * 4);
+
+		buffer.clear();
+		lane.processBlock(&buffer, BlockSize, SampleRate);
+
+		expectEquals(buffer.getNumUsed(), 4, "values weren't coalesced");
+
+		auto aligned = 100 - 100 % HISE_EVENT_RASTER;
+		auto last = (BlockSize - 1) - (BlockSize - 1) % HISE_EVENT_RASTER;
+
+		int expectedTimestamps[4] = { 0, aligned, aligned, last };
+		int index = 0;
+
+		for (const auto& e : buffer)
+		{
+			expect(e.isParameterChange(), "wrong event type");
+			expectEquals((int)e.getTimeStamp(), expectedTimestamps[index++], "wrong timestamp");
+		}
+
+		for (const auto& e : buffer)
+		{
+			expect(!lane.applyEvent(e, getFakeSynth(2)), "value applied by the wrong synth");
+
+			if (e.getTimeStamp() == 0)
+			{
+				expect(lane.applyEvent(e, getFakeSynth(0)), "value wasn't applied");
+				expect(!lane.applyEvent(e, getFakeSynth(0)), "value was applied twice");
+				expectEquals(a.values.getLast(), 0.2f, "wrong value");
+			}
+		}
+
+		expectEquals(a.values.size(), 1, "value applied before its timestamp");
+
+		lane.finishBlock();
+
+		expectEquals(a.values.size(), 2, "value wasn't applied at the end of the block");
+		expectEquals(a.values.getLast(), 0.4f, "coalesced value isn't the last one");
+		expectEquals(b.values.size(), 2, "wrong value count");
+		expectEquals(b.values.getLast(), 0.6f, "wrong value order");
+	}
+
+	void testThrottling()
+	{
+		beginTest("Testing throttled script callbacks");
+
+		HostAutomationLane lane;
+		lane.setEnabled(true);
+
+		TestTarget t(lane, nullptr, true);
+		HiseEventBuffer buffer;
+
+		lane.processBlock(&buffer, BlockSize, SampleRate);
+		lane.finishBlock();
+
+		for (int i = 0; i < 100; i++)
+			lane.pushAtOffset(t, (float)i, i);
+
+		lane.processBlock(&buffer, BlockSize, SampleRate);
+		lane.finishBlock();
+
+		expect(buffer.isEmpty(), "throttled value was added as event");
+		expectEquals(t.values.size(), 1, "throttled value was applied more than once");
+		expectEquals(t.values.getLast(), 99.0f, "throttled value isn't the last one");
+
+		lane.pushAtOffset(t, 100.0f, 0);
+		lane.pushAtOffset(t, 101.0f, 0);
+
+		lane.processBlock(&buffer, BlockSize, SampleRate);
+		lane.finishBlock();
+
+		expectEquals(t.values.size(), 1, "value wasn't throttled");
+
+		Thread::sleep(roundToInt(HostAutomationLane::ThrottleMilliseconds) + 10);
+
+		lane.processBlock(&buffer, BlockSize, SampleRate);
+		lane.finishBlock();
+
+		expectEquals(t.values.size(), 2, "last throttled value wasn't delivered");
+		expectEquals(t.values.getLast(), 101.0f, "wrong throttled value");
+	}
+
+	void testDirectApplication()
+	{
+		beginTest("Testing direct application");
+
+		HostAutomationLane lane;
+		HiseEventBuffer buffer;
+
+		lane.processBlock(&buffer, BlockSize, SampleRate);
+		lane.finishBlock();
+
+		{
+			TestTarget t(lane, getFakeSynth(0));
+
+			t.setHostAutomationValue(0.5f);
+			expectEquals(t.values.size(), 1, "disabled lane didn't apply the value directly");
+
+			lane.setEnabled(true);
+
+			t.setHostAutomationValue(0.6f);
+			expectEquals(t.values.size(), 1, "enabled lane applied the value directly");
+
+			// Without an event buffer (eg. in an FX plugin) the values are applied at the start of the block
+			lane.processBlock(nullptr, BlockSize, SampleRate);
+			expectEquals(t.values.size(), 2, "value wasn't applied at the block start");
+			lane.finishBlock();
+
+			lane.pushAtOffset(t, 0.7f, 0);
+		}
+
+		// The target was deleted with a queued value
+		lane.processBlock(&buffer, BlockSize, SampleRate);
+		expect(buffer.isEmpty(), "value of deleted target was added");
+		lane.finishBlock();
+	}
+
+	struct TargetChangeThread : public Thread
+	{
+		TargetChangeThread(HostAutomationLane& l, std::unique_ptr<TestTarget>& toRemove_) :
+			Thread("Target changes"),
+			lane(l),
+			toRemove(toRemove_)
+		{}
+
+		void run() override
+		{
+			added = std::make_unique<TestTarget>(lane, getFakeSynth(1));
+			toRemove = nullptr;
+		}
+
+		HostAutomationLane& lane;
+		std::unique_ptr<TestTarget>& toRemove;
+		std::unique_ptr<TestTarget> added;
+	};
+
+	void testTargetChangesInsideBlock()
+	{
+		beginTest("Testing target changes during a block");
+
+		HostAutomationLane lane;
+		lane.setEnabled(true);
+
+		HiseEventBuffer buffer;
+
+		lane.processBlock(&buffer, BlockSize, SampleRate);
+		lane.finishBlock();
+
+		auto removed = std::make_unique<TestTarget>(lane, getFakeSynth(0));
+		lane.pushAtOffset(*removed, 0.5f, 0);
+
+		buffer.clear();
+		lane.processBlock(&buffer, BlockSize, SampleRate);
+		expectEquals(buffer.getNumUsed(), 1, "value wasn't queued");
+
+		// The targets aren't locked between processBlock() and finishBlock()
+		TargetChangeThread t(lane, removed);
+		t.startThread();
+
+		auto changedInsideBlock = t.waitForThreadToExit(1000);
+		expect(changedInsideBlock, "target changes waited for the end of the block");
+
+		if (!changedInsideBlock)
+		{
+			lane.finishBlock();
+			t.waitForThreadToExit(-1);
+		}
+
+		for (const auto& e : buffer)
+			lane.applyEvent(e, getFakeSynth(0));
+
+		lane.finishBlock();
+
+		expect(t.added->values.isEmpty(), "value was applied to the new target");
+
+		lane.pushAtOffset(*t.added, 0.6f, 0);
+		lane.processBlock(nullptr, BlockSize, SampleRate);
+		lane.finishBlock();
+
+		expectEquals(t.added->values.getLast(), 0.6f, "target added during a block doesn't work");
+	}
+};
+
+static HostAutomationLaneTest hostAutomationLaneTest;
+
+}
+
+#endif
@@ -0,0 +1,372 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+class LazyImageCache::PixelData : public ImagePixelData
+{
+public:
+
+	/** Keeps the decoded image alive as long as the bitmap data is used (so that an eviction
+		during a paint call doesn't free the memory). */
+	struct Releaser : public Image::BitmapData::BitmapDataReleaser
+	{
+		Releaser(const Image& img, std::unique_ptr<BitmapDataReleaser> inner_) :
+			decoded(img),
+			inner(std::move(inner_))
+		{};
+
+		Image decoded;
+		std::unique_ptr<BitmapDataReleaser> inner;
+	};
+
+	PixelData(MemoryBlock&& data, int w, int h) :
+		ImagePixelData(Image::ARGB, w, h),
+		encodedData(std::move(data))
+	{
+		cache->registerImage(this);
+	}
+
+	~PixelData()
+	{
+		cache->deregisterImage(this);
+	}
+
+	std::unique_ptr<LowLevelGraphicsContext> createLowLevelContext() override
+	{
+		pinned = true;
+		sendDataChangeMessage();
+		return getDecodedImage(false).getPixelData()->createLowLevelContext();
+	}
+
+	Ptr clone() override
+	{
+		return getDecodedImage(false).getPixelData()->clone();
+	}
+
+	std::unique_ptr<ImageType> createType() const override
+	{
+		return std::make_unique<SoftwareImageType>();
+	}
+
+	void initialiseBitmapData(Image::BitmapData& bd, int x, int y, Image::BitmapData::ReadWriteMode mode) override
+	{
+		auto img = getDecodedImage(false);
+
+		img.getPixelData()->initialiseBitmapData(bd, x, y, mode);
+		bd.dataReleaser.reset(new Releaser(img, std::move(bd.dataReleaser)));
+
+		if (mode != Image::BitmapData::readOnly)
+		{
+			pinned = true;
+			sendDataChangeMessage();
+		}
+	}
+
+	/** Decodes the image if necessary and returns it. */
+	Image getDecodedImage(bool isBackgroundDecode)
+	{
+		ScopedLock sl(decodeLock);
+
+		lastAccess = cache->getNextAccessTime();
+
+		const bool wasHit = decoded.isValid();
+
+		if (!wasHit)
+		{
+			MemoryInputStream mis(encodedData, false);
+			PNGImageFormat format;
+
+			auto img = format.decodeImage(mis);
+
+			if (img.isValid() && img.getFormat() != Image::ARGB)
+				img = img.convertedToFormat(Image::ARGB);
+
+			if (!img.isValid() || img.getWidth() != width || img.getHeight() != height)
+			{
+				// the PNG header lied to us...
+				jassertfalse;
+				img = Image(Image::ARGB, width, height, true, SoftwareImageType());
+			}
+
+			decoded = img;
+		}
+
+		auto img = decoded;
+
+		// don't hold the decode lock while evicting other images
+		ScopedUnlock sul(decodeLock);
+		cache->imageWasDecoded(this, wasHit, isBackgroundDecode);
+
+		return img;
+	}
+
+	/** Frees the decoded pixels. Returns false if the image is busy or pinned. */
+	bool evict()
+	{
+		ScopedTryLock sl(decodeLock);
+
+		if (!sl.isLocked() || pinned || !decoded.isValid())
+			return false;
+
+		decoded = Image();
+		return true;
+	}
+
+	bool isDecoded() const { return decoded.isValid(); }
+	bool isPinned() const { return pinned; }
+	uint32 getLastAccessTime() const { return lastAccess; }
+	size_t getDecodedSize() const { return (size_t)width * (size_t)height * 4; }
+	size_t getEncodedSize() const { return encodedData.getSize(); }
+
+private:
+
+	SharedResourcePointer<LazyImageCache> cache;
+
+	CriticalSection decodeLock;
+	const MemoryBlock encodedData;
+	Image decoded;
+
+	std::atomic<bool> pinned = { false };
+	std::atomic<uint32> lastAccess = { 0 };
+};
+
+String LazyImageCache::Statistics::toString() const
+{
+	String s;
+
+	s << "Lazy images: " << String(numDecoded) << "/" << String(numImages) << " decoded";
+	s << " (" << String((double)decodedBytes / 1024.0 / 1024.0, 1) << " / " << String((double)memoryCap / 1024.0 / 1024.0, 0) << " MB)";
+	s << ", Hit rate: " << String(getHitRate() * 100.0, 1) << "%";
+	s << ", Evictions: " << String(numEvictions);
+
+	return s;
+}
+
+LazyImageCache::LazyImageCache() :
+	Thread("Lazy Image Decoder"),
+	memoryCap((size_t)HISE_LAZY_IMAGE_POOL_MEMORY_MB * 1024 * 1024)
+{
+	startThread(3);
+}
+
+LazyImageCache::~LazyImageCache()
+{
+	{
+		ScopedLock sl(lock);
+		decodeQueue.clear();
+	}
+
+	stopThread(1000);
+}
+
+Image LazyImageCache::createLazyImage(MemoryBlock&& encodedData)
+{
+	// 8 byte PNG signature + IHDR chunk (length, type, width, height)
+	static const uint8 pngSignature[] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+
+	if (encodedData.getSize() < 24 || memcmp(encodedData.getData(), pngSignature, 8) != 0)
+		return {};
+
+	auto header = static_cast<const uint8*>(encodedData.getData());
+
+	if (memcmp(header + 12, "IHDR", 4) != 0)
+		return {};
+
+	auto w = (int)ByteOrder::bigEndianInt(header + 16);
+	auto h = (int)ByteOrder::bigEndianInt(header + 20);
+
+	if (w <= 0 || h <= 0)
+		return {};
+
+	ImagePixelData::Ptr pd = new PixelData(std::move(encodedData), w, h);
+
+	{
+		SharedResourcePointer<LazyImageCache> cache;
+
+		ScopedLock sl(cache->lock);
+		cache->decodeQueue.add(pd);
+		cache->notify();
+	}
+
+	return Image(pd);
+}
+
+void LazyImageCache::setMemoryCap(size_t numBytes)
+{
+	{
+		ScopedLock sl(lock);
+		memoryCap = numBytes;
+	}
+
+	evictIfNecessary(nullptr);
+}
+
+LazyImageCache::Statistics LazyImageCache::getStatistics() const
+{
+	Statistics s;
+
+	ScopedLock sl(lock);
+
+	s.numImages = images.size();
+
+	for (auto p : images)
+	{
+		s.encodedBytes += p->getEncodedSize();
+
+		if (p->isDecoded())
+			s.numDecoded++;
+	}
+
+	s.decodedBytes = decodedBytes;
+	s.memoryCap = memoryCap;
+	s.numHits = numHits.load();
+	s.numMisses = numMisses.load();
+	s.numEvictions = numEvictions.load();
+	s.numBackgroundDecodes = numBackgroundDecodes.load();
+
+	return s;
+}
+
+void LazyImageCache::run()
+{
+	while (!threadShouldExit())
+	{
+		ImagePixelData::Ptr next;
+
+		{
+			ScopedLock sl(lock);
+
+			// Only prefetch as long as there is space left
+			if (!decodeQueue.isEmpty())
+			{
+				next = decodeQueue.removeAndReturn(0);
+
+				auto p = static_cast<PixelData*>(next.get());
+
+				if (p->isDecoded() || decodedBytes + p->getDecodedSize() > memoryCap)
+					next = nullptr;
+			}
+		}
+
+		if (next != nullptr)
+		{
+			static_cast<PixelData*>(next.get())->getDecodedImage(true);
+			next = nullptr;
+			continue;
+		}
+
+		wait(500);
+	}
+}
+
+void LazyImageCache::registerImage(PixelData* p)
+{
+	ScopedLock sl(lock);
+	images.add(p);
+}
+
+void LazyImageCache::deregisterImage(PixelData* p)
+{
+	ScopedLock sl(lock);
+
+	if (p->isDecoded())
+		decodedBytes -= jmin(decodedBytes, p->getDecodedSize());
+
+	images.removeFirstMatchingValue(p);
+}
+
+void LazyImageCache::imageWasDecoded(PixelData* p, bool wasHit, bool isBackgroundDecode)
+{
+	if (isBackgroundDecode)
+		numBackgroundDecodes++;
+	else if (wasHit)
+		numHits++;
+	else
+		numMisses++;
+
+	if (!wasHit)
+	{
+		{
+			ScopedLock sl(lock);
+			decodedBytes += p->getDecodedSize();
+		}
+
+		evictIfNecessary(p);
+	}
+}
+
+void LazyImageCache::evictIfNecessary(PixelData* justDecoded)
+{
+	ScopedLock sl(lock);
+
+	if (decodedBytes <= memoryCap)
+		return;
+
+	Array<PixelData*> candidates;
+
+	for (auto p : images)
+	{
+		if (p != justDecoded && p->isDecoded() && !p->isPinned())
+			candidates.add(p);
+	}
+
+	struct LRUSorter
+	{
+		static int compareElements(PixelData* first, PixelData* second)
+		{
+			auto t1 = first->getLastAccessTime();
+			auto t2 = second->getLastAccessTime();
+
+			if (t1 < t2) return -1;
+			if (t1 > t2) return 1;
+			return 0;
+		}
+	};
+
+	LRUSorter sorter;
+	candidates.sort(sorter);
+
+	for (auto p : candidates)
+	{
+		if (decodedBytes <= memoryCap)
+			break;
+
+		if (p->evict())
+		{
+			decodedBytes -= jmin(decodedBytes, p->getDecodedSize());
+			numEvictions++;
+		}
+	}
+}
+
+}
@@ -0,0 +1,122 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#pragma once
+
+namespace hise { using namespace juce;
+
+/** A process-wide cache for lazily decoded pool images.
+
+	If HISE_USE_LAZY_IMAGE_POOL is enabled, the image pool doesn't decode the embedded PNG
+	files when they are loaded. Instead it creates an Image with a custom ImagePixelData that
+	only holds the compressed data. The pixels are decoded on a background thread (or
+	synchronously if the image is painted before the background thread got to it).
+
+	Decoded images that exceed the memory cap are evicted with a LRU policy and will be
+	decoded again when they are accessed the next time. Images that were written to are
+	pinned and will never be evicted.
+
+	This works transparently for every code path that uses the image through an
+	Image::BitmapData (which is everything that draws the image with a Graphics context).
+*/
+class LazyImageCache : private Thread
+{
+public:
+
+	struct Statistics
+	{
+		int numImages = 0;
+		int numDecoded = 0;
+		size_t decodedBytes = 0;
+		size_t encodedBytes = 0;
+		size_t memoryCap = 0;
+		int64 numHits = 0;
+		int64 numMisses = 0;
+		int64 numEvictions = 0;
+		int64 numBackgroundDecodes = 0;
+
+		double getHitRate() const
+		{
+			auto total = numHits + numMisses;
+			return total > 0 ? (double)numHits / (double)total : 1.0;
+		}
+
+		String toString() const;
+	};
+
+	LazyImageCache();
+	~LazyImageCache();
+
+	/** Creates a image that decodes the given PNG data on demand. Returns a null image if
+		the data is not a PNG file (in this case you need to decode the image yourself).
+	*/
+	static Image createLazyImage(MemoryBlock&& encodedData);
+
+	/** Sets the maximum amount of memory for the decoded images. */
+	void setMemoryCap(size_t numBytes);
+
+	Statistics getStatistics() const;
+
+	class PixelData;
+
+private:
+
+	friend class PixelData;
+
+	void run() override;
+
+	void registerImage(PixelData* p);
+	void deregisterImage(PixelData* p);
+
+	void imageWasDecoded(PixelData* p, bool wasHit, bool isBackgroundDecode);
+	void evictIfNecessary(PixelData* justDecoded);
+
+	uint32 getNextAccessTime() noexcept { return ++accessCounter; }
+
+	mutable CriticalSection lock;
+
+	Array<PixelData*> images;
+	ReferenceCountedArray<ImagePixelData> decodeQueue;
+
+	std::atomic<uint32> accessCounter = { 0 };
+	std::atomic<int64> numHits = { 0 };
+	std::atomic<int64> numMisses = { 0 };
+	std::atomic<int64> numEvictions = { 0 };
+	std::atomic<int64> numBackgroundDecodes = { 0 };
+
+	size_t decodedBytes = 0;
+	size_t memoryCap;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LazyImageCache);
+};
+
+}
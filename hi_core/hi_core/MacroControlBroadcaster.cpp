@@ -39,13 +39,13 @@ namespace hise { using namespace juce;
 	{}
 
 	void MacroControlBroadcaster::MacroControlledParameterData::setInverted(bool shouldBeInverted)
-	{ inverted = shouldBeInverted; }
+	{ inverted = shouldBeInverted; connectionChanged(); }
 
 	void MacroControlBroadcaster::MacroControlledParameterData::setIsCustomAutomation(bool shouldBeCustomAutomation)
-	{ customAutomation = shouldBeCustomAutomation; }
+	{ customAutomation = shouldBeCustomAutomation; connectionChanged(); }
 
 	void MacroControlBroadcaster::MacroControlledParameterData::setReadOnly(bool shouldBeReadOnly)
-	{ readOnly = shouldBeReadOnly; }
+	{ readOnly = shouldBeReadOnly; connectionChanged(); }
 
 	bool MacroControlBroadcaster::MacroControlledParameterData::isReadOnly() const
 	{ return readOnly;}
@@ -63,10 +63,10 @@ namespace hise { using namespace juce;
 	{return parameterRange;}
 
 	void MacroControlBroadcaster::MacroControlledParameterData::setRangeStart(double min)
-	{parameterRange.start = min; }
+	{parameterRange.start = min; connectionChanged(); }
 
 	void MacroControlBroadcaster::MacroControlledParameterData::setRangeEnd(double max)
-	{	parameterRange.end = max; }
+	{	parameterRange.end = max; connectionChanged(); }
 
 	Processor* MacroControlBroadcaster::MacroControlledParameterData::getProcessor()
 	{return controlledProcessor.get(); }
@@ -80,6 +80,18 @@ namespace hise { using namespace juce;
 	void MacroControlBroadcaster::MacroControlledParameterData::setParameterIndex(int newParameter)
 	{
 		parameter = newParameter;
+		connectionChanged();
+	}
+
+	void MacroControlBroadcaster::MacroControlledParameterData::setParentMacro(MacroControlData* newParent)
+	{
+		parentMacro = newParent;
+	}
+
+	void MacroControlBroadcaster::MacroControlledParameterData::connectionChanged()
+	{
+		if (auto pm = parentMacro.get())
+			pm->compileConnections();
 	}
 
 	String MacroControlBroadcaster::MacroControlledParameterData::getParameterName() const
@@ -379,6 +391,34 @@ bool MacroControlBroadcaster::MacroControlledParameterData::operator== (const Ma
 	return other.id == id && other.parameter == parameter;
 }
 
+MacroControlBroadcaster::CompiledConnection MacroControlBroadcaster::MacroControlledParameterData::compile() const
+{
+	CompiledConnection c;
+	c.processor = controlledProcessor;
+	c.range = parameterRange;
+	c.parameter = parameter;
+	c.inverted = inverted;
+	c.customAutomation = customAutomation;
+	c.readOnly = readOnly;
+	return c;
+}
+
+void MacroControlBroadcaster::CompiledConnection::apply(double normalizedInputValue) const
+{
+	if (auto p = processor.get())
+	{
+		const float value = (float)range.convertFrom0to1(inverted ? (1.0 - normalizedInputValue) : normalizedInputValue);
+
+		if (customAutomation)
+		{
+			if (auto d = p->getMainController()->getUserPresetHandler().getCustomAutomationData(parameter))
+				d->call(value, dispatch::DispatchType::sendNotificationSync);
+		}
+		else
+			p->setAttribute(parameter, value, readOnly ? sendNotificationSync : dontSendNotification);
+	}
+}
+
 void MacroControlBroadcaster::MacroControlledParameterData::setAttribute(double normalizedInputValue)
 {
 	const float value = getNormalizedValue(normalizedInputValue);
@@ -619,10 +659,38 @@ void MacroControlBroadcaster::MacroControlData::setValue(float newValue)
 
     SimpleReadWriteLock::ScopedReadLock sl(parameterLock);
     
-	for(auto p: controlledParameters)
-		p->setAttribute(newValue / 127.0f);
+	if (parent.isUsingCompiledConnections())
+	{
+		const double normalizedValue = newValue / 127.0f;
+
+		for (const auto& c : compiledConnections)
+			c.apply(normalizedValue);
+	}
+	else
+	{
+		for(auto p: controlledParameters)
+			p->setAttribute(newValue / 127.0f);
+	}
 };
 
+void MacroControlBroadcaster::MacroControlData::compileConnections()
+{
+	Array<CompiledConnection> newConnections;
+
+	{
+		SimpleReadWriteLock::ScopedWriteLock sl(parameterLock);
+
+		newConnections.ensureStorageAllocated(controlledParameters.size());
+
+		for (auto p : controlledParameters)
+			newConnections.add(p->compile());
+
+		compiledConnections.swapWith(newConnections);
+	}
+
+	// the old connections are deallocated here outside the lock
+}
+
 bool MacroControlBroadcaster::MacroControlData::isDanglingProcessor(int parameterIndex) const
 {
     SimpleReadWriteLock::ScopedReadLock sl(parameterLock);
@@ -678,6 +746,7 @@ void MacroControlBroadcaster::MacroControlData::removeParametersFromIndexList(co
         }
     }
     
+    compileConnections();
     pendingDelete.clear();
 }
 
@@ -756,6 +825,7 @@ void MacroControlBroadcaster::MacroControlData::restoreFromValueTree(const Value
     {
         auto nd = new MacroControlledParameterData(getMainController());
         nd->restoreFromValueTree(c);
+        nd->setParentMacro(this);
         newData.add(nd);
     }
     
@@ -764,6 +834,8 @@ void MacroControlBroadcaster::MacroControlData::restoreFromValueTree(const Value
         SimpleReadWriteLock::ScopedWriteLock sl(parameterLock);
         std::swap(newData, controlledParameters);
     }
+
+    compileConnections();
 }
 
 bool MacroControlBroadcaster::MacroControlData::hasParameter(Processor *p, int parameterIndex)
@@ -809,11 +881,14 @@ void MacroControlBroadcaster::MacroControlData::addParameter(Processor *p, int p
                                                readOnly);
     
     nd->setIsCustomAutomation(isUsingCustomData);
+    nd->setParentMacro(this);
     
     {
         SimpleReadWriteLock::ScopedWriteLock sl(parameterLock);
         controlledParameters.add(nd);
     }
+
+    compileConnections();
     
 	parent.sendMacroConnectionChangeMessage(macroIndex, p, parameterId, true, n);
 }
@@ -61,6 +61,28 @@ public:
 
 	virtual ~MacroControlBroadcaster();;
 
+	struct MacroControlData;
+
+	/** A flat copy of a macro connection with the resolved target and range.
+	*	@ingroup macroControl
+	*
+	*	The macro controls compile their parameters into a list of these objects whenever a connection changes,
+	*	so moving a macro just walks this list without any lookups or allocations. The targets are notified
+	*	exactly like with the uncompiled connection (synchronously if the connection is read only).
+	*/
+	struct CompiledConnection
+	{
+		/** Applies the macro value (from 0.0 to 1.0) to the target. */
+		void apply(double normalizedInputValue) const;
+
+		WeakReference<Processor> processor;
+		NormalisableRange<double> range;
+		int parameter = -1;
+		bool inverted = false;
+		bool customAutomation = false;
+		bool readOnly = true;
+	};
+
 	/** A simple POD object to store information about a macro controlled parameter. 
 	*	@ingroup macroControl
 	*
@@ -80,6 +102,12 @@ public:
 
 		void setAttribute(double normalizedInputValue);
 
+		/** Creates a flat copy of this connection that can be applied without lookups. */
+		CompiledConnection compile() const;
+
+		/** Sets the macro control that owns this parameter so that it can recompile its connections after a change. */
+		void setParentMacro(MacroControlData* newParent);
+
 		/** Inverts the range of the parameter. */
 		void setInverted(bool shouldBeInverted);;
 
@@ -150,6 +178,10 @@ public:
         
 	private:
 
+		void connectionChanged();
+
+		WeakReference<MacroControlData> parentMacro;
+
 		// The ID of the Processor that is controlled
         String id;
 
@@ -220,6 +252,9 @@ public:
 		*/
 		void setValue(float newValue);
 
+		/** Rebuilds the compiled connections. This is called automatically whenever a connection changes. */
+		void compileConnections();
+
 		/** Checks if the processor of the parameter still exists. */
 		bool isDanglingProcessor(int parameterIndex) const;
 
@@ -285,6 +320,8 @@ public:
 
 		OwnedArray<MacroControlledParameterData> controlledParameters;
 
+		Array<CompiledConnection> compiledConnections;
+
 		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MacroControlData);
 		JUCE_DECLARE_WEAK_REFERENCEABLE(MacroControlData);
 	};
@@ -341,8 +378,17 @@ public:
 	/** Checks if the macro control has any parameters. */
 	bool hasActiveParameters(int macroIndex);
 
+	/** Enables the compiled macro connections. If disabled, every macro move resolves the parameter data of
+	*	each target. The default is HISE_USE_COMPILED_MACRO_CONNECTIONS.
+	*/
+	void setUseCompiledConnections(bool shouldUseCompiledConnections) { useCompiledConnections = shouldUseCompiledConnections; }
+
+	bool isUsingCompiledConnections() const noexcept { return useCompiledConnections; }
+
 private:
 
+	bool useCompiledConnections = HISE_USE_COMPILED_MACRO_CONNECTIONS;
+
     CriticalSection listenerLock;
     
 	Array<WeakReference<MacroConnectionListener>> macroListeners;
@@ -128,6 +128,7 @@ bool MainController::unitTestMode = false;
 	processorChangeHandler(this),
 	killStateHandler(this),
 	debugLogger(this),
+	cpuProfiler(this),
 	bypassHandler(this),
 	globalAsyncModuleHandler(this),
 	//presetLoadRampFlag(OldUserPresetHandler::Active),
@@ -983,6 +984,8 @@ void MainController::processBlockCommon(AudioSampleBuffer &buffer, MidiBuffer &m
     
 	getDebugLogger().checkAudioCallbackProperties(thisAsProcessor->getSampleRate(), numSamplesThisBlock);
 
+	getCpuProfiler().beginBlock(buffer.getNumSamples(), thisAsProcessor->getSampleRate());
+
 	ScopedNoDenormals snd;
 
 	getDebugLogger().checkPriorityInversion(processLock);
@@ -1100,10 +1103,15 @@ void MainController::processBlockCommon(AudioSampleBuffer &buffer, MidiBuffer &m
 
 	getDebugLogger().logEvents(masterEventBuffer);
 
+	hostAutomationLane.processBlock(&masterEventBuffer, numSamplesThisBlock, thisAsProcessor->getSampleRate());
+
 #else
 	ignoreUnused(midiMessages);
 
 	masterEventBuffer.clear();
+
+	// The effect chain renders the whole block, so the automation is applied at the start
+	hostAutomationLane.processBlock(nullptr, numSamplesThisBlock, thisAsProcessor->getSampleRate());
 #endif
 
 #if ENABLE_HOST_INFO
@@ -1304,7 +1312,7 @@ void MainController::processBlockCommon(AudioSampleBuffer &buffer, MidiBuffer &m
 
 	while (auto e = it.getNextConstEventPointer(true, false))
 	{
-		if (e->isTimerEvent())
+		if (e->isTimerEvent() || e->isParameterChange())
 			continue;
 
 		auto m = e->toMidiMesage();
@@ -1469,6 +1477,8 @@ void MainController::processBlockCommon(AudioSampleBuffer &buffer, MidiBuffer &m
 
 #endif
 
+	hostAutomationLane.finishBlock();
+
 #if ENABLE_CPU_MEASUREMENT
 	stopCpuBenchmark();
 #endif
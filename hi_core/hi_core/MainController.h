@@ -948,6 +948,29 @@ public:
 			useUndoForPresetLoads = shouldAllowUndo;
 		}
 
+		/** The timings and the amount of applied changes of the last preset load. */
+		struct PresetLoadStatistics
+		{
+			String toString() const;
+
+			bool wasIncremental = false;
+			bool wasSuspended = false;
+			int numAppliedChanges = 0;
+			double diffMilliseconds = 0.0;
+			double loadMilliseconds = 0.0;
+			double totalMilliseconds = 0.0;
+		};
+
+		/** If enabled, the preset will be compared against the current state before loading. If only UI control values differ,
+			the changed controls are applied directly without suspending the audio processing (unless one of them is connected to a
+			module that affects the voices). */
+		void setUseIncrementalPresetLoad(bool shouldUseIncrementalLoad)
+		{
+			useIncrementalPresetLoad = shouldUseIncrementalLoad;
+		}
+
+		const PresetLoadStatistics& getLastPresetLoadStatistics() const { return lastLoadStatistics; }
+
 		void preprocess(ValueTree& presetToLoad);
 
 		void postPresetLoad();
@@ -1018,6 +1041,7 @@ public:
 		SharedResourcePointer<TagDataBase> tagDataBase;
 
 		void loadUserPresetInternal();
+		bool loadUserPresetIncrementally();
 		void saveUserPresetInternal(const String& name=String());
 
 		Array<WeakReference<Listener>, CriticalSection> listeners;
@@ -1028,6 +1052,10 @@ public:
 
 		MainController* mc;
 		bool useUndoForPresetLoads = false;
+		bool useIncrementalPresetLoad = HISE_USE_INCREMENTAL_PRESET_LOAD;
+
+		PresetLoadStatistics lastLoadStatistics;
+		double timeOfLastLoadRequest = 0.0;
 
 		
 
@@ -1685,6 +1713,11 @@ public:
 
 	DebugLogger& getDebugLogger() { return debugLogger; }
 	const DebugLogger& getDebugLogger() const { return debugLogger; }
+
+	CpuProfiler& getCpuProfiler() { return cpuProfiler; }
+	const CpuProfiler& getCpuProfiler() const { return cpuProfiler; }
+
+	HostAutomationLane& getHostAutomationLane() { return hostAutomationLane; }
     
 	void addPreviewListener(BufferPreviewListener* l);
 
@@ -2006,6 +2039,7 @@ private: // Never call this directly, but wrap it through DelayedRenderer...
 	// except for the audio rendererbase as this does not need to use the outer interface
 	// (in order to avoid messing with the leftover sample logic from misbehFL!avinStudio!!1!g hosts...)
 	friend class AudioRendererBase;
+	friend class HeadlessRenderer;
 
 	/** This is the main processing loop that is shared among all subclasses. */
 	void processBlockCommon(AudioSampleBuffer &b, MidiBuffer &mb);
@@ -2285,6 +2319,10 @@ private:
 
 	DebugLogger debugLogger;
 
+	CpuProfiler cpuProfiler;
+
+	HostAutomationLane hostAutomationLane;
+
 #if USE_BACKEND
 	Component::SafePointer<ScriptWatchTable> scriptWatchTable;
 	Array<Component::SafePointer<ScriptComponentEditPanel>> scriptComponentEditPanels;
@@ -1716,6 +1716,261 @@ AudioSampleBuffer AudioRendererBase::getChunk(int startSample, int numSamples)
 	return AudioSampleBuffer(splitData, numChannelsToRender, numSamples);
 }
 
+HeadlessRenderer::HeadlessRenderer(MainController* mc, const Options& options_):
+	Thread("AudioExportThread"),
+	ControlledObject(mc),
+	options(options_),
+	renderResult(Result::ok())
+{}
+
+HeadlessRenderer::~HeadlessRenderer()
+{
+	stopThread(1000);
+}
+
+Result HeadlessRenderer::render()
+{
+	auto ok = loadMidiFile();
+
+	if (ok.failed())
+		return ok;
+
+	auto mc = getMainController();
+	auto ap = mc->getAsAudioProcessor();
+
+	// There is no audio device in the command line mode, so we need to prepare the processor manually
+	ap->setRateAndBufferSizeDetails(options.sampleRate, options.blockSize);
+	ap->prepareToPlay(options.sampleRate, options.blockSize);
+
+	numChannels = mc->getMainSynthChain()->getMatrix().getNumSourceChannels();
+
+	output.setSize(numChannels, numSamplesToRender);
+	output.clear();
+
+	blockTimes.clearQuick();
+	blockTimes.ensureStorageAllocated(options.numIterations * (numSamplesToRender / options.blockSize));
+
+	renderResult = Result::ok();
+	mc->getCpuProfiler().reset();
+
+	startThread(8);
+
+	// The message thread is blocked until the rendering is done, so we need to drain the profiler here
+	while (isThreadRunning())
+	{
+		mc->getCpuProfiler().drain();
+		Thread::sleep(20);
+	}
+
+	mc->getCpuProfiler().drain();
+
+	if (renderResult.failed())
+		return renderResult;
+
+	if (options.outputFile != File())
+	{
+		options.outputFile.deleteFile();
+		options.outputFile.getParentDirectory().createDirectory();
+
+		std::unique_ptr<FileOutputStream> fos(options.outputFile.createOutputStream());
+
+		if (fos == nullptr)
+			return Result::fail("Can't write to " + options.outputFile.getFullPathName());
+
+		WavAudioFormat wav;
+
+		// 32bit float without metadata so that the files can be compared byte by byte
+		std::unique_ptr<AudioFormatWriter> writer(wav.createWriterFor(fos.get(), options.sampleRate, (unsigned int)numChannels, 32, {}, 0));
+
+		if (writer == nullptr)
+			return Result::fail("Can't create the audio writer");
+
+		fos.release();
+		writer->writeFromAudioSampleBuffer(output, 0, output.getNumSamples());
+	}
+
+	createReport();
+
+	return Result::ok();
+}
+
+Result HeadlessRenderer::loadMidiFile()
+{
+	FileInputStream fis(options.midiFile);
+
+	if (!fis.openedOk())
+		return Result::fail("Can't open MIDI file " + options.midiFile.getFullPathName());
+
+	MidiFile mf;
+
+	if (!mf.readFrom(fis))
+		return Result::fail("Can't parse MIDI file " + options.midiFile.getFullPathName());
+
+	mf.convertTimestampTicksToSeconds();
+
+	events.clear();
+
+	for (int i = 0; i < mf.getNumTracks(); i++)
+		events.addSequence(*mf.getTrack(i), 0.0);
+
+	for (auto e : events)
+		e->message.setTimeStamp(std::round(e->message.getTimeStamp() * options.sampleRate));
+
+	if (events.getNumEvents() == 0)
+		return Result::fail("The MIDI file doesn't contain any events");
+
+	numSamplesToRender = roundToInt(events.getEndTime()) + roundToInt(options.tailSeconds * options.sampleRate);
+
+	// pad to blocksize
+	if (auto leftOver = numSamplesToRender % options.blockSize)
+		numSamplesToRender += options.blockSize - leftOver;
+
+	return Result::ok();
+}
+
+void HeadlessRenderer::run()
+{
+	auto mc = getMainController();
+
+	mc->getKillStateHandler().setCurrentExportThread(getCurrentThreadId());
+	mc->getAsAudioProcessor()->setNonRealtime(true);
+	mc->getSampleManager().handleNonRealtimeState();
+
+	{
+		LockHelpers::SafeLock sl(mc, LockHelpers::Type::AudioLock);
+
+		for (int i = 0; i < options.numIterations; i++)
+		{
+			if (threadShouldExit())
+			{
+				renderResult = Result::fail("Rendering was cancelled");
+				break;
+			}
+
+			renderIteration(i);
+		}
+	}
+
+	mc->getKillStateHandler().setCurrentExportThread(nullptr);
+	mc->getAsAudioProcessor()->setNonRealtime(false);
+	mc->getSampleManager().handleNonRealtimeState();
+}
+
+void HeadlessRenderer::renderIteration(int iteration)
+{
+	auto mc = getMainController();
+
+	if (options.deterministic)
+		Random::getSystemRandom().setSeed(0);
+
+	mc->getMainSynthChain()->resetAllVoices();
+
+	AudioSampleBuffer block(numChannels, options.blockSize);
+	MidiBuffer mb;
+
+	// Render a few empty buffers so that the initialisation isn't measured
+	for (int i = 0; i < NumWarmupBlocks; i++)
+	{
+		block.clear();
+		mb.clear();
+		mc->processBlockCommon(block, mb);
+	}
+
+	int eventIndex = 0;
+
+	for (int pos = 0; pos < numSamplesToRender; pos += options.blockSize)
+	{
+		block.clear();
+		mb.clear();
+
+		while (eventIndex < events.getNumEvents())
+		{
+			const auto& m = events.getEventPointer(eventIndex)->message;
+			auto timestamp = roundToInt(m.getTimeStamp());
+
+			if (timestamp >= pos + options.blockSize)
+				break;
+
+			if (!m.isMetaEvent())
+				mb.addEvent(m, jmax(0, timestamp - pos));
+
+			eventIndex++;
+		}
+
+		auto start = Time::getHighResolutionTicks();
+
+		mc->processBlockCommon(block, mb);
+
+		blockTimes.add(Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start) * 1000000.0);
+
+		if (iteration == 0)
+		{
+			for (int i = 0; i < numChannels; i++)
+				output.copyFrom(i, pos, block, i, 0, options.blockSize);
+		}
+	}
+}
+
+void HeadlessRenderer::createReport()
+{
+	auto budget = 1000000.0 * (double)options.blockSize / options.sampleRate;
+
+	Array<double> sorted(blockTimes);
+	sorted.sort();
+
+	double sum = 0.0;
+	int numOverruns = 0;
+
+	for (auto t : sorted)
+	{
+		sum += t;
+
+		if (t > budget)
+			numOverruns++;
+	}
+
+	auto numBlocks = jmax(1, sorted.size());
+	auto audioSeconds = (double)numSamplesToRender * (double)options.numIterations / options.sampleRate;
+	auto renderSeconds = sum / 1000000.0;
+
+	// FNV-1a over the sample data so that CI scripts can compare the output without a reference file
+	uint64 hash = 14695981039346656037ull;
+
+	for (int i = 0; i < output.getNumChannels(); i++)
+	{
+		auto data = reinterpret_cast<const uint8*>(output.getReadPointer(i));
+
+		for (size_t j = 0; j < (size_t)output.getNumSamples() * sizeof(float); j++)
+		{
+			hash ^= data[j];
+			hash *= 1099511628211ull;
+		}
+	}
+
+	auto obj = new DynamicObject();
+
+	obj->setProperty("MidiFile", options.midiFile.getFullPathName());
+	obj->setProperty("SampleRate", options.sampleRate);
+	obj->setProperty("BlockSize", options.blockSize);
+	obj->setProperty("NumChannels", numChannels);
+	obj->setProperty("NumIterations", options.numIterations);
+	obj->setProperty("NumBlocks", sorted.size());
+	obj->setProperty("Deterministic", options.deterministic);
+	obj->setProperty("AudioDuration", audioSeconds);
+	obj->setProperty("RenderDuration", renderSeconds);
+	obj->setProperty("RealtimeFactor", renderSeconds > 0.0 ? audioSeconds / renderSeconds : 0.0);
+	obj->setProperty("BlockBudget", budget);
+	obj->setProperty("AverageBlock", sum / (double)numBlocks);
+	obj->setProperty("P50Block", sorted[sorted.size() / 2]);
+	obj->setProperty("P99Block", sorted[(sorted.size() * 99) / 100]);
+	obj->setProperty("MaxBlock", sorted.getLast());
+	obj->setProperty("NumOverruns", numOverruns);
+	obj->setProperty("OutputHash", String::toHexString((int64)hash));
+	obj->setProperty("Profile", getMainController()->getCpuProfiler().toJSON());
+
+	report = var(obj);
+}
+
 
 OverlayMessageBroadcaster::Listener::~Listener()
 {
@@ -831,6 +831,67 @@ private:
 	int bufferSize = 0;
 };
 
+/** Renders a MIDI file through the MainController without an audio device and measures the render time.
+
+	This is used by the `render` and `benchmark` command line actions to catch performance regressions
+	in CI builds. It renders the MIDI file on a separate thread with a fixed block size and returns a JSON
+	report with the realtime factor, the block timings and the per-module statistics of the CpuProfiler.
+*/
+class HeadlessRenderer : public Thread,
+						 public ControlledObject
+{
+public:
+
+	struct Options
+	{
+		File midiFile;
+		File outputFile;
+
+		int blockSize = 512;
+		double sampleRate = 44100.0;
+
+		/** The time in seconds that is rendered after the last MIDI event. */
+		double tailSeconds = 1.0;
+
+		/** The number of times the MIDI file is rendered. Only the first iteration is written to the output file. */
+		int numIterations = 1;
+
+		/** Seeds the random generator before each iteration so that scripts produce the same output. */
+		bool deterministic = false;
+	};
+
+	HeadlessRenderer(MainController* mc, const Options& options);
+	~HeadlessRenderer() override;
+
+	/** Renders the MIDI file and waits until it's done. Call this from the message thread. */
+	Result render();
+
+	/** Returns the report of the last render call. */
+	var getReport() const { return report; }
+
+private:
+
+	static constexpr int NumWarmupBlocks = 16;
+
+	void run() override;
+
+	Result loadMidiFile();
+	void renderIteration(int iteration);
+	void createReport();
+
+	const Options options;
+
+	MidiMessageSequence events;
+	int numSamplesToRender = 0;
+	int numChannels = 0;
+
+	AudioSampleBuffer output;
+	Array<double> blockTimes;
+
+	Result renderResult;
+	var report;
+};
+
 
 } // namespace hise
 
@@ -447,8 +447,14 @@ void MainController::UserPresetHandler::loadUserPresetFromValueTree(const ValueT
 			return SafeFunctionCall::OK;
 		};
 
+		timeOfLastLoadRequest = Time::getMillisecondCounterHiRes();
+		lastLoadStatistics = {};
+
 		preprocess(pendingPreset);
 
+		if (useIncrementalPresetLoad && loadUserPresetIncrementally())
+			return;
+
 		// Send a note off to stop the arpeggiator etc...
 		mc->allNotesOff(false);
 
@@ -536,10 +542,146 @@ void MainController::UserPresetHandler::saveUserPresetInternal(const String& nam
 	UserPresetHelpers::saveUserPreset(mc->getMainSynthChain(), currentPresetFile.getFullPathName());
 }
 
+bool MainController::UserPresetHandler::loadUserPresetIncrementally()
+{
+#if USE_RAW_FRONTEND
+	return false;
+#else
+	// The custom data model restores everything in a single script callback so there's nothing to diff
+	if (isUsingCustomDataModel())
+		return false;
+
+	auto sp = JavascriptMidiProcessor::getFirstInterfaceScriptProcessor(mc);
+
+	if (sp == nullptr)
+		return false;
+
+	auto start = Time::getMillisecondCounterHiRes();
+
+	auto currentState = UserPresetHelpers::createUserPreset(mc->getMainSynthChain());
+
+	ValueTree contentToLoad;
+
+	// Every state except the UI control values (module states, MIDI automation, macros, ...)
+	// must be identical, otherwise we need to suspend the audio processing and load it the normal way
+	for (auto c : pendingPreset)
+	{
+		if (c.getProperty("Processor") == sp->getId())
+		{
+			contentToLoad = c;
+			continue;
+		}
+
+		// A loaded preset might store the properties in a different order or numbers as strings
+		if (!ScriptingApi::Content::Helpers::isEquivalentPresetData(c, currentState.getChildWithName(c.getType())))
+			return false;
+	}
+
+	for (auto c : currentState)
+	{
+		if (c.getProperty("Processor") == sp->getId())
+			continue;
+
+		if (!pendingPreset.getChildWithName(c.getType()).isValid())
+			return false;
+	}
+
+	if (!contentToLoad.isValid())
+		return false;
+
+	auto content = sp->getScriptingContent();
+	auto changedControls = content->getChangedControlsInPreset(contentToLoad);
+
+	// Only master effects can be changed while the voices keep playing. Everything else
+	// (sound generators, modulators, voice effects, MIDI processors) needs the full load.
+	auto affectsVoices = [](Processor* p)
+	{
+		return p != nullptr && dynamic_cast<MasterEffectProcessor*>(p) == nullptr;
+	};
+
+	auto macroNames = content->getMacroNames();
+
+	for (auto i : changedControls)
+	{
+		auto sc = content->getComponent(i);
+
+		if (affectsVoices(sc->getConnectedProcessor()))
+			return false;
+
+		auto macroIndex = macroNames.indexOf(sc->getScriptObjectProperty(ScriptingApi::Content::ScriptComponent::macroControl).toString()) - 1;
+
+		if (macroIndex >= 0)
+		{
+			auto md = mc->getMacroManager().getMacroChain()->getMacroControlData(macroIndex);
+
+			for (int j = 0; j < md->getNumParameters(); j++)
+			{
+				if (affectsVoices(md->getParameter(j)->getProcessor()))
+					return false;
+			}
+		}
+	}
+
+	auto diffEnd = Time::getMillisecondCounterHiRes();
+
+	{
+		ScopedValueSetter<void*> svs(currentThreadThatIsLoadingPreset, LockHelpers::getCurrentThreadHandleOrMessageManager());
+
+		timeOfLastPresetLoad = Time::getMillisecondCounter();
+
+		try
+		{
+			content->restoreChangedControlsFromPreset(contentToLoad, changedControls);
+			lastLoadStatistics.numAppliedChanges = changedControls.size();
+		}
+		catch (String& m)
+		{
+			ignoreUnused(m);
+			jassertfalse;
+			DBG(m);
+		}
+
+		postPresetLoad();
+	}
+
+	auto end = Time::getMillisecondCounterHiRes();
+
+	lastLoadStatistics.wasIncremental = true;
+	lastLoadStatistics.wasSuspended = false;
+	lastLoadStatistics.diffMilliseconds = diffEnd - start;
+	lastLoadStatistics.loadMilliseconds = end - diffEnd;
+	lastLoadStatistics.totalMilliseconds = end - timeOfLastLoadRequest;
+
+	return true;
+#endif
+}
+
+String MainController::UserPresetHandler::PresetLoadStatistics::toString() const
+{
+	String s;
+
+	s << (wasIncremental ? "Incremental" : "Full") << " preset load: ";
+	s << String(numAppliedChanges) << " changes applied";
+
+	if (wasIncremental)
+		s << ", Diff: " << String(diffMilliseconds, 2) << "ms";
+
+	s << ", Load: " << String(loadMilliseconds, 2) << "ms";
+	s << ", Total: " << String(totalMilliseconds, 2) << "ms";
+
+	if (!wasSuspended)
+		s << " (no suspension)";
+
+	return s;
+}
+
 void MainController::UserPresetHandler::loadUserPresetInternal()
 {
 	ScopedValueSetter<void*> svs(currentThreadThatIsLoadingPreset, LockHelpers::getCurrentThreadHandleOrMessageManager());
 
+	auto loadStart = Time::getMillisecondCounterHiRes();
+	lastLoadStatistics.numAppliedChanges = 0;
+
 	{
 		LockHelpers::freeToGo(mc);
 
@@ -600,7 +742,10 @@ void MainController::UserPresetHandler::loadUserPresetInternal()
 					}
 
 					if (v.isValid())
+					{
 						sp->getScriptingContent()->restoreAllControlsFromPreset(v);
+						lastLoadStatistics.numAppliedChanges += v.getNumChildren();
+					}
 				}
 			}
 		}
@@ -632,6 +777,13 @@ void MainController::UserPresetHandler::loadUserPresetInternal()
 	}
 
 	mc->getSampleManager().preloadEverything();
+
+	auto end = Time::getMillisecondCounterHiRes();
+
+	lastLoadStatistics.wasIncremental = false;
+	lastLoadStatistics.wasSuspended = true;
+	lastLoadStatistics.loadMilliseconds = end - loadStart;
+	lastLoadStatistics.totalMilliseconds = timeOfLastLoadRequest > 0.0 ? end - timeOfLastLoadRequest : lastLoadStatistics.loadMilliseconds;
 }
 
 void MainController::UserPresetHandler::postPresetSave()
@@ -53,8 +53,13 @@
 
 #include "UtilityClasses.cpp"
 #include "DebugLogger.cpp"
+#include "CpuProfiler.cpp"
+#include "CpuProfilerTests.cpp"
+#include "HostAutomationLane.cpp"
+#include "HostAutomationLaneTests.cpp"
 #include "MainControllerShell.cpp" // provides encapsulated access to MainController functions
 #include "ThreadWithQuasiModalProgressWindow.cpp"
+#include "LazyImageCache.cpp"
 #include "ExternalFilePool.cpp"
 #include "ExpansionHandler.cpp"
 #include "GlobalScriptCompileBroadcaster.cpp"
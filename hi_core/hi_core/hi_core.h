@@ -78,6 +78,8 @@
 #include "UtilityClasses.h"
 
 #include "DebugLogger.h"
+#include "CpuProfiler.h"
+#include "HostAutomationLane.h"
 #include "MainControllerShell.h" // provides encapsulated access to MainController functions
 #include "ThreadWithQuasiModalProgressWindow.h"
 #include "Popup.h"
@@ -87,6 +89,7 @@
 
 #include "PresetHandler.h"
 
+#include "LazyImageCache.h"
 #include "ExternalFilePool.h"
 
 
@@ -53,6 +53,7 @@
 #include "modules/ModulatorChain.cpp"
 #include "modules/MidiProcessor.cpp"
 #include "modules/MidiPlayer.cpp"
+#include "modules/MidiPlayerTests.cpp"
 #include "modules/EffectProcessor.cpp"
 #include "modules/EffectProcessorChain.cpp"
 #include "modules/ModulatorSynth.cpp"
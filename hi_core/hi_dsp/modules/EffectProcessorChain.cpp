@@ -267,9 +267,12 @@ void EffectProcessorChain::renderMasterEffects(AudioSampleBuffer &b)
 
 	ADD_GLITCH_DETECTOR(parentProcessor, DebugLogger::Location::MasterEffectRendering);
 
+	auto& profiler = getMainController()->getCpuProfiler();
+
 	for(auto mfx: masterEffects)
 	{
 		ScopedAnalyser sa(getMainController(), mfx, b, b.getNumSamples());
+		CpuProfiler::ScopedMeasurement sm(profiler, mfx, CpuProfiler::Category::Effect);
 
 		if(!mfx->isSoftBypassed())
 			mfx->renderWholeBuffer(b);
@@ -146,6 +146,57 @@ void HiseMidiSequence::TimeSignature::restoreFromValueTree(const ValueTree& v)
 	bpm =						 v.getProperty(TimeSigIds::Tempo, 120.0);
 }
 
+HiseMidiSequence::Timeline::Timeline(const MidiMessageSequence& seq)
+{
+	events.ensureStorageAllocated(seq.getNumEvents());
+
+	HashMap<const void*, int> indexes;
+
+	for (int i = 0; i < seq.getNumEvents(); i++)
+	{
+		auto holder = seq.getEventPointer(i);
+
+		Event e;
+		e.timestamp = holder->message.getTimeStamp();
+		e.event = HiseEvent(holder->message);
+
+		events.add(e);
+		indexes.set(holder, i);
+	}
+
+	int noteIndex = 0;
+
+	for (int i = 0; i < seq.getNumEvents(); i++)
+	{
+		auto holder = seq.getEventPointer(i);
+
+		if (holder->message.isNoteOn() && holder->noteOffObject != nullptr && indexes.contains(holder->noteOffObject))
+		{
+			auto offIndex = indexes[holder->noteOffObject];
+
+			auto& on = events.getReference(i);
+			auto& off = events.getReference(offIndex);
+
+			on.pairIndex = offIndex;
+			on.noteIndex = noteIndex;
+			off.pairIndex = i;
+			off.noteIndex = noteIndex;
+
+			noteIndex++;
+		}
+	}
+}
+
+int HiseMidiSequence::Timeline::getNextIndexAtTime(double ticks) const
+{
+	auto it = std::lower_bound(events.begin(), events.end(), ticks, [](const Event& e, double t)
+	{
+		return e.timestamp < t;
+	});
+
+	return (int)(it - events.begin());
+}
+
 HiseMidiSequence::Ptr HiseMidiSequence::clone() const
 {
 	HiseMidiSequence::Ptr newSeq = new HiseMidiSequence();
@@ -234,15 +285,15 @@ void HiseMidiSequence::restoreFromValueTree(const ValueTree &v)
 }
 
 
-juce::MidiMessage* HiseMidiSequence::getNextEvent(Range<double> rangeToLookForTicks)
+const HiseMidiSequence::Timeline::Event* HiseMidiSequence::getNextEvent(Range<double> rangeToLookForTicks)
 {
 	SimpleReadWriteLock::ScopedReadLock sl(swapLock);
 
 	auto nextIndex = lastPlayedIndex + 1;
 
-	if (auto seq = getReadPointer(currentTrackIndex))
+	if (auto tl = timelines.getObjectPointer(currentTrackIndex))
 	{
-		if (nextIndex >= seq->getNumEvents())
+		if (nextIndex >= tl->getNumEvents())
 		{
 			lastPlayedIndex = -1;
 			nextIndex = 0;
@@ -261,19 +312,19 @@ juce::MidiMessage* HiseMidiSequence::getNextEvent(Range<double> rangeToLookForTi
 			Range<double> beforeWrap = { rangeToLookForTicks.getStart(), loopEndTicks };
 			Range<double> afterWrap = { loopStartTicks, rangeEndAfterWrap };
 
-			if (auto nextEvent = seq->getEventPointer(nextIndex))
+			if (auto nextEvent = tl->getEvent(nextIndex))
 			{
-				auto ts = nextEvent->message.getTimeStamp();
+				auto ts = nextEvent->timestamp;
 
 				if (beforeWrap.contains(ts))
 				{
 					lastPlayedIndex = nextIndex;
-					return &nextEvent->message;
+					return nextEvent;
 				}
 				if (afterWrap.contains(ts))
 				{
 					lastPlayedIndex = nextIndex;
-					return &nextEvent->message;
+					return nextEvent;
 				}
 
 				// We don't want to wrap around notes that lie within the loop range.
@@ -281,38 +332,27 @@ juce::MidiMessage* HiseMidiSequence::getNextEvent(Range<double> rangeToLookForTi
 					return nullptr;
 			}
 
-			auto indexAfterWrap = seq->getNextIndexAtTime(loopStartTicks);
-
-			if (auto afterEvent = seq->getEventPointer(indexAfterWrap))
-			{
-				while (afterEvent != nullptr && afterEvent->message.isNoteOff())
-				{
-					indexAfterWrap++;
+			auto indexAfterWrap = tl->getNextIndexAtTime(loopStartTicks);
 
-					afterEvent = seq->getEventPointer(indexAfterWrap);
-				}
+			auto afterEvent = tl->getEvent(indexAfterWrap);
 
-				if (afterEvent != nullptr && !afterEvent->message.isNoteOff())
-				{
-					auto ts = afterEvent->message.getTimeStamp();
+			while (afterEvent != nullptr && afterEvent->event.isNoteOff())
+				afterEvent = tl->getEvent(++indexAfterWrap);
 
-					if (afterWrap.contains(ts))
-					{
-						lastPlayedIndex = indexAfterWrap;
-
-						return &afterEvent->message;
-					}
-				}
+			if (afterEvent != nullptr && afterWrap.contains(afterEvent->timestamp))
+			{
+				lastPlayedIndex = indexAfterWrap;
+				return afterEvent;
 			}
 		}
 		else
 		{
-			if (auto nextEvent = seq->getEventPointer(nextIndex))
+			if (auto nextEvent = tl->getEvent(nextIndex))
 			{
-				if (rangeToLookForTicks.contains(nextEvent->message.getTimeStamp()))
+				if (rangeToLookForTicks.contains(nextEvent->timestamp))
 				{
 					lastPlayedIndex = nextIndex;
-					return &nextEvent->message;
+					return nextEvent;
 				}
 			}
 		}
@@ -321,10 +361,10 @@ juce::MidiMessage* HiseMidiSequence::getNextEvent(Range<double> rangeToLookForTi
 	return nullptr;
 }
 
-juce::MidiMessage* HiseMidiSequence::getMatchingNoteOffForCurrentEvent()
+const HiseMidiSequence::Timeline::Event* HiseMidiSequence::getMatchingNoteOffForCurrentEvent()
 {
-	if (auto noteOff = getReadPointer(currentTrackIndex)->getEventPointer(lastPlayedIndex)->noteOffObject)
-		return &noteOff->message;
+	if (auto tl = timelines.getObjectPointer(currentTrackIndex))
+		return tl->getPairedEvent(lastPlayedIndex);
 
 	return nullptr;
 }
@@ -371,11 +411,11 @@ double HiseMidiSequence::getLengthInSeconds(double bpm)
 
 double HiseMidiSequence::getLastPlayedNotePosition() const
 {
-	if (auto seq = getReadPointer(currentTrackIndex))
+	if (auto tl = timelines.getObjectPointer(currentTrackIndex))
 	{
-		if (auto h = seq->getEventPointer(lastPlayedIndex))
+		if (auto e = tl->getEvent(lastPlayedIndex))
 		{
-			auto lastTimestamp = h->message.getTimeStamp();
+			auto lastTimestamp = e->timestamp;
 
 			auto lengthInTicks = getLengthInQuarters() * TicksPerQuarter;
 
@@ -464,25 +504,31 @@ void HiseMidiSequence::loadFrom(const MidiFile& file)
 
 	
 
+	ReferenceCountedArray<Timeline> newTimelines;
+
 	for (int i = 0; i < normalisedFile.getNumTracks(); i++)
 	{
 		ScopedPointer<MidiMessageSequence> newSequence = new MidiMessageSequence(*normalisedFile.getTrack(i));
+		newTimelines.add(new Timeline(*newSequence));
 		newSequences.add(newSequence.release());
 	}
 
 	{
 		SimpleReadWriteLock::ScopedWriteLock sl(swapLock);
 		newSequences.swapWith(sequences);
+		newTimelines.swapWith(timelines);
 	}
 }
 
 void HiseMidiSequence::createEmptyTrack()
 {
 	ScopedPointer<MidiMessageSequence> newTrack = new MidiMessageSequence();
+	Timeline::Ptr newTimeline = new Timeline(*newTrack);
 
 	{
 		SimpleReadWriteLock::ScopedWriteLock sl(swapLock);
 		sequences.add(newTrack.release());
+		timelines.add(newTimeline);
 		currentTrackIndex = sequences.size() - 1;
 		lastPlayedIndex = -1;
 	}
@@ -539,6 +585,22 @@ juce::MidiMessageSequence* HiseMidiSequence::getWritePointer(int trackIndex)
 	return sequences[trackIndex];
 }
 
+void HiseMidiSequence::rebuildTimeline(int trackIndex)
+{
+	if (trackIndex == -1)
+		trackIndex = currentTrackIndex;
+
+	if (auto seq = sequences[trackIndex])
+	{
+		Timeline::Ptr newTimeline = new Timeline(*seq);
+
+		{
+			SimpleReadWriteLock::ScopedWriteLock sl(swapLock);
+			timelines.set(trackIndex, newTimeline);
+		}
+	}
+}
+
 int HiseMidiSequence::getNumEvents() const
 {
 	if(isPositiveAndBelow(currentTrackIndex, sequences.size()))
@@ -556,12 +618,15 @@ void HiseMidiSequence::setCurrentTrackIndex(int index)
 		SimpleReadWriteLock::ScopedReadLock sl(swapLock);
 
 		if (lastPlayedIndex != -1)
-			lastTimestamp = getReadPointer(currentTrackIndex)->getEventPointer(lastPlayedIndex)->message.getTimeStamp();
+		{
+			if (auto e = timelines.getObjectPointer(currentTrackIndex)->getEvent(lastPlayedIndex))
+				lastTimestamp = e->timestamp;
+		}
 
 		currentTrackIndex = jlimit<int>(0, sequences.size()-1, index);
 
 		if (lastPlayedIndex != -1)
-			lastPlayedIndex = getReadPointer(currentTrackIndex)->getNextIndexAtTime(lastTimestamp);
+			lastPlayedIndex = timelines.getObjectPointer(currentTrackIndex)->getNextIndexAtTime(lastTimestamp);
 	}
 }
 
@@ -570,9 +635,12 @@ void HiseMidiSequence::trimInactiveTracks()
 	SimpleReadWriteLock::ScopedWriteLock sl(swapLock);
 
 	auto seqToKeep = sequences.removeAndReturn(currentTrackIndex);
+	Timeline::Ptr timelineToKeep = timelines[currentTrackIndex];
 
 	sequences.clear(true);
 	sequences.add(seqToKeep);
+	timelines.clear();
+	timelines.add(timelineToKeep);
 	currentTrackIndex = 0;
 	resetPlayback();
 }
@@ -586,11 +654,11 @@ void HiseMidiSequence::setPlaybackPosition(double normalisedPosition)
 {
 	SimpleReadWriteLock::ScopedReadLock sl(swapLock);
 
-	if (auto s = getReadPointer(currentTrackIndex))
+	if (auto tl = timelines.getObjectPointer(currentTrackIndex))
 	{
 		auto currentTimestamp = getLength() * normalisedPosition;
 
-		lastPlayedIndex = s->getNextIndexAtTime(currentTimestamp) - 1;
+		lastPlayedIndex = tl->getNextIndexAtTime(currentTimestamp) - 1;
 	}
 }
 
@@ -603,19 +671,21 @@ juce::RectangleList<float> HiseMidiSequence::getRectangleList(Rectangle<float> t
 
 	RectangleList<float> list;
 
-	if (auto s = getReadPointer(currentTrackIndex))
+	if (auto tl = timelines.getObjectPointer(currentTrackIndex))
 	{
-		for (auto e : *s)
+		for (int i = 0; i < tl->getNumEvents(); i++)
 		{
-			if (e->message.isNoteOn() && e->noteOffObject != nullptr)
+			auto e = tl->getEvent(i);
+
+			if (e->event.isNoteOn() && e->pairIndex != -1)
 			{
-				auto x = (float)(e->message.getTimeStamp() / getLength());
-				auto w = (float)(e->noteOffObject->message.getTimeStamp() / getLength()) - x;
+				auto x = (float)(e->timestamp / getLength());
+				auto w = (float)(tl->getEvent(e->pairIndex)->timestamp / getLength()) - x;
 
 				if (x >= 1.0)
 					break;
 
-				auto y = (float)(127 - e->message.getNoteNumber()) / 128.0f;
+				auto y = (float)(127 - e->event.getNoteNumber()) / 128.0f;
 				auto h = 1.0f / 128.0f;
 
 				list.add({ x, y, w, h });
@@ -638,91 +708,54 @@ Array<HiseEvent> HiseMidiSequence::getEventList(double sampleRate, double bpm, H
 	Array<HiseEvent> newBuffer;
 	newBuffer.ensureStorageAllocated(getNumEvents());
 
-	Range<double> range = { 0.0, getLength() };
-
 	auto samplePerQuarter = (double)TempoSyncer::getTempoInSamples(bpm, sampleRate, TempoSyncer::Quarter);
 
-	int16 currentEventId = 0;
+	auto fToUse = formatToUse != TimestampEditFormat::numTimestampFormats ? formatToUse : timestampFormat;
 
 	SimpleReadWriteLock::ScopedReadLock sl(swapLock);
 
-	if (auto mSeq = getReadPointer())
+	auto length = getLength();
+
+	auto convertTimestamp = [&](HiseEvent& e, double ticks)
 	{
-		for (const auto& ev : *mSeq)
-		{
-			if (ev->message.isNoteOn() && ev->noteOffObject != nullptr)
-			{
-				HiseEvent on = HiseEvent(ev->message);
-				on.setEventId(currentEventId);
+		ticks = jmin(length - 1.0, ticks);
 
-				HiseEvent off = HiseEvent(ev->noteOffObject->message);
-				off.setEventId(currentEventId);
+		if (fToUse == TimestampEditFormat::Samples)
+			e.setTimeStamp((int)(samplePerQuarter * ticks / (double)HiseMidiSequence::TicksPerQuarter));
+		else
+			e.setTimeStamp((int)ticks);
+	};
 
-				currentEventId++;
+	// The timeline is already sorted and has the note offs paired, so we just need to convert the timestamps
+	if (auto tl = timelines.getObjectPointer(currentTrackIndex))
+	{
+		for (int i = 0; i < tl->getNumEvents(); i++)
+		{
+			auto ev = tl->getEvent(i);
 
-				auto onTsTicks = jmin(getLength() - 1.0, ev->message.getTimeStamp());
-				auto offTsTicks = jmin(getLength() - 1.0, ev->noteOffObject->message.getTimeStamp());
+			if ((ev->event.isNoteOn() || ev->event.isNoteOff()) && ev->pairIndex != -1)
+			{
+				auto on = ev->event.isNoteOn() ? ev : tl->getEvent(ev->pairIndex);
+				auto off = ev->event.isNoteOn() ? tl->getEvent(ev->pairIndex) : ev;
 
-				if (onTsTicks == offTsTicks) // note on lies after the end of the sequence
+				// note on lies after the end of the sequence
+				if (jmin(length - 1.0, on->timestamp) == jmin(length - 1.0, off->timestamp))
 					continue;
 
-				auto fToUse = formatToUse != TimestampEditFormat::numTimestampFormats ? formatToUse : timestampFormat;
-
-				if (fToUse == TimestampEditFormat::Samples)
-				{
-					auto onTs = (int)(samplePerQuarter * onTsTicks / (double)HiseMidiSequence::TicksPerQuarter);
-					auto offTs = (int)(samplePerQuarter * offTsTicks / (double)HiseMidiSequence::TicksPerQuarter);
-
-					on.setTimeStamp(onTs);
-					off.setTimeStamp(offTs);
-				}
-				else
-				{
-					on.setTimeStamp(onTsTicks);
-					off.setTimeStamp(offTsTicks);
-				}
-
-				newBuffer.add(on);
-				newBuffer.add(off);
+				HiseEvent e(ev->event);
+				e.setEventId((int16)ev->noteIndex);
+				convertTimestamp(e, ev->timestamp);
+				newBuffer.add(e);
 			}
-			else if (ev->message.isController() || ev->message.isPitchWheel())
+			else if (ev->event.isController() || ev->event.isPitchWheel())
 			{
-				HiseEvent cc(ev->message);
-
-				auto ccTsTicks = jmin(getLength() - 1.0, ev->message.getTimeStamp());
-				
-				auto fToUse = formatToUse != TimestampEditFormat::numTimestampFormats ? formatToUse : timestampFormat;
-
-				if (fToUse == TimestampEditFormat::Samples)
-				{
-					auto onTs = (int)(samplePerQuarter * ccTsTicks / (double)HiseMidiSequence::TicksPerQuarter);
-					cc.setTimeStamp(onTs);
-				}
-				else
-					cc.setTimeStamp(ccTsTicks);
-
+				HiseEvent cc(ev->event);
+				convertTimestamp(cc, ev->timestamp);
 				newBuffer.add(cc);
 			}
 		}
 	}
 
-	struct NoteOnSorter
-	{
-		static int compareElements(const HiseEvent& first, const HiseEvent& second)
-		{
-			auto ft = first.getTimeStamp();
-			auto st = second.getTimeStamp();
-
-			if (ft < st)
-				return -1;
-			else if (ft > st)
-				return 1;
-			else return 0;
-		}
-	} sorter;
-
-	newBuffer.sort(sorter);
-
 	return newBuffer;
 }
 
@@ -730,8 +763,11 @@ Array<HiseEvent> HiseMidiSequence::getEventList(double sampleRate, double bpm, H
 
 void HiseMidiSequence::swapCurrentSequence(MidiMessageSequence* sequenceToSwap)
 {
+	Timeline::Ptr newTimeline = new Timeline(*sequenceToSwap);
+
 	SimpleReadWriteLock::ScopedWriteLock sl(swapLock);
 	sequences.set(currentTrackIndex, sequenceToSwap, true);
+	timelines.set(currentTrackIndex, newTimeline);
 }
 
 
@@ -1471,8 +1507,8 @@ void MidiPlayer::preprocessBuffer(HiseEventBuffer& buffer, int numSamples)
 			else
 				currentRange = { positionInTicks, jmin<double>(lengthInTicks, positionInTicks + tickThisTime) };
 
-			MidiMessage* eventsInThisCallback[16];
-			memset(eventsInThisCallback, 0, sizeof(MidiMessage*) * 16);
+			const HiseMidiSequence::Timeline::Event* eventsInThisCallback[16];
+			memset(eventsInThisCallback, 0, sizeof(eventsInThisCallback));
 
 
 
@@ -1498,7 +1534,7 @@ void MidiPlayer::preprocessBuffer(HiseEventBuffer& buffer, int numSamples)
 				if (found)
 					break;
 
-				auto timeStampInThisBuffer = e->getTimeStamp() - positionInTicks;
+				auto timeStampInThisBuffer = e->timestamp - positionInTicks;
 
 				if (timeStampInThisBuffer < 0.0)
 					timeStampInThisBuffer += getCurrentSequence()->getTimeSignature().normalisedLoopRange.getLength() * lengthInTicks;
@@ -1508,7 +1544,7 @@ void MidiPlayer::preprocessBuffer(HiseEventBuffer& buffer, int numSamples)
 
 				jassert(isPositiveAndBelow(timeStamp, numSamples));
 
-				HiseEvent newEvent(*e);
+				HiseEvent newEvent(e->event);
 
 				newEvent.setTimeStamp(timeStamp);
 				newEvent.setArtificial();
@@ -1549,10 +1585,10 @@ void MidiPlayer::preprocessBuffer(HiseEventBuffer& buffer, int numSamples)
 
 					if (auto noteOff = seq->getMatchingNoteOffForCurrentEvent())
 					{
-						HiseEvent newNoteOff(*noteOff);
+						HiseEvent newNoteOff(noteOff->event);
 						newNoteOff.setArtificial();
 
-						auto noteOffTimeStampInBuffer = noteOff->getTimeStamp() - positionInTicks;
+						auto noteOffTimeStampInBuffer = noteOff->timestamp - positionInTicks;
 
 						if (noteOffTimeStampInBuffer < 0.0)
 							noteOffTimeStampInBuffer += getCurrentSequence()->getTimeSignature().normalisedLoopRange.getLength() * lengthInTicks;
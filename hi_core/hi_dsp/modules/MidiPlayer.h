@@ -101,6 +101,56 @@ public:
 		void restoreFromValueTree(const ValueTree &v) override;
 	};
 
+	/** A flat, tick-sorted copy of a track that is used for playback and seeking.
+
+		It is compiled from the MidiMessageSequence whenever the track changes, so the audio thread
+		walks a contiguous array of HiseEvents and can use a binary search for seeking. The index of
+		each event matches the index of the event in the MidiMessageSequence.
+	*/
+	struct Timeline : public ReferenceCountedObject
+	{
+		using Ptr = ReferenceCountedObjectPtr<Timeline>;
+
+		struct Event
+		{
+			/** The timestamp in ticks. */
+			double timestamp = 0.0;
+
+			HiseEvent event;
+
+			/** The index of the matching note off for note ons (and vice versa), -1 if there is none. */
+			int pairIndex = -1;
+
+			/** The index of the note within the track (used as event ID by getEventList()). */
+			int noteIndex = -1;
+		};
+
+		/** Compiles the timeline from the given sequence. Don't call this on the audio thread. */
+		Timeline(const MidiMessageSequence& seq);
+
+		/** Returns the index of the first event with a timestamp at or after the given tick position. */
+		int getNextIndexAtTime(double ticks) const;
+
+		const Event* getEvent(int index) const
+		{
+			return isPositiveAndBelow(index, events.size()) ? events.begin() + index : nullptr;
+		}
+
+		const Event* getPairedEvent(int index) const
+		{
+			if (auto e = getEvent(index))
+				return getEvent(e->pairIndex);
+
+			return nullptr;
+		}
+
+		int getNumEvents() const noexcept { return events.size(); }
+
+	private:
+
+		Array<Event> events;
+	};
+
 	/** The internal resolution (set to a sensible high default). */
 	static constexpr int TicksPerQuarter = 960;
 
@@ -123,10 +173,10 @@ public:
 	/** Gets the next event of the current track in the given range. This also advances the playback pointer
 		so you should only use it in the audio thread for playback. 
 	*/
-	MidiMessage* getNextEvent(Range<double> rangeToLookForTicks);
+	const Timeline::Event* getNextEvent(Range<double> rangeToLookForTicks);
 
-	/** Returns the MIDI note off message for the current note on message. */
-	MidiMessage* getMatchingNoteOffForCurrentEvent();
+	/** Returns the note off event for the current note on event. */
+	const Timeline::Event* getMatchingNoteOffForCurrentEvent();
 
 	/** Returns the length in ticks (as defined with TicksPerQuarter). */
 	double getLength() const;
@@ -171,10 +221,14 @@ public:
 
 	/** Returns a write pointer to the given track.
 
-	If the argument is omitted, it will return the current track. 
+	If the argument is omitted, it will return the current track. Changes to the sequence will not
+	be picked up by the playback until you call rebuildTimeline().
 	*/
 	juce::MidiMessageSequence* getWritePointer(int trackIndex=-1);
 
+	/** Compiles the playback timeline of the given track (or the current track) from its MidiMessageSequence. */
+	void rebuildTimeline(int trackIndex=-1);
+
 	/** Get the number of events in the current track. */
 	int getNumEvents() const;
 
@@ -228,6 +282,7 @@ private:
 
 	Identifier id;
 	OwnedArray<MidiMessageSequence> sequences;
+	ReferenceCountedArray<Timeline> timelines;
 	int currentTrackIndex = 0;
 	int lastPlayedIndex = -1;
 
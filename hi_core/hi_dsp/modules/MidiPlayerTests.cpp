@@ -0,0 +1,395 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#if HI_RUN_UNIT_TESTS
+
+namespace hise { using namespace juce;
+
+/** Compares the playback, seeking and event list of the compiled timeline with the previous
+	implementation that walked the MidiMessageSequence directly. */
+class MidiSequenceTimelineTest : public UnitTest
+{
+public:
+
+	static constexpr double NumQuarters = 16.0;
+	static constexpr int NumNotes = 200;
+	static constexpr int NumControllers = 50;
+
+	MidiSequenceTimelineTest() :
+		UnitTest("Testing MIDI sequence timeline")
+	{}
+
+	void runTest() override
+	{
+		testEventOrder();
+		testLoopWrap();
+		testSeek();
+		testEventList();
+	}
+
+private:
+
+	/** The playback logic that used the MidiMessageSequence before the timeline was introduced. */
+	struct SequenceReference
+	{
+		SequenceReference(HiseMidiSequence& s_) :
+			s(s_)
+		{}
+
+		MidiMessage* getNextEvent(Range<double> rangeToLookForTicks)
+		{
+			auto nextIndex = lastPlayedIndex + 1;
+
+			if (auto seq = s.getReadPointer())
+			{
+				if (nextIndex >= seq->getNumEvents())
+				{
+					lastPlayedIndex = -1;
+					nextIndex = 0;
+				}
+
+				auto loopRange = s.getTimeSignature().normalisedLoopRange;
+				auto loopEndTicks = s.getLength() * loopRange.getEnd();
+
+				if (rangeToLookForTicks.contains(loopEndTicks))
+				{
+					auto loopStartTicks = s.getLength() * loopRange.getStart();
+					auto rangeEndAfterWrap = rangeToLookForTicks.getEnd() - loopEndTicks + loopStartTicks;
+
+					Range<double> beforeWrap = { rangeToLookForTicks.getStart(), loopEndTicks };
+					Range<double> afterWrap = { loopStartTicks, rangeEndAfterWrap };
+
+					if (auto nextEvent = seq->getEventPointer(nextIndex))
+					{
+						auto ts = nextEvent->message.getTimeStamp();
+
+						if (beforeWrap.contains(ts) || afterWrap.contains(ts))
+						{
+							lastPlayedIndex = nextIndex;
+							return &nextEvent->message;
+						}
+
+						if (ts < loopEndTicks)
+							return nullptr;
+					}
+
+					auto indexAfterWrap = seq->getNextIndexAtTime(loopStartTicks);
+					auto afterEvent = seq->getEventPointer(indexAfterWrap);
+
+					while (afterEvent != nullptr && afterEvent->message.isNoteOff())
+						afterEvent = seq->getEventPointer(++indexAfterWrap);
+
+					if (afterEvent != nullptr && afterWrap.contains(afterEvent->message.getTimeStamp()))
+					{
+						lastPlayedIndex = indexAfterWrap;
+						return &afterEvent->message;
+					}
+				}
+				else if (auto nextEvent = seq->getEventPointer(nextIndex))
+				{
+					if (rangeToLookForTicks.contains(nextEvent->message.getTimeStamp()))
+					{
+						lastPlayedIndex = nextIndex;
+						return &nextEvent->message;
+					}
+				}
+			}
+
+			return nullptr;
+		}
+
+		MidiMessage* getMatchingNoteOffForCurrentEvent()
+		{
+			if (auto noteOff = s.getReadPointer()->getEventPointer(lastPlayedIndex)->noteOffObject)
+				return &noteOff->message;
+
+			return nullptr;
+		}
+
+		void setPlaybackPosition(double normalisedPosition)
+		{
+			lastPlayedIndex = s.getReadPointer()->getNextIndexAtTime(s.getLength() * normalisedPosition) - 1;
+		}
+
+		Array<HiseEvent> getEventList(double samplesPerQuarter, HiseMidiSequence::TimestampEditFormat format)
+		{
+			Array<HiseEvent> list;
+			int16 currentEventId = 0;
+
+			auto convert = [&](HiseEvent& e, double ticks)
+			{
+				ticks = jmin(s.getLength() - 1.0, ticks);
+
+				if (format == HiseMidiSequence::TimestampEditFormat::Samples)
+					e.setTimeStamp((int)(samplesPerQuarter * ticks / (double)HiseMidiSequence::TicksPerQuarter));
+				else
+					e.setTimeStamp((int)ticks);
+			};
+
+			for (const auto& ev : *s.getReadPointer())
+			{
+				if (ev->message.isNoteOn() && ev->noteOffObject != nullptr)
+				{
+					HiseEvent on(ev->message);
+					HiseEvent off(ev->noteOffObject->message);
+
+					on.setEventId(currentEventId);
+					off.setEventId(currentEventId);
+					currentEventId++;
+
+					auto onTicks = ev->message.getTimeStamp();
+					auto offTicks = ev->noteOffObject->message.getTimeStamp();
+
+					if (jmin(s.getLength() - 1.0, onTicks) == jmin(s.getLength() - 1.0, offTicks))
+						continue;
+
+					convert(on, onTicks);
+					convert(off, offTicks);
+
+					list.add(on);
+					list.add(off);
+				}
+				else if (ev->message.isController() || ev->message.isPitchWheel())
+				{
+					HiseEvent cc(ev->message);
+					convert(cc, ev->message.getTimeStamp());
+					list.add(cc);
+				}
+			}
+
+			return list;
+		}
+
+		HiseMidiSequence& s;
+		int lastPlayedIndex = -1;
+	};
+
+	HiseMidiSequence::Ptr createSequence(Random& r)
+	{
+		HiseMidiSequence::Ptr s = new HiseMidiSequence();
+
+		auto seq = new MidiMessageSequence();
+
+		const double length = NumQuarters * (double)HiseMidiSequence::TicksPerQuarter;
+
+		for (int i = 0; i < NumNotes; i++)
+		{
+			// Use a coarse grid so that there are many events with the same timestamp
+			auto start = (double)(r.nextInt((int)(length / 120.0)) * 120);
+			auto end = jmin(length - 1.0, start + 60.0 + (double)r.nextInt(1920));
+			auto noteNumber = 36 + r.nextInt(48);
+
+			seq->addEvent(MidiMessage::noteOn(1, noteNumber, (uint8)(1 + r.nextInt(126))), start);
+			seq->addEvent(MidiMessage::noteOff(1, noteNumber), end);
+		}
+
+		for (int i = 0; i < NumControllers; i++)
+		{
+			auto ts = (double)(r.nextInt((int)(length / 120.0)) * 120);
+			seq->addEvent(MidiMessage::controllerEvent(1, 1 + r.nextInt(64), r.nextInt(128)), ts);
+		}
+
+		seq->updateMatchedPairs();
+
+		s->createEmptyTrack();
+		s->swapCurrentSequence(seq);
+		s->setLengthInQuarters(NumQuarters);
+		s->resetPlayback();
+
+		return s;
+	}
+
+	void expectEventsMatch(const HiseMidiSequence::Timeline::Event* e, const MidiMessage* m)
+	{
+		expect((e != nullptr) == (m != nullptr), "event mismatch");
+
+		if (e != nullptr && m != nullptr)
+		{
+			expectEquals(e->timestamp, m->getTimeStamp(), "timestamp mismatch");
+			expect(e->event == HiseEvent(*m), "wrong event: " + e->event.toDebugString());
+		}
+	}
+
+	/** Plays both implementations with the same block ranges (wrapping around the loop like the MidiPlayer) and returns the number of events. */
+	int comparePlayback(HiseMidiSequence& s, SequenceReference& ref, double startTicks, double ticksPerBlock, int numBlocks)
+	{
+		auto loopRange = s.getTimeSignature().normalisedLoopRange;
+		auto loopStart = loopRange.getStart() * s.getLength();
+		auto loopEnd = loopRange.getEnd() * s.getLength();
+
+		auto position = startTicks;
+		int numEvents = 0;
+
+		for (int b = 0; b < numBlocks; b++)
+		{
+			Range<double> range(position, position + ticksPerBlock);
+
+			// The MidiPlayer handles up to 16 events per block
+			for (int i = 0; i < 16; i++)
+			{
+				auto e = s.getNextEvent(range);
+				auto m = ref.getNextEvent(range);
+
+				expectEventsMatch(e, m);
+
+				if (e == nullptr || m == nullptr)
+					break;
+
+				numEvents++;
+
+				if (e->event.isNoteOn())
+					expectEventsMatch(s.getMatchingNoteOffForCurrentEvent(), ref.getMatchingNoteOffForCurrentEvent());
+			}
+
+			position += ticksPerBlock;
+
+			if (position >= loopEnd)
+				position -= loopEnd - loopStart;
+		}
+
+		return numEvents;
+	}
+
+	void testEventOrder()
+	{
+		beginTest("Testing event order");
+
+		Random r(7);
+		auto s = createSequence(r);
+		SequenceReference ref(*s);
+
+		// Two full passes so that the wrap from the end to the start is included
+		auto numBlocks = roundToInt(2.0 * s->getLength() / 100.0);
+		auto numEvents = comparePlayback(*s, ref, 0.0, 100.0, numBlocks);
+
+		expect(numEvents > 2 * NumNotes, "Not enough events played: " + String(numEvents));
+	}
+
+	void testLoopWrap()
+	{
+		beginTest("Testing loop wrap");
+
+		Random r(13);
+		auto s = createSequence(r);
+		SequenceReference ref(*s);
+
+		auto ts = s->getTimeSignaturePtr();
+		ts->setLoopEnd(0.75);
+		ts->setLoopStart(0.3);
+
+		expectEquals(s->getTimeSignature().normalisedLoopRange.getStart(), 0.3, "loop start not set");
+
+		// An odd block size so that the wrap happens in the middle of a block
+		auto numEvents = comparePlayback(*s, ref, 0.0, 77.0, roundToInt(3.0 * s->getLength() / 77.0));
+
+		expect(numEvents > 0, "no events played");
+	}
+
+	void testSeek()
+	{
+		beginTest("Testing seek");
+
+		Random r(21);
+		auto s = createSequence(r);
+		SequenceReference ref(*s);
+
+		for (int i = 0; i < 50; i++)
+		{
+			// Include the exact position of events
+			auto position = i % 5 == 0 ? (double)(r.nextInt(128) * 120) / s->getLength() : r.nextDouble();
+
+			s->setPlaybackPosition(position);
+			ref.setPlaybackPosition(position);
+
+			auto startTicks = position * s->getLength();
+
+			if (auto e = s->getNextEvent({ startTicks, startTicks + 200.0 }))
+				expect(e->timestamp >= startTicks, "seek returned an earlier event");
+
+			s->setPlaybackPosition(position);
+
+			comparePlayback(*s, ref, startTicks, 200.0, 10);
+		}
+	}
+
+	void testEventList()
+	{
+		beginTest("Testing event list");
+
+		Random r(42);
+		auto s = createSequence(r);
+		SequenceReference ref(*s);
+
+		const double sampleRate = 44100.0;
+		const double bpm = 120.0;
+		auto samplesPerQuarter = (double)TempoSyncer::getTempoInSamples(bpm, sampleRate, TempoSyncer::Quarter);
+
+		for (auto format : { HiseMidiSequence::TimestampEditFormat::Samples, HiseMidiSequence::TimestampEditFormat::Ticks })
+		{
+			auto list = s->getEventList(sampleRate, bpm, format);
+			auto expected = ref.getEventList(samplesPerQuarter, format);
+
+			expectEquals(list.size(), expected.size(), "wrong event amount");
+
+			for (int i = 1; i < list.size(); i++)
+				expect(list[i - 1].getTimeStamp() <= list[i].getTimeStamp(), "event list isn't sorted");
+
+			// The old list was sorted with an unstable sort, so we only compare the content
+			struct Sorter
+			{
+				static int compareElements(const HiseEvent& a, const HiseEvent& b)
+				{
+					auto key = [](const HiseEvent& e)
+					{
+						return std::make_tuple(e.getTimeStamp(), (int)e.getType(), (int)e.getEventId(), e.getNoteNumber(), (int)e.getVelocity());
+					};
+
+					if (key(a) < key(b)) return -1;
+					if (key(b) < key(a)) return 1;
+					return 0;
+				}
+			} sorter;
+
+			list.sort(sorter);
+			expected.sort(sorter);
+
+			for (int i = 0; i < jmin(list.size(), expected.size()); i++)
+				expect(list[i] == expected[i], "event mismatch at " + String(i));
+		}
+	}
+};
+
+static MidiSequenceTimelineTest midiSequenceTimelineTest;
+
+}
+
+#endif
@@ -1035,6 +1035,10 @@ void MidiProcessorChain::sendAllNoteOffEvent()
 
 void MidiProcessorChain::processHiseEvent(HiseEvent& m)
 {
+	// Host automation is applied by the sound generator
+	if (m.isParameterChange())
+		return;
+
 	if (isBypassed())
 	{
 		if (m.isTimerEvent()) m.ignoreEvent(true);
@@ -370,8 +370,11 @@ ModulatorChain::ModChainWithBuffer::ModChainWithBuffer(ConstructionData data) :
 		data.m,
 		data.parent)),
 	type(data.t),
-	currentMonophonicRampValue(c->getInitialValue())
+	currentMonophonicRampValue(c->getInitialValue()),
+	profileAccumulator(CpuProfiler::Category::ModulatorChain)
 {
+	profileAccumulator.processor = c.get();
+
 	FloatVectorOperations::fill(currentConstantVoiceValues, c->getInitialValue(), NUM_POLYPHONIC_VOICES);
 	FloatVectorOperations::fill(currentRampValues, c->getInitialValue(), NUM_POLYPHONIC_VOICES);
 
@@ -275,6 +275,9 @@ public:
 
 		void setScratchBufferFunction(const std::function<void(int, Modulator* m, float*, int, int)>& f);
 
+		/** Sums up the time of all voices so that the profiler gets one record per block. */
+		CpuProfiler::Accumulator& getProfileAccumulator() noexcept { return profileAccumulator; }
+
 	private:
 
 		std::function<void(int, Modulator* m, float*, int, int)> scratchBufferFunction;
@@ -310,6 +313,8 @@ public:
 		float currentMonophonicRampValue;
 		float const* currentVoiceData = nullptr;
 
+		CpuProfiler::Accumulator profileAccumulator;
+
 		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModChainWithBuffer);
 	};
 
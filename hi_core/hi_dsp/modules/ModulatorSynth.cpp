@@ -531,6 +531,8 @@ void ModulatorSynth::renderNextBlockWithModulators(AudioSampleBuffer& outputBuff
 	jassert(isOnAir());
 
     ADD_GLITCH_DETECTOR(this, DebugLogger::Location::SynthRendering);
+
+	CpuProfiler::ScopedMeasurement sm(getMainController()->getCpuProfiler(), this, CpuProfiler::Category::Synth);
     
 	int numSamples = outputBuffer.getNumSamples();
 
@@ -619,8 +621,13 @@ void ModulatorSynth::renderNextBlockWithModulators(AudioSampleBuffer& outputBuff
 
 void ModulatorSynth::preVoiceRendering(int startSample, int numThisTime)
 {
+	auto& profiler = getMainController()->getCpuProfiler();
+
 	for (auto& mb : modChains)
+	{
+		CpuProfiler::ScopedAccumulation sa(profiler, mb.getProfileAccumulator());
 		mb.calculateMonophonicModulationValues(startSample, numThisTime);
+	}
 
 	effectChain->preRenderCallback(startSample, numThisTime);
 }
@@ -647,9 +654,12 @@ void ModulatorSynth::renderVoice(int startSample, int numThisTime)
 void ModulatorSynth::calculateModulationValuesForVoice(ModulatorSynthVoice * v, int startSample, int numThisTime)
 {
 	auto index = v->getVoiceIndex();
+	auto& profiler = getMainController()->getCpuProfiler();
 
 	for (auto& mb : modChains)
 	{
+		CpuProfiler::ScopedAccumulation sa(profiler, mb.getProfileAccumulator());
+
 		mb.calculateModulationValuesForCurrentVoice(index, startSample, numThisTime);
 		if (mb.isAudioRateModulation())
 			mb.expandVoiceValuesToAudioRate(index, startSample, numThisTime);
@@ -740,6 +750,12 @@ void ModulatorSynth::setPeakValues(float l, float r)
 
 void ModulatorSynth::handleHiseEvent(const HiseEvent& m)
 {
+	if (m.isParameterChange())
+	{
+		getMainController()->getHostAutomationLane().applyEvent(m, this);
+		return;
+	}
+
 	auto c = m;
 
 	if (getMainController()->getKillStateHandler().voiceStartIsDisabled())
@@ -258,6 +258,8 @@ void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffe
 
 	ADD_GLITCH_DETECTOR(this, DebugLogger::Location::SynthChainRendering);
 
+	CpuProfiler::ScopedMeasurement sm(getMainController()->getCpuProfiler(), this, CpuProfiler::Category::Synth);
+
     auto isRoot = getMainController()->getMainSynthChain() == this;
     
 	if (isRoot && !activeChannels.areAllChannelsEnabled())
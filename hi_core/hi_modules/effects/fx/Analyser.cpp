@@ -138,6 +138,9 @@ Component* AudioAnalyserComponent::Panel::createContentComponent(int index)
 	if (findPanelColour(FloatingTileContent::PanelColourId::bgColour).isOpaque())
 		c->setOpaque(true);
 
+	if (auto rc = dynamic_cast<RingBufferComponentBase*>(c))
+		rc->setUseBackgroundAnalysis(useBackgroundAnalysis);
+
 	return c;
 }
 
@@ -148,6 +151,52 @@ void AudioAnalyserComponent::Panel::fillIndexList(StringArray& indexList)
 	indexList.add("Spectral Analyser");
 }
 
+int AudioAnalyserComponent::Panel::getNumDefaultableProperties() const
+{
+	return (int)SpecialPanelIds::numSpecialPanelIds;
+}
+
+Identifier AudioAnalyserComponent::Panel::getDefaultablePropertyId(int index) const
+{
+	if (isPositiveAndBelow(index, PanelWithProcessorConnection::SpecialPanelIds::numSpecialPanelIds))
+		return PanelWithProcessorConnection::getDefaultablePropertyId(index);
+
+	RETURN_DEFAULT_PROPERTY_ID(index, SpecialPanelIds::BackgroundAnalysis, "BackgroundAnalysis");
+
+	jassertfalse;
+	return {};
+}
+
+var AudioAnalyserComponent::Panel::getDefaultProperty(int index) const
+{
+	if (isPositiveAndBelow(index, PanelWithProcessorConnection::SpecialPanelIds::numSpecialPanelIds))
+		return PanelWithProcessorConnection::getDefaultProperty(index);
+
+	RETURN_DEFAULT_PROPERTY(index, SpecialPanelIds::BackgroundAnalysis, var((bool)HISE_USE_BACKGROUND_ANALYSIS));
+
+	jassertfalse;
+	return {};
+}
+
+void AudioAnalyserComponent::Panel::fromDynamicObject(const var& object)
+{
+	PanelWithProcessorConnection::fromDynamicObject(object);
+
+	useBackgroundAnalysis = (bool)getPropertyWithDefault(object, (int)SpecialPanelIds::BackgroundAnalysis);
+
+	if (auto rc = getContent<RingBufferComponentBase>())
+		rc->setUseBackgroundAnalysis(useBackgroundAnalysis);
+}
+
+var AudioAnalyserComponent::Panel::toDynamicObject() const
+{
+	auto obj = PanelWithProcessorConnection::toDynamicObject();
+
+	storePropertyInObject(obj, (int)SpecialPanelIds::BackgroundAnalysis, useBackgroundAnalysis);
+
+	return obj;
+}
+
 
 
 }
@@ -209,6 +209,12 @@ public:
 	{
 	public:
 
+		enum SpecialPanelIds
+		{
+			BackgroundAnalysis = (int)PanelWithProcessorConnection::SpecialPanelIds::numSpecialPanelIds,
+			numSpecialPanelIds
+		};
+
 		Panel(FloatingTile* parent) :
 			PanelWithProcessorConnection(parent)
 		{
@@ -234,6 +240,20 @@ public:
 		bool hasSubIndex() const override { return true; }
 
 		void fillIndexList(StringArray& indexList) override;
+
+		int getNumDefaultableProperties() const override;
+
+		Identifier getDefaultablePropertyId(int index) const override;
+
+		var getDefaultProperty(int index) const override;
+
+		void fromDynamicObject(const var& object) override;
+
+		var toDynamicObject() const override;
+
+	private:
+
+		bool useBackgroundAnalysis = HISE_USE_BACKGROUND_ANALYSIS;
 	};
 
 protected:
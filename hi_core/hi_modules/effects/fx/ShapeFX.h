@@ -86,7 +86,7 @@ class ShapeFX : public MasterEffectProcessor,
 {
 public:
 
-	using Oversampler = juce::dsp::Oversampling<float>;
+	using Oversampler = PolyphaseOversampler;
     
 	using ShapeFunction = std::function<float(float)>;
 
@@ -476,7 +476,7 @@ private:
 	StringArray shapeNames;
 
 	OwnedArray<ShapeFX::ShaperBase> shapers;
-	OwnedArray<ShapeFX::Oversampler> oversamplers;
+	ScopedPointer<ShapeFX::Oversampler> oversampler;
 	float drive = 1.0f;
 
 	LinearSmoothedValue<float> driveSmoothers[NUM_POLYPHONIC_VOICES];
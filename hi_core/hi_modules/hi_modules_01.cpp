@@ -17,6 +17,7 @@
 #include "modulators/mods/SimpleEnvelope.cpp"
 #include "modulators/mods/KeyModulator.cpp"
 #include "modulators/mods/AhdsrEnvelope.cpp"
+#include "modulators/mods/AhdsrEnvelopeTests.cpp"
 #include "modulators/mods/EventDataModulator.cpp"
 #include "modulators/mods/PitchWheelModulator.cpp"
 #include "modulators/mods/TableEnvelope.cpp"
@@ -114,6 +115,7 @@
 #include "synthesisers/synths/WavetableTools.cpp"
 #include "synthesisers/editors/WavetableComponents.cpp"
 #include "synthesisers/synths/WavetableSynth.cpp"
+#include "synthesisers/synths/WavetableSynthTests.cpp"
 #include "synthesisers/synths/AudioLooper.cpp"
 #include "synthesisers/synths/HardcodedNetworkSynth.cpp"
 
@@ -272,14 +272,7 @@ void AhdsrEnvelope::calculateBlock(int startSample, int numSamples)
 	}
 	else
 	{
-		while (numSamples > 0)
-		{
-			internalBuffer.setSample(0, startSample, calculateNewValue(voiceIndex));
-			++startSample;
-			numSamples--;
-		}
-
-		
+		state->tickBlock(internalBuffer.getWritePointer(0, startSample), numSamples);
 	}
 
 	const bool isActiveVoice = polyManager.getCurrentVoice() == polyManager.getLastStartedVoice();
@@ -0,0 +1,206 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#if HI_RUN_UNIT_TESTS
+
+namespace hise { using namespace juce;
+
+/** Checks the block calculation of the AHDSR envelope against the per sample calculation and reports the envelopes per core. */
+class AhdsrEnvelopeTest : public UnitTest
+{
+public:
+
+	using Base = scriptnode::envelope::pimpl::ahdsr_base;
+	using State = Base::state_base;
+
+	static constexpr int NumVoices = 256;
+	static constexpr int NumParameterSets = 500;
+	static constexpr double ControlRate = 44100.0 / (double)HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
+
+	AhdsrEnvelopeTest() :
+		UnitTest("Testing AHDSR block calculation", "Benchmark")
+	{}
+
+	void runTest() override
+	{
+		testRandomParameters();
+		testEnvelopesPerCore(true);
+		testEnvelopesPerCore(false);
+	}
+
+private:
+
+	static void startState(State& s, const Base& envelope, const float* modValues)
+	{
+		s.envelope = &envelope;
+
+		for (int i = 0; i < Base::numInternalChains; i++)
+			s.modValues[i] = modValues[i];
+
+		s.attackLevel = envelope.attackLevel * s.modValues[Base::AttackLevelChain];
+		s.setAttackRate(envelope.attack);
+		s.setDecayRate(envelope.decay);
+		s.setReleaseRate(envelope.release);
+
+		s.current_state = State::ATTACK;
+		s.current_value = 0.0f;
+		s.lastSustainValue = envelope.sustain * s.modValues[Base::SustainLevelChain];
+	}
+
+	void testRandomParameters()
+	{
+		beginTest("Testing " + String(NumParameterSets) + " random parameter sets");
+
+		Random r(42);
+		float maxError = 0.0f;
+
+		for (int p = 0; p < NumParameterSets; p++)
+		{
+			Base envelope;
+			envelope.setBaseSampleRate(ControlRate);
+			envelope.setAttackCurve(r.nextFloat());
+			envelope.setDecayCurve(r.nextFloat());
+			envelope.setSustainLevel(r.nextFloat() < 0.2f ? 0.0f : r.nextFloat());
+			envelope.setAttackRate(r.nextFloat() < 0.1f ? 0.0f : r.nextFloat() * 500.0f);
+			envelope.setHoldTime(r.nextFloat() * 100.0f);
+			envelope.setDecayRate(r.nextFloat() * 1000.0f);
+			envelope.setReleaseRate(r.nextFloat() * 1000.0f);
+			envelope.attackLevel = 0.3f + 0.7f * r.nextFloat();
+
+			float modValues[Base::numInternalChains];
+
+			for (auto& m : modValues)
+				m = r.nextBool() ? 1.0f : 0.2f + 0.8f * r.nextFloat();
+
+			State perSample, block;
+			startState(perSample, envelope, modValues);
+			startState(block, envelope, modValues);
+
+			const int blockSize = 1 + r.nextInt(64);
+			const int releaseBlock = r.nextInt(60);
+
+			HeapBlock<float> a, b;
+			a.calloc(blockSize);
+			b.calloc(blockSize);
+
+			for (int i = 0; i < 200; i++)
+			{
+				if (i == releaseBlock)
+				{
+					perSample.current_state = State::RELEASE;
+					block.current_state = State::RELEASE;
+				}
+
+				for (int s = 0; s < blockSize; s++)
+					a[s] = perSample.tick();
+
+				block.tickBlock(b, blockSize);
+
+				for (int s = 0; s < blockSize; s++)
+					maxError = jmax(maxError, std::abs(a[s] - b[s]));
+
+				expect(perSample.current_state == block.current_state, "state mismatch");
+			}
+		}
+
+		expect(maxError < 1e-6f, "Error: " + String(maxError));
+	}
+
+	void testEnvelopesPerCore(bool useBlockCalculation)
+	{
+		beginTest("Measuring envelopes per core " + String(useBlockCalculation ? "(block)" : "(per sample)"));
+
+		const int blockSize = 512 / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
+		const int releaseBlock = VoiceBenchmark::getNumBlocks(ControlRate, blockSize, 1.0);
+
+		Base envelope;
+		envelope.setBaseSampleRate(ControlRate);
+		envelope.setAttackRate(50.0f);
+		envelope.setHoldTime(10.0f);
+		envelope.setDecayRate(300.0f);
+		envelope.setSustainLevel(0.5f);
+		envelope.setReleaseRate(400.0f);
+
+		const float modValues[Base::numInternalChains] = { 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+
+		std::vector<State> states(NumVoices);
+
+		for (auto& s : states)
+			startState(s, envelope, modValues);
+
+		HeapBlock<float> data;
+		data.calloc(blockSize);
+
+		float maxSustainError = 0.0f;
+
+		auto envelopesPerCore = VoiceBenchmark::measureVoicesPerCore(NumVoices, ControlRate, blockSize, 2.0, [&](int b)
+		{
+			// release all voices after one second
+			if (b == releaseBlock)
+			{
+				for (auto& s : states)
+				{
+					maxSustainError = jmax(maxSustainError, std::abs(s.current_value - envelope.sustain));
+					s.current_state = State::RELEASE;
+				}
+			}
+
+			for (auto& s : states)
+			{
+				if (useBlockCalculation)
+					s.tickBlock(data, blockSize);
+				else
+				{
+					for (int i = 0; i < blockSize; i++)
+						data[i] = s.tick();
+				}
+			}
+		});
+
+		logMessage("Envelopes per core: " + String(envelopesPerCore, 1));
+
+		expect(maxSustainError < 0.01f, "sustain level not reached: " + String(maxSustainError));
+
+		// The release time is 400ms, so every envelope must have finished after another second
+		for (auto& s : states)
+		{
+			expect(s.current_state == State::IDLE, "envelope still active");
+			expectEquals(s.current_value, 0.0f, "envelope not silent");
+		}
+	}
+};
+
+static AhdsrEnvelopeTest ahdsrEnvelopeTest;
+
+}
+
+#endif
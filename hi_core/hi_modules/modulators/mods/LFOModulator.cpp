@@ -543,6 +543,48 @@ float LfoModulator::calculateNewValue ()
 	return currentValue;
 }
 
+bool LfoModulator::calculateTableBlock(float* data, int numSamples)
+{
+	if (numSamples == 0 || currentWaveform == Waveform::Random || currentWaveform == Waveform::Steps || currentTable == nullptr)
+		return false;
+
+	if (!loopEnabled && currentWaveform == Custom)
+		return false;
+
+	// the attack phase must be finished and stay at 1.0
+	if (attackValue != 1.0f || (attack != 0.0f && attackBase + attackCoef < 1.0f))
+		return false;
+
+	const auto m = getMode();
+	const bool invert = m == Modulation::GainMode || (m == Modulation::GlobalMode && !isBipolar());
+
+	for (int i = 0; i < numSamples; i++)
+	{
+		const int index = (int)uptime;
+
+		const int firstIndex = index & (SAMPLE_LOOKUP_TABLE_SIZE - 1);
+		const int nextIndex = (index + 1) & (SAMPLE_LOOKUP_TABLE_SIZE - 1);
+
+		const float alpha = float(uptime) - (float)index;
+		const float invAlpha = 1.0f - alpha;
+
+		const float newValue = 1.0f - (invAlpha * currentTable[firstIndex] + alpha * currentTable[nextIndex]);
+
+		data[i] = invert ? 1.0f - newValue : newValue;
+
+		uptime += angleDelta;
+	}
+
+	constexpr double ratio = 1.0 / (double)(SAMPLE_LOOKUP_TABLE_SIZE);
+	lastCycleIndex = (int)floor(uptime * ratio);
+
+	smoother.smoothBuffer(data, numSamples);
+
+	currentValue = data[numSamples - 1];
+
+	return true;
+}
+
 void LfoModulator::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
 	Processor::prepareToPlay(sampleRate, samplesPerBlock);
@@ -609,9 +651,12 @@ void LfoModulator::calculateBlock(int startSample, int numSamples)
 	}
 #endif
 
-	while (--numSamples >= 0)
+	if (!calculateTableBlock(modData, numSamples))
 	{
-		*modData++ = calculateNewValue();
+		while (--numSamples >= 0)
+		{
+			*modData++ = calculateNewValue();
+		}
 	}
 
 	const float newInputValue = ((int)(uptime) % SAMPLE_LOOKUP_TABLE_SIZE) / (float)SAMPLE_LOOKUP_TABLE_SIZE;
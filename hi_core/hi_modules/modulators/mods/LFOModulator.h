@@ -201,6 +201,11 @@ private:
 	*/
 	float calculateNewValue ();
 
+	/** Calculates the block without evaluating the waveform type and attack phase for each sample.
+	*	Returns false if the LFO uses a waveform or state that needs the per sample calculation.
+	*/
+	bool calculateTableBlock(float* data, int numSamples);
+
 	void setCurrentWaveform() 
 	{
 		switch(currentWaveform)
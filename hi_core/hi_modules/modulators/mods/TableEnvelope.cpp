@@ -199,10 +199,18 @@ void TableEnvelope::calculateBlock(int startSample, int numSamples)
 
 	auto state = static_cast<TableEnvelopeState*>(isMonophonic ? monophonicState.get() : states[voiceIndex]);
 
-	while (--numSamples >= 0)
+	if (state->current_state == TableEnvelopeState::SUSTAIN || state->current_state == TableEnvelopeState::IDLE)
 	{
-		internalBuffer.setSample(0, startSample, calculateNewValue(voiceIndex));
-		++startSample;
+		// the value doesn't change in these states
+		FloatVectorOperations::fill(internalBuffer.getWritePointer(0, startSample), state->current_value, numSamples);
+	}
+	else
+	{
+		while (--numSamples >= 0)
+		{
+			internalBuffer.setSample(0, startSample, calculateNewValue(voiceIndex));
+			++startSample;
+		}
 	}
 
 	if (polyManager.getLastStartedVoice() == voiceIndex && uiUpdater.shouldUpdate())
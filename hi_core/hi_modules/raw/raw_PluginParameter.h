@@ -41,7 +41,8 @@ namespace raw {
 /** A connection to processor attributes as plugin parameter. */
 template <class FunctionType> class PluginParameter : public AudioProcessorParameterWithID,
 													  public Data<float>,
-													  public ControlledObject
+													  public ControlledObject,
+													  public HostAutomationLane::Target
 {
 public:
 
@@ -52,7 +53,8 @@ public:
 	PluginParameter(MainController* mc, const String& name) :
 		AudioProcessorParameterWithID(name, name),
 		ControlledObject(mc),
-		Data(name)
+		Data(name),
+		Target(mc->getHostAutomationLane())
 	{}
 
 	void setup(int t, const String& processorId, NormalisableRange<float> range, float midPoint)
@@ -76,6 +78,9 @@ public:
 
 		if (enableUpdate)
 		{
+			// This is false if the value comes from setParameterNotifyingHost()
+			const bool isHostAutomation = *enableUpdate;
+
 			ScopedValueSetter<bool> setter(*enableUpdate, false, true);
 
 			const float convertedValue = parameterRange.convertFrom0to1(newValue);
@@ -86,11 +91,25 @@ public:
 				lastValue = snappedValue;
 				lastValueInitialised = true;
 
-				FunctionType::load(p.get(), snappedValue);
+				if (isHostAutomation)
+					setHostAutomationValue(snappedValue);
+				else
+					FunctionType::load(p.get(), snappedValue);
 			}
 		}
 	}
 
+	void applyHostAutomation(float value) override
+	{
+		ScopedValueSetter<bool> setter(getMainController()->getPluginParameterUpdateState(), false, true);
+		FunctionType::load(p.get(), value);
+	}
+
+	const Processor* getHostAutomationOwner() const override
+	{
+		return HostAutomationLane::getOwnerSynth(p.get());
+	}
+
 	float getDefaultValue() const override
 	{
 		return 0.0f;
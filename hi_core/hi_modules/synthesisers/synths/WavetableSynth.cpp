@@ -66,6 +66,14 @@ WavetableSynth::WavetableSynth(MainController *mc, const String &id, int numVoic
 	tableIndexBipolarChain->setColour(Colour(0xff4D54B3));
 }
 
+WavetableSynth::~WavetableSynth()
+{
+	clearSounds();
+	currentBank = nullptr;
+
+	bankCache->removeUnusedBanks();
+}
+
 void WavetableSynth::getWaveformTableValues(int /*displayIndex*/, float const** tableValues, int& numValues, float& normalizeValue)
 {
 	WavetableSynthVoice *wavetableVoice = dynamic_cast<WavetableSynthVoice*>(getLastStartedVoice());
@@ -104,6 +112,37 @@ float WavetableSynth::getTotalTableModValue(int offset)
 	return mv * (1.0f - reversed) + (1.0f - mv) * reversed;
 }
 
+bool WavetableSynth::getTotalTableModValues(float* data, int startSample, int numSamples)
+{
+	auto& gainChain = modChains[ChainIndex::TableIndex];
+	auto& bipolarChain = modChains[ChainIndex::TableIndexBipolar];
+
+	const float bipolarGain = (float)bipolarChain.getChain()->shouldBeProcessedAtAll();
+
+	bool isConstant = true;
+
+	for (int i = 0; i < numSamples;)
+	{
+		// the modulation values are calculated with the control rate, so we fetch them once per raster step
+		const int offset = (startSample + i) / HISE_EVENT_RASTER;
+		const int numThisTime = jmin(numSamples - i, (offset + 1) * HISE_EVENT_RASTER - (startSample + i));
+
+		const float gainMod = gainChain.getModValueForVoiceWithOffset(offset);
+		const float bipolarMod = bipolarChain.getModValueForVoiceWithOffset(offset) * bipolarGain;
+
+		for (int k = i; k < i + numThisTime; k++)
+		{
+			auto mv = jlimit<float>(0.0f, 1.0f, (tableIndexKnobValue.advance() + bipolarMod) * gainMod);
+			data[k] = mv * (1.0f - reversed) + (1.0f - mv) * reversed;
+			isConstant &= (data[k] == data[0]);
+		}
+
+		i += numThisTime;
+	}
+
+	return isConstant;
+}
+
 ProcessorEditorBody* WavetableSynth::createEditor(ProcessorEditor *parentEditor)
 {
 #if USE_BACKEND
@@ -183,19 +222,39 @@ juce::StringArray WavetableSynth::getWavetableList() const
 	return sa;
 }
 
-void WavetableSynth::loadWavetableInternal()
+String WavetableSynth::getBankId(int index) const
 {
-	if (currentBankIndex == 0)
+	auto f = getWavetableMonolith();
+
+	Array<File> files;
+
+	if (f.existsAsFile())
+		files.add(f);
+	else
 	{
-		clearSounds();
+		f = getMainController()->getCurrentFileHandler().getSubDirectory(ProjectHandler::SubDirectories::AudioFiles);
+		f.findChildFiles(files, File::findFiles, true, "*.hwt");
+		files.sort();
 	}
 
+	// The folder's modification time doesn't change when a file inside is overwritten,
+	// so we hash the name, size and modification time of every file that might be loaded.
+	String fingerprint;
+
+	for (const auto& wf : files)
+		fingerprint << wf.getFullPathName() << "|" << String(wf.getSize()) << "|" << String(wf.getLastModificationTime().toMilliseconds()) << ";";
+
+	String id;
+	id << f.getFullPathName() << "@" << String::toHexString(fingerprint.hashCode64()) << ":" << String(index);
+	return id;
+}
+
+WavetableBankCache::LoadFunction WavetableSynth::createBankLoadFunction(int index) const
+{
 	auto monolithFile = getWavetableMonolith();
 
 	if (monolithFile.existsAsFile())
 	{
-		FileInputStream fis(monolithFile);
-
 #if USE_BACKEND
 		auto projectName = GET_HISE_SETTING(this, HiseSettings::Project::Name).toString();
 		auto encryptionKey = GET_HISE_SETTING(this, HiseSettings::Project::EncryptionKey).toString();
@@ -204,61 +263,85 @@ void WavetableSynth::loadWavetableInternal()
 		auto projectName = FrontendHandler::getProjectName();
 #endif
 
-		auto headers = WavetableMonolithHeader::readHeader(fis, projectName, encryptionKey);
+		return [monolithFile, projectName, encryptionKey, index]()
+		{
+			FileInputStream fis(monolithFile);
 
-		auto dataSize = fis.readInt64();
+			auto headers = WavetableMonolithHeader::readHeader(fis, projectName, encryptionKey);
 
-		auto headerOffset = fis.getPosition();
+			auto dataSize = fis.readInt64();
 
-        ignoreUnused(dataSize);
-		
+			auto headerOffset = fis.getPosition();
 
-		auto itemToLoad = headers[currentBankIndex - 1];
+			ignoreUnused(dataSize);
 
-		if (itemToLoad.name.isEmpty())
-		{
-			clearSounds();
-			return;
-		}
+			auto itemToLoad = headers[index - 1];
 
-		auto seekPosition = itemToLoad.offset + headerOffset;
+			if (itemToLoad.name.isNotEmpty() && fis.setPosition(itemToLoad.offset + headerOffset))
+				return ValueTree::readFromStream(fis);
 
-		if (fis.setPosition(seekPosition))
+			return ValueTree();
+		};
+	}
+	else
+	{
+		auto dir = getMainController()->getCurrentFileHandler().getSubDirectory(ProjectHandler::SubDirectories::AudioFiles);
+
+		return [dir, index]()
 		{
-			auto v = ValueTree::readFromStream(fis);
+			Array<File> wavetables;
 
-			if (v.isValid())
+			dir.findChildFiles(wavetables, File::findFiles, true, "*.hwt");
+			wavetables.sort();
+
+			if (wavetables[index - 1].existsAsFile())
 			{
-				loadWaveTable(v);
-				return;
+				FileInputStream fis(wavetables[index - 1]);
+				return ValueTree::readFromStream(fis);
 			}
-		}
 
-		clearSounds();
-		return;
+			return ValueTree();
+		};
 	}
-	else
-	{
-		auto dir = getMainController()->getCurrentFileHandler().getSubDirectory(ProjectHandler::SubDirectories::AudioFiles);
+}
 
-		Array<File> wavetables;
+void WavetableSynth::setBank(WavetableBankCache::Bank::Ptr newBank, int index)
+{
+	// Another bank was requested while this one was loading
+	if (index != currentBankIndex)
+		return;
 
-		dir.findChildFiles(wavetables, File::findFiles, true, "*.hwt");
-		wavetables.sort();
+	ReferenceCountedArray<SynthesiserSound> oldSounds;
+	auto oldBank = currentBank;
 
-		if (wavetables[currentBankIndex - 1].existsAsFile())
-		{
-			FileInputStream fis(wavetables[currentBankIndex - 1]);
+	{
+		ScopedLock sl(getMainController()->getLock());
 
-			ValueTree v = ValueTree::readFromStream(fis);
+		for (int i = 0; i < getNumSounds(); i++)
+			oldSounds.add(getSound(i));
 
-			loadWaveTable(v);
-		}
-		else
+		clearSounds();
+
+		if (newBank != nullptr)
 		{
-			clearSounds();
+			for (auto s : newBank->sounds)
+				addSound(s);
+
+			reversed = newBank->reversed;
 		}
+
+		currentBank = newBank;
+
+		// The voices keep playing with the sound from the new bank
+		for (int i = 0; i < getNumVoices(); i++)
+			static_cast<WavetableSynthVoice*>(getVoice(i))->refreshSoundAfterBankChange();
 	}
+
+	// Release the old sounds outside the audio lock
+	oldSounds.clear();
+	oldBank = nullptr;
+
+	bankCache->removeUnusedBanks();
 }
 
 void WavetableSynth::loadWavetableFromIndex(int index)
@@ -267,17 +350,36 @@ void WavetableSynth::loadWavetableFromIndex(int index)
 	{
 		currentBankIndex = index;
 
-		getMainController()->getKillStateHandler().killVoicesAndCall(this, [](Processor* p)
+		auto f = [index](Processor* p)
 		{
-			auto ws = static_cast<WavetableSynth*>(p);
+			static_cast<WavetableSynth*>(p)->loadBankOnLoadingThread(index);
+			return SafeFunctionCall::OK;
+		};
 
-			ws->loadWavetableInternal();
+		// This might be called on the audio thread, so the file lookup and the cache query are
+		// deferred to the loading thread. The voices keep playing the old bank until the new one is ready.
+		if (getMainController()->getKillStateHandler().getCurrentThread() == MainController::KillStateHandler::TargetThread::SampleLoadingThread)
+			f(this);
+		else
+			getMainController()->getSampleManager().addDeferredFunction(this, f);
+	}
+}
 
-			return SafeFunctionCall::OK;
-		}, MainController::KillStateHandler::TargetThread::SampleLoadingThread);
+void WavetableSynth::loadBankOnLoadingThread(int index)
+{
+	// Another bank was requested before this one was picked up
+	if (index != currentBankIndex)
+		return;
+
+	WavetableBankCache::Bank::Ptr b;
+
+	if (index > 0)
+	{
+		auto sampleRate = getSampleRate() > 0.0 ? getSampleRate() : 44100.0;
+		b = bankCache->loadBank(getBankId(index), sampleRate, createBankLoadFunction(index));
 	}
-	
-	
+
+	setBank(b, index);
 }
 
 float WavetableSynth::getDisplayTableValue() const
@@ -354,19 +456,28 @@ void WavetableSynthVoice::calculateBlock(int startSample, int numSamples)
 	const int samplesToCopy = numSamples;
 
 	const float *voicePitchValues = getOwnerSynth()->getPitchValuesForVoice();
+
+	if (refreshMipmap)
+	{
+		auto pf = voicePitchValues != nullptr ? voicePitchValues[startIndex + samplesToCopy / 2] : (uptimeDelta / startUptimeDelta);
+
+		// The mipmap only depends on the pitch factor, so we can skip the search if it hasn't changed
+		if (pf != lastMipmapPitchFactor)
+		{
+			lastMipmapPitchFactor = pf;
+			updateSoundFromPitchFactor(pf, nullptr);
+		}
+	}
 	
 	auto stereoMode = currentSound->isStereo();
 	auto owner = static_cast<WavetableSynth*>(getOwnerSynth());
 	
 	WavetableSound::RenderData r(voiceBuffer, startSample, numSamples, uptimeDelta, voicePitchValues, hqMode);
 
-	r.render(currentSound, voiceUptime, [owner](int startSample) { return owner->getTotalTableModValue(startSample); });
-
-	if (refreshMipmap)
+	r.renderBlock(currentSound, voiceUptime, [owner](float* data, int startSample, int numSamples)
 	{
-		auto pf = voicePitchValues != nullptr ? voicePitchValues[startIndex + samplesToCopy / 2] : (uptimeDelta / startUptimeDelta);
-		updateSoundFromPitchFactor(pf, nullptr);
-	}
+		return owner->getTotalTableModValues(data, startSample, numSamples);
+	});
 
 	if (auto modValues = getOwnerSynth()->getVoiceGainValues())
 	{
@@ -402,6 +513,40 @@ void WavetableSynthVoice::calculateBlock(int startSample, int numSamples)
 		
 }
 
+void WavetableSynthVoice::refreshSoundAfterBankChange()
+{
+	if (isInactive())
+	{
+		currentSound = nullptr;
+		return;
+	}
+
+	auto owner = getOwnerSynth();
+
+	WavetableSound* newSound = nullptr;
+
+	for (int i = 0; i < owner->getNumSounds(); i++)
+	{
+		auto ws = static_cast<WavetableSound*>(owner->getSound(i));
+
+		if (ws->appliesToNote(noteNumberAtStart))
+		{
+			newSound = ws;
+			break;
+		}
+	}
+
+	if (newSound == nullptr)
+	{
+		resetVoice();
+		currentSound = nullptr;
+		return;
+	}
+
+	updateSoundFromPitchFactor(1.0, newSound);
+	lastMipmapPitchFactor = 1.0;
+}
+
 void WavetableSynthVoice::startNote(int midiNoteNumber, float /*velocity*/, SynthesiserSound* s, int /*currentPitchWheelPosition*/)
 {
     currentSound = nullptr;
@@ -415,6 +560,7 @@ void WavetableSynthVoice::startNote(int midiNoteNumber, float /*velocity*/, Synt
     startFrequency = MidiMessage::getMidiNoteInHertz(noteNumberAtStart);
 
     updateSoundFromPitchFactor(1.0, static_cast<WavetableSound*>(s));
+    lastMipmapPitchFactor = 1.0;
     
     static_cast<WavetableSynth*>(getOwnerSynth())->tableIndexKnobValue.reset();
     
@@ -507,7 +653,7 @@ WavetableSound::WavetableSound(const ValueTree &wavetableData, Processor* parent
 
 #if USE_MOD2_WAVETABLESIZE
 
-	if (!isPowerOfTwo(wavetableSize))
+	if (!isPowerOfTwo(wavetableSize) && parent != nullptr)
 	{
 		debugError(parent, "Wavetable with non-power two buffer size loaded. Please recompile HISE without USE_MOD2_WAVETABLESIZE.");
 	}
@@ -530,6 +676,76 @@ WavetableSound::WavetableSound(const ValueTree &wavetableData, Processor* parent
     frequencyRange = { lowDelta, highDelta };
 }
 
+WavetableSound::WavetableSound(const WavetableSound& source, int lowNote, int highNote, double bandLimitSampleRate)
+{
+	jassert(isPowerOfTwo(source.wavetableSize));
+
+	reversed = source.reversed;
+	stereo = source.stereo;
+	memoryUsage = source.memoryUsage;
+	storageSize = 0;
+	noteNumber = source.noteNumber;
+	sampleRate = source.sampleRate;
+	wavetableSize = source.wavetableSize;
+	wavetableAmount = source.wavetableAmount;
+	dynamicPhase = source.dynamicPhase;
+
+	wavetables.makeCopyOf(source.wavetables);
+	emptyBuffer.makeCopyOf(source.emptyBuffer);
+
+	// Remove all harmonics that would exceed the nyquist frequency at the highest note
+	auto maxHarmonic = jmax(1, (int)(0.5 * bandLimitSampleRate / MidiMessage::getMidiNoteInHertz(highNote)));
+
+	if (maxHarmonic < wavetableSize / 2)
+	{
+		dsp::FFT fft(roundToInt(std::log2((double)wavetableSize)));
+		HeapBlock<float> work(wavetableSize * 2);
+
+		const int firstBin = maxHarmonic + 1;
+		const int numBinsToClear = wavetableSize / 2 + 1 - firstBin;
+
+		for (int c = 0; c < wavetables.getNumChannels(); c++)
+		{
+			for (int t = 0; t < wavetableAmount; t++)
+			{
+				auto d = wavetables.getWritePointer(c, t * wavetableSize);
+
+				FloatVectorOperations::copy(work, d, wavetableSize);
+				FloatVectorOperations::clear(work + wavetableSize, wavetableSize);
+
+				fft.performRealOnlyForwardTransform(work, true);
+				FloatVectorOperations::clear(work + 2 * firstBin, 2 * numBinsToClear);
+				fft.performRealOnlyInverseTransform(work);
+
+				FloatVectorOperations::copy(d, work, wavetableSize);
+			}
+		}
+	}
+
+	maximum = wavetables.getMagnitude(0, wavetables.getNumSamples());
+	unnormalizedMaximum = 0.0f;
+
+	normalizeTables();
+
+	pitchRatio = 1.0;
+	playbackSampleRate = bandLimitSampleRate;
+
+	setNoteRange(lowNote, highNote);
+}
+
+void WavetableSound::setNoteRange(int lowNote, int highNote)
+{
+	jassert(lowNote <= highNote);
+
+	midiNotes.setRange(0, 128, false);
+	midiNotes.setRange(lowNote, highNote - lowNote + 1, true);
+
+	auto lowDelta = MidiMessage::getMidiNoteInHertz(lowNote);
+	auto highDelta = MidiMessage::getMidiNoteInHertz(highNote);
+
+	frequencyRange = { lowDelta, highDelta };
+}
+
 const float * WavetableSound::getWaveTableData(int channelIndex, int wavetableIndex) const
 {
 	jassert(isPositiveAndBelow(wavetableIndex, wavetableAmount));
@@ -595,112 +811,163 @@ String WavetableSound::getMarkdownDescription() const
 }
 
 void WavetableSound::RenderData::render(WavetableSound* currentSound, double& voiceUptime, const TableIndexFunction& tf)
+{
+	renderBlock(currentSound, voiceUptime, [&tf](float* data, int startSample, int numSamples)
+	{
+		for (int i = 0; i < numSamples; i++)
+			data[i] = tf(startSample + i);
+
+		return false;
+	});
+}
+
+void WavetableSound::RenderData::renderBlock(WavetableSound* currentSound, double& voiceUptime, const TableIndexBlockFunction& tf)
 {
 	auto numTables = currentSound->getWavetableAmount();
-	auto stereoMode = currentSound->isStereo();
+	auto numChannels = currentSound->isStereo() ? 2 : 1;
 	auto tableSize = currentSound->getTableSize();
 
 	dynamicPhase = currentSound->dynamicPhase;
 
-	while (--numSamples >= 0)
+	int indexes[ChunkSize];
+	int lowerTableIndexes[ChunkSize];
+	float alphas[ChunkSize];
+	float tableValues[ChunkSize];
+	float tableDeltas[ChunkSize];
+	float lower[ChunkSize];
+	float upper[ChunkSize];
+
+	while (numSamples > 0)
 	{
-		int index = (int)voiceUptime;
+		const int numThisTime = jmin(numSamples, ChunkSize);
 
-		span<int, 4> i;
+		for (int k = 0; k < numThisTime; k++)
+		{
+			const int index = (int)voiceUptime;
 
 #if USE_MOD2_WAVETABLESIZE
-		i[0] = (index + tableSize - 1) & (tableSize - 1);
-		i[1] = index & (tableSize - 1);
-		i[2] = (index + 1) & (tableSize - 1);
-		i[3] = (index + 2) & (tableSize - 1);
+			indexes[k] = index & (tableSize - 1);
 #else
-		i[1] = index % (tableSize);
-		i[2] = i[1] + 1;
-		i[0] = i[1] - 1;
-		i[3] = i[1] + 2;
-
-		if (i[1] == 0)         i[0] = tableSize - 1;
-		if (i[2] >= tableSize) i[2] = 0;
-		if (i[3] >= tableSize) i[3] = 0;
-
+			indexes[k] = index % tableSize;
 #endif
+			alphas[k] = float(voiceUptime) - (float)index;
 
-		const float tableModValue = tf(startSample);
-		const float tableValue = tableModValue * (float)(numTables - 1);
+			jassert(voicePitchValues == nullptr || voicePitchValues[startSample + k] > 0.0f);
 
-		const int lowerTableIndex = (int)(tableValue);
+			voiceUptime += (uptimeDelta * (voicePitchValues == nullptr ? 1.0 : voicePitchValues[startSample + k]));
+		}
 
-		const float tableDelta = tableValue - (float)lowerTableIndex;
-		jassert(0.0f <= tableDelta && tableDelta <= 1.0f);
+		const bool constantTableIndex = tf(tableValues, startSample, numThisTime);
 
-		const int upperTableIndex = jmin(numTables - 1, lowerTableIndex + 1);
+		if (constantTableIndex)
+		{
+			const float tableValue = tableValues[0] * (float)(numTables - 1);
+			const int lowerTableIndex = (int)(tableValue);
+			const float tableDelta = tableValue - (float)lowerTableIndex;
+			const int upperTableIndex = jmin(numTables - 1, lowerTableIndex + 1);
 
-		auto lowerTable = currentSound->getWaveTableData(0, lowerTableIndex);
-		auto upperTable = currentSound->getWaveTableData(0, upperTableIndex);
-		const float alpha = float(voiceUptime) - (float)index;
+			jassert(0.0f <= tableDelta && tableDelta <= 1.0f);
 
-		auto l = calculateSample(lowerTable, upperTable, i, alpha, tableDelta);
+			for (int c = 0; c < numChannels; c++)
+			{
+				auto output = b.getWritePointer(c, startSample);
 
-		// Stereo mode assumed
-		b.setSample(0, startSample, l);
+				interpolateTable(currentSound->getWaveTableData(c, lowerTableIndex), tableSize, indexes, alphas, output, numThisTime);
 
-		if (stereoMode)
-		{
-			auto lowerTableR = currentSound->getWaveTableData(1, lowerTableIndex);
-			auto upperTableR = currentSound->getWaveTableData(1, upperTableIndex);
+				if (upperTableIndex != lowerTableIndex)
+				{
+					interpolateTable(currentSound->getWaveTableData(c, upperTableIndex), tableSize, indexes, alphas, upper, numThisTime);
 
-			auto r = calculateSample(lowerTableR, upperTableR, i, alpha, tableDelta);
-			b.setSample(1, startSample, r);
+					FloatVectorOperations::multiply(output, 1.0f - tableDelta, numThisTime);
+					FloatVectorOperations::addWithMultiply(output, upper, tableDelta, numThisTime);
+				}
+			}
 		}
+		else
+		{
+			for (int k = 0; k < numThisTime; k++)
+			{
+				const float tableValue = tableValues[k] * (float)(numTables - 1);
+				lowerTableIndexes[k] = (int)tableValue;
+				tableDeltas[k] = tableValue - (float)lowerTableIndexes[k];
 
-		jassert(voicePitchValues == nullptr || voicePitchValues[startSample] > 0.0f);
+				jassert(0.0f <= tableDeltas[k] && tableDeltas[k] <= 1.0f);
+			}
 
-		const double delta = (uptimeDelta * (voicePitchValues == nullptr ? 1.0 : voicePitchValues[startSample]));
+			for (int c = 0; c < numChannels; c++)
+			{
+				// The table index changes slowly, so we can interpolate runs of samples with the same table pair
+				for (int k = 0; k < numThisTime;)
+				{
+					const int lowerTableIndex = lowerTableIndexes[k];
+					const int upperTableIndex = jmin(numTables - 1, lowerTableIndex + 1);
 
-		voiceUptime += delta;
+					int runLength = 1;
 
-		++startSample;
-	}
-}
+					while (k + runLength < numThisTime && lowerTableIndexes[k + runLength] == lowerTableIndex)
+						runLength++;
 
-float WavetableSound::RenderData::calculateSample(const float* lowerTable, const float* upperTable, const span<int, 4>& i, float alpha, float tableAlpha) const
-{
-	float l0 = lowerTable[i[0]];
-	float l1 = lowerTable[i[1]];
-	float l2 = lowerTable[i[2]];
-	float l3 = lowerTable[i[3]];
+					interpolateTable(currentSound->getWaveTableData(c, lowerTableIndex), tableSize, indexes + k, alphas + k, lower + k, runLength);
 
-	float sample;
+					if (upperTableIndex != lowerTableIndex)
+						interpolateTable(currentSound->getWaveTableData(c, upperTableIndex), tableSize, indexes + k, alphas + k, upper + k, runLength);
+					else
+						FloatVectorOperations::copy(upper + k, lower + k, runLength);
 
-	if (lowerTable != upperTable)
-	{
-		float u0 = upperTable[i[0]];
-		float u1 = upperTable[i[1]];
-		float u2 = upperTable[i[2]];
-		float u3 = upperTable[i[3]];
+					k += runLength;
+				}
 
-		float upperSample, lowerSample;
+				// output = lower * (1 - delta) + upper * delta
+				auto output = b.getWritePointer(c, startSample);
 
-		if (hqMode)
-		{
-			upperSample = Interpolator::interpolateCubic(u0, u1, u2, u3, alpha);
-			lowerSample = Interpolator::interpolateCubic(l0, l1, l2, l3, alpha);
+				FloatVectorOperations::fill(output, 1.0f, numThisTime);
+				FloatVectorOperations::subtract(output, tableDeltas, numThisTime);
+				FloatVectorOperations::multiply(output, lower, numThisTime);
+				FloatVectorOperations::addWithMultiply(output, upper, tableDeltas, numThisTime);
+			}
 		}
-		else
+
+		startSample += numThisTime;
+		numSamples -= numThisTime;
+	}
+}
+
+void WavetableSound::RenderData::interpolateTable(const float* table, int tableSize, const int* indexes, const float* alphas, float* output, int num) const
+{
+	if (hqMode)
+	{
+		for (int k = 0; k < num; k++)
 		{
-			upperSample = Interpolator::interpolateLinear(u1, u2, alpha);
-			lowerSample = Interpolator::interpolateLinear(l1, l2, alpha);
-		}
+			const int i1 = indexes[k];
 
-		sample = Interpolator::interpolateLinear(lowerSample, upperSample, tableAlpha);
+#if USE_MOD2_WAVETABLESIZE
+			const int i0 = (i1 + tableSize - 1) & (tableSize - 1);
+			const int i2 = (i1 + 1) & (tableSize - 1);
+			const int i3 = (i1 + 2) & (tableSize - 1);
+#else
+			const int i0 = i1 == 0 ? tableSize - 1 : i1 - 1;
+			const int i2 = i1 + 1 >= tableSize ? 0 : i1 + 1;
+			const int i3 = i1 + 2 >= tableSize ? 0 : i1 + 2;
+#endif
+
+			output[k] = Interpolator::interpolateCubic(table[i0], table[i1], table[i2], table[i3], alphas[k]);
+		}
 	}
 	else
 	{
-		sample = hqMode ? Interpolator::interpolateCubic(l0, l1, l2, l3, alpha) :
-			Interpolator::interpolateLinear(l1, l2, alpha);
-	}
+		for (int k = 0; k < num; k++)
+		{
+			const int i1 = indexes[k];
+
+#if USE_MOD2_WAVETABLESIZE
+			const int i2 = (i1 + 1) & (tableSize - 1);
+#else
+			const int i2 = i1 + 1 >= tableSize ? 0 : i1 + 1;
+#endif
 
-	return sample;
+			output[k] = Interpolator::interpolateLinear(table[i1], table[i2], alphas[k]);
+		}
+	}
 }
 
 void WavetableMonolithHeader::writeProjectInfo(OutputStream& output, const String& projectName, const String& encryptionKey)
@@ -790,4 +1057,185 @@ Array<hise::WavetableMonolithHeader> WavetableMonolithHeader::readHeader(InputSt
 	return headers;
 }
 
+bool WavetableBankCache::Bank::isUnused() const
+{
+	// The cache holds one reference to the bank and the bank one reference to each sound
+	if (getReferenceCount() > 1)
+		return false;
+
+	for (auto s : sounds)
+	{
+		if (s->getReferenceCount() > 1)
+			return false;
+	}
+
+	return true;
+}
+
+WavetableBankCache::WavetableBankCache():
+	workerPool(jmax(1, SystemStats::getNumCpus() - 1))
+{}
+
+WavetableBankCache::~WavetableBankCache()
+{
+	workerPool.removeAllJobs(true, 5000);
+}
+
+WavetableBankCache::Bank::Ptr WavetableBankCache::getBank(const String& id, double sampleRate) const
+{
+	ScopedLock sl(lock);
+
+	for (auto b : banks)
+	{
+		if (b->id == id && b->sampleRate == sampleRate)
+			return b;
+	}
+
+	return nullptr;
+}
+
+WavetableBankCache::Bank::Ptr WavetableBankCache::loadBank(const String& id, double sampleRate, const LoadFunction& f)
+{
+	if (auto b = getBank(id, sampleRate))
+		return b;
+
+	auto newBank = createBank(id, sampleRate, f());
+
+	ScopedLock sl(lock);
+
+	// Another synth might have loaded the same bank in the meantime
+	if (auto b = getBank(id, sampleRate))
+		return b;
+
+	banks.add(newBank);
+	return newBank;
+}
+
+void WavetableBankCache::removeUnusedBanks()
+{
+	ScopedLock sl(lock);
+
+	for (int i = banks.size() - 1; i >= 0; i--)
+	{
+		if (banks[i]->isUnused())
+			banks.remove(i);
+	}
+}
+
+void WavetableBankCache::runParallel(int numJobs, const std::function<void(int)>& f)
+{
+	if (numJobs <= 1)
+	{
+		for (int i = 0; i < numJobs; i++)
+			f(i);
+
+		return;
+	}
+
+	WaitableEvent allDone;
+	std::atomic<int> numPending = { numJobs };
+
+	for (int i = 0; i < numJobs; i++)
+	{
+		workerPool.addJob([&, i]()
+		{
+			f(i);
+
+			if (--numPending == 0)
+				allDone.signal();
+		});
+	}
+
+	allDone.wait();
+}
+
+WavetableBankCache::Bank::Ptr WavetableBankCache::createBank(const String& id, double sampleRate, const ValueTree& v)
+{
+	Bank::Ptr b = new Bank();
+
+	b->id = id;
+	b->sampleRate = sampleRate;
+
+	if (!v.isValid())
+		return b;
+
+	const int numChildren = v.getNumChildren();
+
+	std::vector<ReferenceCountedObjectPtr<WavetableSound>> decoded((size_t)numChildren);
+
+	runParallel(numChildren, [&](int i)
+	{
+		decoded[(size_t)i] = new WavetableSound(v.getChild(i), nullptr);
+	});
+
+	struct MipmapRange
+	{
+		int childIndex;
+		int lowNote;
+		int highNote;
+	};
+
+	Array<MipmapRange> mipmaps;
+
+	for (int i = 0; i < numChildren; i++)
+	{
+		auto s = decoded[(size_t)i].get();
+
+		auto lowest = s->getLowestNote();
+		auto highest = s->getHighestNote();
+		auto firstMipmapNote = s->getRootNote() + 12;
+
+		// The FFT needs a power of two table size
+		if (!isPowerOfTwo(s->getTableSize()) || highest < firstMipmapNote)
+			continue;
+
+		for (int lo = firstMipmapNote; lo <= highest; lo += 12)
+		{
+			auto low = jmax(lo, lowest);
+			auto high = jmin(lo + 11, highest);
+
+			if (low <= high)
+				mipmaps.add({ i, low, high });
+		}
+	}
+
+	std::vector<ReferenceCountedObjectPtr<WavetableSound>> mipmapSounds((size_t)mipmaps.size());
+
+	runParallel(mipmaps.size(), [&](int i)
+	{
+		auto& m = mipmaps.getReference(i);
+		mipmapSounds[(size_t)i] = new WavetableSound(*decoded[(size_t)m.childIndex], m.lowNote, m.highNote, sampleRate);
+	});
+
+	for (int i = 0; i < numChildren; i++)
+	{
+		auto s = decoded[(size_t)i];
+
+		auto lowest = s->getLowestNote();
+		auto highest = s->getHighestNote();
+		auto rootRangeEnd = s->getRootNote() + 11;
+
+		if (highest > rootRangeEnd && isPowerOfTwo(s->getTableSize()))
+		{
+			// This child is completely covered by the mipmaps
+			if (lowest > rootRangeEnd)
+				continue;
+
+			s->setNoteRange(lowest, rootRangeEnd);
+		}
+
+		s->calculatePitchRatio(sampleRate);
+		b->reversed = s->isReversed();
+		b->sounds.add(s.get());
+	}
+
+	for (auto& s : mipmapSounds)
+	{
+		s->calculatePitchRatio(sampleRate);
+		b->sounds.add(s.get());
+	}
+
+	return b;
+}
+
 } // namespace hise
@@ -77,6 +77,13 @@ public:
 	*/
 	WavetableSound(const ValueTree &wavetableData, Processor* parent);;
 
+	/** Creates a band-limited copy of the source sound that is used for the given note range.
+	*
+	*	All harmonics that would exceed the nyquist frequency at the highest note of the range are removed
+	*	using a FFT, so the table size must be a power of two.
+	*/
+	WavetableSound(const WavetableSound& source, int lowNote, int highNote, double bandLimitSampleRate);
+
 	bool appliesToNote (int midiNoteNumber) override   { return midiNotes[midiNoteNumber]; }
     bool appliesToChannel (int /*midiChannel*/) override   { return true; }
 	bool appliesToVelocity (int /*midiChannel*/) override  { return true; }
@@ -139,11 +146,27 @@ public:
 
 	bool isStereo() const { return stereo; };
 
+	/** Restricts the sound to the given note range. */
+	void setNoteRange(int lowNote, int highNote);
+
+	int getLowestNote() const { return midiNotes.findNextSetBit(0); }
+
+	int getHighestNote() const { return midiNotes.getHighestBit(); }
+
 	float isReversed() const { return reversed; };
 
 	struct RenderData
 	{
 		using TableIndexFunction = std::function<float(int)>;
+
+		/** Writes the table index values for the given range into the buffer.
+		*
+		*	Return true if the values are constant for the range (then only the first value needs to be written).
+		*/
+		using TableIndexBlockFunction = std::function<bool(float*, int, int)>;
+
+		/** The number of samples that are processed in one chunk by renderBlock(). */
+		static constexpr int ChunkSize = 128;
 		RenderData(AudioSampleBuffer& b_, int startSample_, int numSamples_, double uptimeDelta_, const float* voicePitchValues_, bool hqMode_) :
 			b(b_),
 			startSample(startSample_),
@@ -161,9 +184,19 @@ public:
 		const bool hqMode;
 		bool dynamicPhase = false;
 
+		/** Renders the wavetable by calling the table index function for each sample. */
 		void render(WavetableSound* currentSound, double& voiceUptime, const TableIndexFunction& tf);
 
-		float calculateSample(const float* lowerTable, const float* upperTable, const span<int, 4>& i, float alpha, float tableAlpha) const;
+		/** Renders the wavetable in chunks and fetches the table index values once per chunk.
+		*
+		*	The interpolation and the crossfade between the tables are calculated over the entire chunk
+		*	and if the table index is constant, only the two surrounding tables will be interpolated.
+		*/
+		void renderBlock(WavetableSound* currentSound, double& voiceUptime, const TableIndexBlockFunction& tf);
+
+	private:
+
+		void interpolateTable(const float* table, int tableSize, const int* indexes, const float* alphas, float* output, int num) const;
 	};
 
 private:
@@ -195,6 +228,59 @@ private:
 	bool dynamicPhase = false;
 };
 
+/** A process-wide cache for decoded wavetable banks.
+*
+*	Banks are identified by a string (the file and the bank index) and the playback sample rate, so
+*	multiple WavetableSynths that load the same bank will share the decoded tables. The children
+*	of a bank are decoded in parallel and if a child spans more than an octave above its root note,
+*	band-limited mipmaps are generated for every additional octave.
+*/
+class WavetableBankCache
+{
+public:
+
+	struct Bank : public ReferenceCountedObject
+	{
+		using Ptr = ReferenceCountedObjectPtr<Bank>;
+
+		/** Returns true if neither a synth nor a voice uses this bank. */
+		bool isUnused() const;
+
+		String id;
+		double sampleRate = 0.0;
+		float reversed = 0.0f;
+		ReferenceCountedArray<WavetableSound> sounds;
+	};
+
+	/** A function that reads the ValueTree of the bank. This will be called on the loading thread. */
+	using LoadFunction = std::function<ValueTree()>;
+
+	WavetableBankCache();
+	~WavetableBankCache();
+
+	/** Returns the bank if it has been loaded already. */
+	Bank::Ptr getBank(const String& id, double sampleRate) const;
+
+	/** Loads the bank on the calling thread. */
+	Bank::Ptr loadBank(const String& id, double sampleRate, const LoadFunction& f);
+
+	/** Removes all banks that are not used anymore. */
+	void removeUnusedBanks();
+
+private:
+
+	Bank::Ptr createBank(const String& id, double sampleRate, const ValueTree& v);
+
+	void runParallel(int numJobs, const std::function<void(int)>& f);
+
+	mutable CriticalSection lock;
+	ReferenceCountedArray<Bank> banks;
+
+	ThreadPool workerPool;
+
+	JUCE_DECLARE_NON_COPYABLE(WavetableBankCache);
+};
+
 class WavetableSynth;
 
 class WavetableSynthVoice: public ModulatorSynthVoice
@@ -225,6 +311,12 @@ public:
 	};
 
     bool updateSoundFromPitchFactor(double pitchFactor, WavetableSound* soundToUse);
+
+	/** Picks the sound for the current note from the sounds of the owner synth after the bank was replaced.
+	*
+	*	This must be called with the audio lock held. If there is no sound for the note, the voice will be reset.
+	*/
+	void refreshSoundAfterBankChange();
     
 private:
 
@@ -242,6 +334,7 @@ private:
 	
 	bool hqMode = true;
 	bool refreshMipmap = false;
+	double lastMipmapPitchFactor = 1.0;
 
 	float const *currentTable;
 };
@@ -289,8 +382,12 @@ public:
 
 	WavetableSynth(MainController *mc, const String &id, int numVoices);;
 
+	~WavetableSynth();
+
 	void loadWaveTable(const ValueTree& v)
 	{
+		currentBank = nullptr;
+
 		clearSounds();
         
 		jassert(v.isValid());
@@ -371,12 +468,19 @@ public:
 	{
 		if(newSampleRate > -1.0)
 		{
-			for(int i = 0; i < sounds.size(); i++)
+			if (currentBank != nullptr)
 			{
-				static_cast<WavetableSound*>(getSound(i))->calculatePitchRatio(newSampleRate);
+				// the sounds of a cached bank are shared, so we need to fetch the bank for the new samplerate
+				if (currentBank->sampleRate != newSampleRate)
+					setBank(bankCache->loadBank(currentBank->id, newSampleRate, createBankLoadFunction(currentBankIndex)), currentBankIndex);
+			}
+			else
+			{
+				for(int i = 0; i < sounds.size(); i++)
+				{
+					static_cast<WavetableSound*>(getSound(i))->calculatePitchRatio(newSampleRate);
+				}
 			}
-
-			
 		}
 
 		if (samplesPerBlock > 0 && newSampleRate > 0.0)
@@ -388,6 +492,12 @@ public:
 
 	float getTotalTableModValue(int offset);
 
+	/** Writes the table index modulation values of the current voice into the buffer.
+	*
+	*	Returns true if the values are constant for the given range.
+	*/
+	bool getTotalTableModValues(float* data, int startSample, int numSamples);
+
 	float getDefaultValue(int parameterIndex) const override
 	{
 		if (parameterIndex < ModulatorSynth::numModulatorSynthParameters) return ModulatorSynth::getDefaultValue(parameterIndex);
@@ -489,7 +599,21 @@ public:
 	}
 
 private:
-	void loadWavetableInternal();
+
+	/** Returns the string that identifies the bank with the given index in the bank cache. */
+	String getBankId(int index) const;
+
+	/** Creates a function that reads the bank with the given index. This can be called on any thread. */
+	WavetableBankCache::LoadFunction createBankLoadFunction(int index) const;
+
+	/** Looks up or loads the bank with the given index and swaps it in. This is called on the sample loading thread. */
+	void loadBankOnLoadingThread(int index);
+
+	/** Replaces the sounds with the ones from the given bank without killing the voices. */
+	void setBank(WavetableBankCache::Bank::Ptr newBank, int index);
+
+	SharedResourcePointer<WavetableBankCache> bankCache;
+	WavetableBankCache::Bank::Ptr currentBank;
 	
 
 	float displayTableValue = 1.0f;
@@ -498,7 +622,7 @@ private:
 	
 	float reversed = 0.0f;
 
-	int currentBankIndex = 0;
+	std::atomic<int> currentBankIndex = { 0 };
 
 	bool hqMode = true;
 	bool refreshMipmap = false;
@@ -0,0 +1,323 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#if HI_RUN_UNIT_TESTS
+
+namespace hise { using namespace juce;
+
+/** Checks the block renderer of the wavetable synth against the per-sample path and reports the voices per core. */
+class WavetableRenderTest : public UnitTest
+{
+public:
+
+	static constexpr int TableSize = 2048;
+	static constexpr int NumTables = 64;
+	static constexpr int BlockSize = 512;
+	static constexpr int NumVoices = 16;
+	static constexpr double SampleRate = 44100.0;
+
+	WavetableRenderTest() :
+		UnitTest("Testing wavetable rendering", "Benchmark")
+	{}
+
+	void runTest() override
+	{
+		createSound();
+
+		testConstantTableIndex(true);
+		testConstantTableIndex(false);
+		testModulatedTableIndex();
+		testBankCache();
+		testVoicesPerCore(true);
+		testVoicesPerCore(false);
+	}
+
+private:
+
+	ValueTree createWavetableData() const
+	{
+		MemoryBlock mb;
+		mb.setSize(sizeof(float) * TableSize * NumTables, true);
+
+		auto data = static_cast<float*>(mb.getData());
+
+		// a saw wave that gets brighter with every table
+		for (int t = 0; t < NumTables; t++)
+		{
+			for (int i = 0; i < TableSize; i++)
+			{
+				auto phase = (float)i / (float)TableSize * float_Pi * 2.0f;
+				auto v = 0.0f;
+
+				for (int h = 1; h <= t + 1; h++)
+					v += std::sin(phase * (float)h) / (float)h;
+
+				data[t * TableSize + i] = v * 0.5f;
+			}
+		}
+
+		ValueTree v("wavetable");
+		v.setProperty("data", var(mb), nullptr);
+		v.setProperty("amount", NumTables, nullptr);
+		v.setProperty("sampleRate", SampleRate, nullptr);
+		v.setProperty("noteNumber", 60, nullptr);
+
+		return v;
+	}
+
+	void createSound()
+	{
+		sound = new WavetableSound(createWavetableData(), nullptr);
+		sound->calculatePitchRatio(SampleRate);
+	}
+
+	void render(AudioSampleBuffer& b, double& uptime, bool hqMode, bool useBlockFunction, const std::function<float(int)>& tf)
+	{
+		WavetableSound::RenderData r(b, 0, b.getNumSamples(), sound->getPitchRatio(64.0), nullptr, hqMode);
+
+		if (useBlockFunction)
+		{
+			r.renderBlock(sound.get(), uptime, [&tf](float* data, int startSample, int numSamples)
+			{
+				data[0] = tf(startSample);
+
+				bool isConstant = true;
+
+				for (int i = 1; i < numSamples; i++)
+				{
+					data[i] = tf(startSample + i);
+					isConstant &= (data[i] == data[0]);
+				}
+
+				return isConstant;
+			});
+		}
+		else
+		{
+			r.render(sound.get(), uptime, tf);
+		}
+	}
+
+	void expectBuffersMatch(const AudioSampleBuffer& a, const AudioSampleBuffer& b)
+	{
+		float maxError = 0.0f;
+
+		for (int i = 0; i < a.getNumSamples(); i++)
+			maxError = jmax(maxError, std::abs(a.getSample(0, i) - b.getSample(0, i)));
+
+		expect(maxError < 1e-5f, "Error: " + String(maxError));
+	}
+
+	void testConstantTableIndex(bool hqMode)
+	{
+		beginTest("Testing constant table index " + String(hqMode ? "(HQ)" : "(linear)"));
+
+		AudioSampleBuffer a(1, BlockSize), b(1, BlockSize);
+		double ua = 0.0, ub = 0.0;
+
+		auto tf = [](int) { return 0.37f; };
+
+		render(a, ua, hqMode, true, tf);
+		render(b, ub, hqMode, false, tf);
+
+		expectEquals(ua, ub, "uptime mismatch");
+		expectBuffersMatch(a, b);
+	}
+
+	void testModulatedTableIndex()
+	{
+		beginTest("Testing modulated table index");
+
+		AudioSampleBuffer a(1, BlockSize), b(1, BlockSize), reference(1, BlockSize);
+		double ua = 0.0, ub = 0.0;
+
+		auto tf = [](int i) { return jlimit(0.0f, 1.0f, (float)i / (float)BlockSize); };
+
+		render(a, ua, true, true, tf);
+		render(b, ub, true, false, tf);
+
+		expectBuffersMatch(a, b);
+
+		// Calculate the reference with the scalar formula
+		auto tableSize = sound->getTableSize();
+		auto delta = sound->getPitchRatio(64.0);
+		double uptime = 0.0;
+
+		for (int i = 0; i < BlockSize; i++)
+		{
+			auto index = (int)uptime;
+			auto alpha = float(uptime) - (float)index;
+
+			auto i1 = index % tableSize;
+			auto i0 = i1 == 0 ? tableSize - 1 : i1 - 1;
+			auto i2 = i1 + 1 >= tableSize ? 0 : i1 + 1;
+			auto i3 = i1 + 2 >= tableSize ? 0 : i1 + 2;
+
+			auto tableValue = tf(i) * (float)(NumTables - 1);
+			auto lowerIndex = (int)tableValue;
+			auto upperIndex = jmin(NumTables - 1, lowerIndex + 1);
+			auto tableDelta = tableValue - (float)lowerIndex;
+
+			auto lt = sound->getWaveTableData(0, lowerIndex);
+			auto ut = sound->getWaveTableData(0, upperIndex);
+
+			auto l = Interpolator::interpolateCubic(lt[i0], lt[i1], lt[i2], lt[i3], alpha);
+			auto u = Interpolator::interpolateCubic(ut[i0], ut[i1], ut[i2], ut[i3], alpha);
+
+			reference.setSample(0, i, Interpolator::interpolateLinear(l, u, tableDelta));
+			uptime += delta;
+		}
+
+		expectBuffersMatch(a, reference);
+	}
+
+	void testBankCache()
+	{
+		beginTest("Testing wavetable bank cache");
+
+		SharedResourcePointer<WavetableBankCache> cache;
+
+		auto loadFunction = [this]()
+		{
+			ValueTree bank("wavetables");
+
+			// One child that spans two and a half octaves
+			auto c = createWavetableData();
+			c.setProperty(SampleIds::LoKey, 48, nullptr);
+			c.setProperty(SampleIds::HiKey, 90, nullptr);
+			bank.addChild(c, -1, nullptr);
+
+			return bank;
+		};
+
+		auto b1 = cache->loadBank("test", SampleRate, loadFunction);
+		auto b2 = cache->loadBank("test", SampleRate, loadFunction);
+
+		expect(b1 == b2, "bank isn't shared");
+
+		// 48-71 (root), 72-83, 84-90
+		expectEquals(b1->sounds.size(), 3, "wrong mipmap amount");
+
+		auto lastTable = NumTables - 1;
+
+		for (auto s : b1->sounds)
+		{
+			expect(s->appliesToNote(s->getLowestNote()), "wrong note range");
+
+			// the brightest table has 64 harmonics, so every mipmap must remove some of them
+			auto maxHarmonic = (int)(0.5 * SampleRate / MidiMessage::getMidiNoteInHertz(s->getHighestNote()));
+
+			auto d = s->getWaveTableData(0, lastTable);
+			auto ref = sound->getWaveTableData(0, lastTable);
+
+			float diff = 0.0f;
+
+			for (int i = 0; i < TableSize; i++)
+				diff = jmax(diff, std::abs(d[i] - ref[i]));
+
+			if (s->getHighestNote() < 72)
+				expect(diff == 0.0f, "root table was modified");
+			else
+				expect(maxHarmonic >= NumTables || diff > 0.001f, "mipmap isn't band-limited");
+		}
+
+		b1 = nullptr;
+		b2 = nullptr;
+
+		cache->removeUnusedBanks();
+
+		expect(cache->getBank("test", SampleRate) == nullptr, "unused bank wasn't removed");
+	}
+
+	void testVoicesPerCore(bool constantTableIndex)
+	{
+		beginTest("Measuring voices per core " + String(constantTableIndex ? "(constant table index)" : "(modulated table index)"));
+
+		AudioSampleBuffer b(1, BlockSize);
+		double uptimes[NumVoices];
+
+		for (int i = 0; i < NumVoices; i++)
+			uptimes[i] = (double)i * 17.0;
+
+		float tableIndex = 0.0f;
+		int numInvalidBlocks = 0;
+
+		auto voicesPerCore = VoiceBenchmark::measureVoicesPerCore(NumVoices, SampleRate, BlockSize, 2.0, [&](int)
+		{
+			for (int v = 0; v < NumVoices; v++)
+			{
+				WavetableSound::RenderData r(b, 0, BlockSize, sound->getPitchRatio(48.0 + (double)v), nullptr, true);
+
+				r.renderBlock(sound.get(), uptimes[v], [&](float* data, int, int numSamples)
+				{
+					if (constantTableIndex)
+					{
+						data[0] = 0.5f;
+						return true;
+					}
+
+					for (int i = 0; i < numSamples; i++)
+					{
+						tableIndex = std::fmod(tableIndex + 0.0001f, 1.0f);
+						data[i] = tableIndex;
+					}
+
+					return false;
+				});
+
+				if (!VoiceBenchmark::isValidOutput(b.getReadPointer(0), BlockSize, 0.01f, 1.5f))
+					numInvalidBlocks++;
+			}
+		});
+
+		logMessage("Voices per core: " + String(voicesPerCore, 1));
+
+		expectEquals(numInvalidBlocks, 0, "silent or invalid output");
+
+		// Every voice must have advanced by the number of rendered samples
+		const auto numSamples = (double)(VoiceBenchmark::getNumBlocks(SampleRate, BlockSize, 2.0) * BlockSize);
+
+		for (int v = 0; v < NumVoices; v++)
+		{
+			auto expected = (double)v * 17.0 + numSamples * sound->getPitchRatio(48.0 + (double)v);
+			expectWithinAbsoluteError(uptimes[v], expected, 0.001 * expected, "wrong uptime for voice " + String(v));
+		}
+	}
+
+	ReferenceCountedObjectPtr<WavetableSound> sound;
+};
+
+static WavetableRenderTest wavetableRenderTest;
+
+}
+
+#endif
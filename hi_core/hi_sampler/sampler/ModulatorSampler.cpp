@@ -172,6 +172,8 @@ syncVoiceHandler(false)
 	for (int i = 0; i < 127; i++) 
 		samplerDisplayValues.currentNotes[i] = 0;
 
+	warmupCache = new TimestretchWarmupCache(getBackgroundThreadPool());
+
 	setVoiceAmount(numVoices);
 
 
@@ -688,6 +690,7 @@ void ModulatorSampler::deleteSound(int index)
 
 		{
 			LockHelpers::SafeLock sl(getMainController(), LockHelpers::Type::SampleLock);
+			warmupCache->clear();
 			removeSound(index);
 		}
 
@@ -717,6 +720,8 @@ void ModulatorSampler::deleteAllSounds()
 	{
 		LockHelpers::SafeLock sl(getMainController(), LockHelpers::Type::SampleLock);
 
+		warmupCache->clear();
+
 		// The lifetime could exceed this function, so we need to flag it as pending for delete
 		// so that async tasks will not use this later.
 		for (int i = 0; i < getNumSounds(); i++)
@@ -1052,6 +1057,8 @@ void ModulatorSampler::setTimestretchOptions(const TimestretchOptions& newOption
 		else
 			s->getMainController()->removeTempoListener(&s->syncer);
 		
+		s->warmupCache->setEnabled((bool)options, options.engineId);
+
 		for (auto v : s->voices)
 		{
 			dynamic_cast<ModulatorSamplerVoice*>(v)->setTimestretchOptions(options);
@@ -1823,6 +1830,9 @@ bool ModulatorSampler::preloadAllSamples()
 	resetNotes();
 	setShouldUpdateUI(false);
 
+	// the warmed up engines have digested the old preload buffers
+	warmupCache->clear();
+
 	debugToConsole(this, "Changing preload size to " + String(preloadSizeToUse) + " samples");
 
 	const bool isReversed = getAttribute(ModulatorSampler::Reversed) > 0.5f;
@@ -700,6 +700,8 @@ public:
 
 	AudioSampleBuffer* getTemporaryStretchBuffer() { return &stretchBuffer; }
 
+	TimestretchWarmupCache* getTimestretchWarmupCache() { return warmupCache.get(); }
+
 	hlac::HiseSampleBuffer* getTemporaryVoiceBuffer() { return &temporaryVoiceBuffer; }
 
 	bool checkAndLogIsSoftBypassed(DebugLogger::Location location) const;
@@ -934,6 +936,8 @@ private:
 	hlac::HiseSampleBuffer temporaryVoiceBuffer;
 	AudioSampleBuffer stretchBuffer;
 
+	ScopedPointer<TimestretchWarmupCache> warmupCache;
+
 	bool delayUpdate = false;
 	int lowPassOrder = 0;
 
@@ -417,6 +417,7 @@ wrappedVoice(sampler->getBackgroundThreadPool())
 	auto ms = static_cast<ModulatorSampler*>(ownerSynth);
 
 	wrappedVoice.setTemporaryVoiceBuffer(ms->getTemporaryVoiceBuffer(), ms->getTemporaryStretchBuffer());
+	wrappedVoice.setTimestretchWarmupCache(ms->getTimestretchWarmupCache());
 	wrappedVoice.setDebugLogger(&ownerSynth->getMainController()->getDebugLogger());
 	wrappedVoice.setSuspendOnDelayedStartFunction(std::bind(&ModulatorSynth::syncAfterDelayStart, ownerSynth, std::placeholders::_1, std::placeholders::_2), getVoiceIndex());
 };
@@ -436,6 +437,7 @@ ModulatorSamplerVoice(ownerSynth)
 		wrappedVoices.getLast()->prepareToPlay(getOwnerSynth()->getSampleRate(), getOwnerSynth()->getLargestBlockSize());
 		wrappedVoices.getLast()->setLoaderBufferSize((int)getOwnerSynth()->getAttribute(ModulatorSampler::BufferSize));
 		wrappedVoices.getLast()->setTemporaryVoiceBuffer(ms->getTemporaryVoiceBuffer(), ms->getTemporaryStretchBuffer());
+		wrappedVoices.getLast()->setTimestretchWarmupCache(ms->getTimestretchWarmupCache());
 		wrappedVoices.getLast()->setDebugLogger(&ownerSynth->getMainController()->getDebugLogger());
 	}
 
@@ -0,0 +1,509 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which also must be licenced for commercial applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+namespace hise { using namespace juce;
+
+namespace PolyphaseHelpers
+{
+
+/** The filter coefficients for a single 2x stage. They are designed once per filter type
+	and stage index (using the same design parameters as juce::dsp::Oversampling) and
+	shared between all oversampler instances.
+*/
+struct StageCoefficients
+{
+	using FilterType = PolyphaseOversampler::FilterType;
+
+	StageCoefficients(FilterType t, int stageIndex_):
+		type(t),
+		stageIndex(stageIndex_)
+	{
+		auto twUp   = 0.12f * (stageIndex == 0 ? 0.5f : 1.0f);
+		auto twDown = 0.15f * (stageIndex == 0 ? 0.5f : 1.0f);
+
+		auto dbUp   = -70.0f + 8.0f * (float)stageIndex;
+		auto dbDown = -60.0f + 8.0f * (float)stageIndex;
+
+		if (type == FilterType::MinimumPhase)
+		{
+			numDirectUp = createAllpassCoefficients(up, twUp, dbUp);
+			numDirectDown = createAllpassCoefficients(down, twDown, dbDown);
+
+			latency = getAllpassLatency(up, numDirectUp) + getAllpassLatency(down, numDirectDown);
+		}
+		else
+		{
+			auto firUp = dsp::FilterDesign<float>::designFIRLowpassHalfBandEquirippleMethod(twUp, dbUp);
+			auto firDown = dsp::FilterDesign<float>::designFIRLowpassHalfBandEquirippleMethod(twDown, dbDown);
+
+			up.addArray(firUp->getRawCoefficients(), (int)firUp->getFilterOrder() + 1);
+			down.addArray(firDown->getRawCoefficients(), (int)firDown->getFilterOrder() + 1);
+
+			latency = (float)(up.size() - 1 + down.size() - 1) * 0.5f;
+		}
+	}
+
+	static int createAllpassCoefficients(Array<float>& coefficients, float transitionWidth, float stopbandGain)
+	{
+		auto structure = dsp::FilterDesign<float>::designIIRLowpassHalfBandPolyphaseAllpassMethod(transitionWidth, stopbandGain);
+
+		for (int i = 0; i < structure.directPath.size(); ++i)
+			coefficients.add(structure.directPath.getObjectPointer(i)->coefficients[0]);
+
+		// the first delayed path element is the z^-1 delay
+		for (int i = 1; i < structure.delayedPath.size(); ++i)
+			coefficients.add(structure.delayedPath.getObjectPointer(i)->coefficients[0]);
+
+		return structure.directPath.size();
+	}
+
+	/** Evaluates 0.5 * (A0(z^2) + z^-1 * A1(z^2)) at a low frequency and returns the group delay. */
+	static float getAllpassLatency(const Array<float>& coefficients, int numDirect)
+	{
+		using Complex = std::complex<double>;
+
+		const double w = 0.0001 * MathConstants<double>::twoPi;
+		const auto z1 = std::polar(1.0, -w);
+		const auto z2 = z1 * z1;
+
+		Complex a0(1.0), a1(1.0);
+
+		for (int i = 0; i < coefficients.size(); i++)
+		{
+			const double alpha = (double)coefficients[i];
+			auto section = (alpha + z2) / (1.0 + alpha * z2);
+
+			if (i < numDirect)
+				a0 *= section;
+			else
+				a1 *= section;
+		}
+
+		auto h = 0.5 * (a0 + z1 * a1);
+		return (float)(-std::arg(h) / w);
+	}
+
+	static const StageCoefficients& get(FilterType t, int stageIndex)
+	{
+		struct Cache
+		{
+			CriticalSection lock;
+			OwnedArray<StageCoefficients> items;
+		};
+
+		static Cache cache;
+
+		ScopedLock sl(cache.lock);
+
+		for (auto c : cache.items)
+		{
+			if (c->type == t && c->stageIndex == stageIndex)
+				return *c;
+		}
+
+		return *cache.items.add(new StageCoefficients(t, stageIndex));
+	}
+
+	const FilterType type;
+	const int stageIndex;
+
+	Array<float> up, down;
+	int numDirectUp = 0;
+	int numDirectDown = 0;
+	float latency = 0.0f;
+};
+
+}
+
+struct PolyphaseOversampler::Stage
+{
+	Stage(const PolyphaseHelpers::StageCoefficients& c):
+		coefficients(c)
+	{};
+
+	virtual ~Stage() {};
+
+	/** The latency at the oversampled rate of this stage. */
+	float getLatencyInSamples() const { return coefficients.latency; }
+
+	/** The number of floats that are stored per channel and voice. */
+	virtual int getStateSize() const = 0;
+
+	/** Allocates the scratch buffers. The scratch buffers are shared between voices. */
+	virtual void initProcessing(int maxNumSamplesBeforeOversampling) {};
+
+	/** Processes numSamples into 2 * numSamples. */
+	virtual void processUp(const float* input, float* output, float* state, int numSamples) noexcept = 0;
+
+	/** Processes 2 * numSamples into numSamples. */
+	virtual void processDown(const float* input, float* output, float* state, int numSamples) noexcept = 0;
+
+	const PolyphaseHelpers::StageCoefficients& coefficients;
+};
+
+namespace PolyphaseHelpers
+{
+
+/** The minimum phase stage. This is the same algorithm as juce::dsp::Oversampling2TimesPolyphaseIIR
+	but with an external state. The allpass cascade is recursive, so there's not much to vectorise here.
+*/
+struct AllpassStage : public PolyphaseOversampler::Stage
+{
+	AllpassStage(const StageCoefficients& c):
+		Stage(c)
+	{}
+
+	int getStateSize() const override
+	{
+		// up state + down state + one delay sample
+		return coefficients.up.size() + coefficients.down.size() + 1;
+	}
+
+	static forcedinline float processCascade(const float* coeffs, float* lv1, int start, int end, float input) noexcept
+	{
+		for (int n = start; n < end; ++n)
+		{
+			auto alpha = coeffs[n];
+			auto output = alpha * input + lv1[n];
+			lv1[n] = input - alpha * output;
+			input = output;
+		}
+
+		return input;
+	}
+
+	void processUp(const float* input, float* output, float* state, int numSamples) noexcept override
+	{
+		auto coeffs = coefficients.up.begin();
+		auto numStages = coefficients.up.size();
+		auto directStages = coefficients.numDirectUp;
+
+		for (int i = 0; i < numSamples; ++i)
+		{
+			output[i << 1] = processCascade(coeffs, state, 0, directStages, input[i]);
+			output[(i << 1) + 1] = processCascade(coeffs, state, directStages, numStages, input[i]);
+		}
+
+		FloatSanitizers::sanitizeArray(state, numStages);
+	}
+
+	void processDown(const float* input, float* output, float* state, int numSamples) noexcept override
+	{
+		auto coeffs = coefficients.down.begin();
+		auto numStages = coefficients.down.size();
+		auto directStages = coefficients.numDirectDown;
+
+		auto lv1 = state + coefficients.up.size();
+		auto delay = lv1[numStages];
+
+		for (int i = 0; i < numSamples; ++i)
+		{
+			auto directOut = processCascade(coeffs, lv1, 0, directStages, input[i << 1]);
+			auto delayedOut = processCascade(coeffs, lv1, directStages, numStages, input[(i << 1) + 1]);
+
+			output[i] = (delay + directOut) * 0.5f;
+			delay = delayedOut;
+		}
+
+		FloatSanitizers::sanitizeArray(lv1, numStages);
+
+		lv1[numStages] = delay;
+	}
+};
+
+/** The linear phase stage. The half band FIR has every second coefficient (except the center tap)
+	set to zero, so the even output samples are a convolution with the even taps and the odd
+	output samples are just a delayed & scaled copy of the input. Both parts are computed
+	block-wise with the vectorised FloatVectorOperations.
+*/
+struct FIRStage : public PolyphaseOversampler::Stage
+{
+	FIRStage(const StageCoefficients& c) :
+		Stage(c),
+		upHistory((c.up.size() - 1) / 2),
+		downHistory((c.down.size() - 1) / 2),
+		upCenterDelay((c.up.size() / 2 - 1) / 2),
+		downCenterDelay((c.down.size() / 2 - 1) / 2 + 1)
+	{
+		for (int i = 0; i <= upHistory; i++)
+			upTaps.add(c.up[i * 2]);
+
+		for (int i = 0; i <= downHistory; i++)
+			downTaps.add(c.down[i * 2]);
+
+		upCenter = c.up[c.up.size() / 2];
+		downCenter = c.down[c.down.size() / 2];
+	}
+
+	int getStateSize() const override
+	{
+		return upHistory + downHistory + downCenterDelay;
+	}
+
+	void initProcessing(int maxNumSamplesBeforeOversampling) override
+	{
+		auto maxHistory = jmax(upHistory, downHistory);
+
+		evenScratch.setSize(2, maxHistory + maxNumSamplesBeforeOversampling);
+		oddScratch.setSize(2, downCenterDelay + maxNumSamplesBeforeOversampling);
+	}
+
+	void processUp(const float* input, float* output, float* state, int numSamples) noexcept override
+	{
+		jassert(numSamples + upHistory <= evenScratch.getNumSamples());
+
+		auto history = evenScratch.getWritePointer(0);
+		auto even = evenScratch.getWritePointer(1);
+		auto odd = oddScratch.getWritePointer(0);
+
+		FloatVectorOperations::copy(history, state, upHistory);
+		FloatVectorOperations::copyWithMultiply(history + upHistory, input, 2.0f, numSamples);
+
+		auto x = history + upHistory;
+
+		FloatVectorOperations::copyWithMultiply(even, x, upTaps[0], numSamples);
+
+		for (int j = 1; j < upTaps.size(); j++)
+			FloatVectorOperations::addWithMultiply(even, x - j, upTaps[j], numSamples);
+
+		FloatVectorOperations::copyWithMultiply(odd, x - upCenterDelay, upCenter, numSamples);
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			output[i << 1] = even[i];
+			output[(i << 1) + 1] = odd[i];
+		}
+
+		FloatVectorOperations::copy(state, history + numSamples, upHistory);
+	}
+
+	void processDown(const float* input, float* output, float* state, int numSamples) noexcept override
+	{
+		jassert(numSamples + downHistory <= evenScratch.getNumSamples());
+
+		auto evenState = state + upHistory;
+		auto oddState = evenState + downHistory;
+
+		auto evenHistory = evenScratch.getWritePointer(0);
+		auto oddHistory = oddScratch.getWritePointer(0);
+
+		FloatVectorOperations::copy(evenHistory, evenState, downHistory);
+		FloatVectorOperations::copy(oddHistory, oddState, downCenterDelay);
+
+		auto xe = evenHistory + downHistory;
+		auto xo = oddHistory + downCenterDelay;
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			xe[i] = input[i << 1];
+			xo[i] = input[(i << 1) + 1];
+		}
+
+		FloatVectorOperations::copyWithMultiply(output, oddHistory, downCenter, numSamples);
+
+		for (int j = 0; j < downTaps.size(); j++)
+			FloatVectorOperations::addWithMultiply(output, xe - j, downTaps[j], numSamples);
+
+		FloatVectorOperations::copy(evenState, evenHistory + numSamples, downHistory);
+		FloatVectorOperations::copy(oddState, oddHistory + numSamples, downCenterDelay);
+	}
+
+	const int upHistory;
+	const int downHistory;
+	const int upCenterDelay;
+	const int downCenterDelay;
+
+	float upCenter = 0.0f;
+	float downCenter = 0.0f;
+
+	Array<float> upTaps, downTaps;
+
+	AudioSampleBuffer evenScratch, oddScratch;
+};
+
+}
+
+PolyphaseOversampler::PolyphaseOversampler(int numChannels_, int factorExponent, FilterType type, int numVoices_):
+	filterType(type),
+	numChannels(numChannels_),
+	numVoices(jmax(1, numVoices_))
+{
+	jassert(isPositiveAndBelow(factorExponent, MaxFactorExponent + 1));
+	jassert(numChannels > 0);
+
+	factorExponent = jlimit(0, MaxFactorExponent, factorExponent);
+
+	int order = 1;
+
+	for (int i = 0; i < factorExponent; i++)
+	{
+		auto& c = PolyphaseHelpers::StageCoefficients::get(type, i);
+
+		if (type == FilterType::MinimumPhase)
+			stages.add(new PolyphaseHelpers::AllpassStage(c));
+		else
+			stages.add(new PolyphaseHelpers::FIRStage(c));
+
+		order *= 2;
+		latency += stages.getLast()->getLatencyInSamples() / (float)order;
+
+		stageOffsets.add(voiceStateSize);
+		voiceStateSize += stages.getLast()->getStateSize() * numChannels;
+	}
+
+	state.calloc((size_t)jmax(1, numVoices * voiceStateSize));
+}
+
+PolyphaseOversampler::~PolyphaseOversampler()
+{
+	stages.clear();
+}
+
+void PolyphaseOversampler::initProcessing(int maxNumSamplesBeforeOversampling)
+{
+	maxBlockSize = maxNumSamplesBeforeOversampling;
+
+	stageBuffers.clear();
+
+	auto numSamples = maxBlockSize;
+
+	for (auto s : stages)
+	{
+		s->initProcessing(numSamples);
+		numSamples *= 2;
+		stageBuffers.add(new AudioSampleBuffer(numChannels, numSamples));
+	}
+
+	// The bypass mode still needs a buffer to return
+	if (stages.isEmpty())
+		stageBuffers.add(new AudioSampleBuffer(numChannels, numSamples));
+
+	reset();
+}
+
+void PolyphaseOversampler::reset() noexcept
+{
+	FloatVectorOperations::clear(state.get(), jmax(1, numVoices * voiceStateSize));
+
+	for (auto b : stageBuffers)
+		b->clear();
+}
+
+void PolyphaseOversampler::resetVoice(int voiceIndex) noexcept
+{
+	if (isPositiveAndBelow(voiceIndex, numVoices) && voiceStateSize > 0)
+		FloatVectorOperations::clear(state.get() + voiceIndex * voiceStateSize, voiceStateSize);
+}
+
+float* PolyphaseOversampler::getStateForChannel(int voiceIndex, int stageIndex, int channel) noexcept
+{
+	jassert(isPositiveAndBelow(voiceIndex, numVoices));
+
+	auto stateSize = stages.getUnchecked(stageIndex)->getStateSize();
+	return state.get() + voiceIndex * voiceStateSize + stageOffsets[stageIndex] + channel * stateSize;
+}
+
+dsp::AudioBlock<float> PolyphaseOversampler::processSamplesUp(const dsp::AudioBlock<const float>& inputBlock, int voiceIndex) noexcept
+{
+	auto numSamples = (int)inputBlock.getNumSamples();
+	auto numToProcess = jmin(numChannels, (int)inputBlock.getNumChannels());
+
+	if (stageBuffers.isEmpty() || numSamples > maxBlockSize)
+	{
+		// call initProcessing() with the correct block size
+		jassertfalse;
+		return {};
+	}
+
+	if (stages.isEmpty())
+	{
+		auto& b = *stageBuffers.getFirst();
+
+		for (int c = 0; c < numToProcess; c++)
+			FloatVectorOperations::copy(b.getWritePointer(c), inputBlock.getChannelPointer(c), numSamples);
+
+		return dsp::AudioBlock<float>(b).getSubBlock(0, numSamples);
+	}
+
+	for (int s = 0; s < stages.size(); s++)
+	{
+		auto stage = stages.getUnchecked(s);
+		auto& output = *stageBuffers.getUnchecked(s);
+
+		for (int c = 0; c < numToProcess; c++)
+		{
+			auto input = s == 0 ? inputBlock.getChannelPointer(c) : stageBuffers.getUnchecked(s - 1)->getReadPointer(c);
+			stage->processUp(input, output.getWritePointer(c), getStateForChannel(voiceIndex, s, c), numSamples);
+		}
+
+		numSamples *= 2;
+	}
+
+	return dsp::AudioBlock<float>(*stageBuffers.getLast()).getSubBlock(0, numSamples);
+}
+
+void PolyphaseOversampler::processSamplesDown(dsp::AudioBlock<float>& outputBlock, int voiceIndex) noexcept
+{
+	auto numSamples = (int)outputBlock.getNumSamples();
+	auto numToProcess = jmin(numChannels, (int)outputBlock.getNumChannels());
+
+	if (stageBuffers.isEmpty() || numSamples > maxBlockSize)
+	{
+		jassertfalse;
+		return;
+	}
+
+	if (stages.isEmpty())
+	{
+		auto& b = *stageBuffers.getFirst();
+
+		for (int c = 0; c < numToProcess; c++)
+			FloatVectorOperations::copy(outputBlock.getChannelPointer(c), b.getReadPointer(c), numSamples);
+
+		return;
+	}
+
+	for (int s = stages.size() - 1; s >= 0; s--)
+	{
+		auto stage = stages.getUnchecked(s);
+		auto& input = *stageBuffers.getUnchecked(s);
+		auto numOutput = numSamples << s;
+
+		for (int c = 0; c < numToProcess; c++)
+		{
+			auto output = s == 0 ? outputBlock.getChannelPointer(c) : stageBuffers.getUnchecked(s - 1)->getWritePointer(c);
+			stage->processDown(input.getReadPointer(c), output, getStateForChannel(voiceIndex, s, c), numOutput);
+		}
+	}
+}
+
+}
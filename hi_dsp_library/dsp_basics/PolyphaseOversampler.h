@@ -0,0 +1,125 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which also must be licenced for commercial applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+#pragma once
+
+namespace hise { using namespace juce;
+
+/** A oversampling engine built from cascaded 2x half band polyphase stages.
+
+	This class can be used as a drop-in replacement for juce::dsp::Oversampling<float>
+	(it has the same initProcessing() / processSamplesUp() / processSamplesDown() interface),
+	but it differs in a few aspects:
+
+	- the filter coefficients of every stage are designed once and shared between all
+	  instances with the same factor and filter type.
+	- the linear phase stages run the polyphase convolution block-wise using the
+	  vectorised FloatVectorOperations instead of a per-sample loop.
+	- it can hold the filter state for multiple voices in a single contiguous block.
+	  The oversampled work buffers are shared between the voices (which is fine because
+	  the voices of a synth are rendered one after another), so a polyphonic effect only
+	  needs a single instance instead of one oversampler per voice.
+
+	The MinimumPhase mode uses the same allpass coefficients as JUCE's
+	filterHalfBandPolyphaseIIR type, so the output is identical to the JUCE implementation.
+*/
+class PolyphaseOversampler
+{
+public:
+
+	static constexpr int MaxFactorExponent = 4;
+
+	enum class FilterType
+	{
+		MinimumPhase,	///< cascaded allpass IIR filters (low latency, non-linear phase)
+		LinearPhase,	///< equiripple FIR half band filters (higher latency, linear phase)
+		numFilterTypes
+	};
+
+	/** Creates a oversampler with 2^factorExponent oversampling. If numVoices is bigger than one,
+		you need to pass in the voice index to the process functions.
+	*/
+	PolyphaseOversampler(int numChannels, int factorExponent, FilterType type=FilterType::MinimumPhase, int numVoices=1);
+
+	~PolyphaseOversampler();
+
+	/** Allocates the work buffers. Call this before processing. */
+	void initProcessing(int maxNumSamplesBeforeOversampling);
+
+	/** Clears the state of all voices. */
+	void reset() noexcept;
+
+	/** Clears the state of the given voice (call this when a voice is started). */
+	void resetVoice(int voiceIndex) noexcept;
+
+	/** Returns the latency in samples (at the original samplerate). */
+	float getLatencyInSamples() const noexcept { return latency; }
+
+	int getOversamplingFactor() const noexcept { return 1 << stages.size(); }
+
+	int getNumVoices() const noexcept { return numVoices; }
+
+	FilterType getFilterType() const noexcept { return filterType; }
+
+	/** Upsamples the input and returns a block with the oversampled signal. */
+	dsp::AudioBlock<float> processSamplesUp(const dsp::AudioBlock<const float>& inputBlock, int voiceIndex=0) noexcept;
+
+	/** Downsamples the signal that was returned by the last processSamplesUp() call into the given block. */
+	void processSamplesDown(dsp::AudioBlock<float>& outputBlock, int voiceIndex=0) noexcept;
+
+	/** Returns the amount of memory used for the filter state of all voices. */
+	size_t getStateSizeInBytes() const noexcept { return (size_t)numVoices * (size_t)voiceStateSize * sizeof(float); }
+
+	struct Stage;
+
+private:
+
+	float* getStateForChannel(int voiceIndex, int stageIndex, int channel) noexcept;
+
+	const FilterType filterType;
+	const int numChannels;
+	const int numVoices;
+
+	int voiceStateSize = 0;
+	int maxBlockSize = 0;
+	float latency = 0.0f;
+
+	OwnedArray<Stage> stages;
+	Array<int> stageOffsets;
+
+	HeapBlock<float> state;
+	OwnedArray<AudioSampleBuffer> stageBuffers;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PolyphaseOversampler);
+};
+
+}
@@ -431,6 +431,143 @@ float ahdsr_base::state_base::tick()
 	return state->current_value;
 }
 
+/** Runs the recursion v = base + v * coef until isFinished returns true and returns the number of calculated samples. */
+template <typename F> static int calculateExponentialSegment(float* data, int numSamples, float& value, float base, float coef, const F& isFinished)
+{
+	for (int i = 0; i < numSamples; i++)
+	{
+		value = base + value * coef;
+		data[i] = value;
+
+		if (isFinished(value))
+			return i + 1;
+	}
+
+	return numSamples;
+}
+
+void ahdsr_base::state_base::tickBlock(float* data, int numSamples)
+{
+	const float thisSustain = envelope->sustain * modValues[3];
+
+	while (numSamples > 0)
+	{
+		int numProcessed = numSamples;
+
+		active = current_state != state_base::IDLE;
+
+		switch (current_state)
+		{
+		case state_base::IDLE:
+			FloatVectorOperations::fill(data, current_value, numSamples);
+			break;
+		case state_base::SUSTAIN:
+			current_value = thisSustain;
+			FloatVectorOperations::fill(data, current_value, numSamples);
+			break;
+		case state_base::HOLD:
+		{
+			const int numHoldSamples = jmax(0, (int)std::ceil(envelope->holdTimeSamples - (float)holdCounter) - 1);
+
+			if (numHoldSamples == 0)
+			{
+				// the transition to the decay phase happens in the same sample
+				numProcessed = 1;
+				data[0] = tick();
+				break;
+			}
+
+			numProcessed = jmin(numSamples, numHoldSamples);
+			holdCounter += numProcessed;
+			current_value = attackLevel;
+			FloatVectorOperations::fill(data, current_value, numProcessed);
+			break;
+		}
+		case state_base::ATTACK:
+		{
+			if (envelope->attack == 0.0f)
+			{
+				numProcessed = 1;
+				data[0] = tick();
+				break;
+			}
+
+			const bool rampToAttackLevel = attackLevel > thisSustain;
+			const float limit = rampToAttackLevel ? attackLevel : thisSustain;
+
+			numProcessed = calculateExponentialSegment(data, numSamples, current_value, attackBase, attackCoef, [limit](float v)
+			{
+				return v >= limit;
+			});
+
+			if (current_value >= limit)
+			{
+				current_value = limit;
+				data[numProcessed - 1] = limit;
+				holdCounter = 0;
+				current_state = rampToAttackLevel ? state_base::HOLD : state_base::SUSTAIN;
+			}
+
+			break;
+		}
+		case state_base::DECAY:
+		{
+			if (envelope->decay == 0.0f)
+			{
+				numProcessed = 1;
+				data[0] = tick();
+				break;
+			}
+
+			numProcessed = calculateExponentialSegment(data, numSamples, current_value, decayBase, decayCoef, [thisSustain](float v)
+			{
+				return FloatSanitizers::isSilence(v - thisSustain);
+			});
+
+			if (FloatSanitizers::isSilence(current_value - thisSustain))
+			{
+				lastSustainValue = current_value;
+				current_state = thisSustain == 0.0f ? state_base::IDLE : state_base::SUSTAIN;
+			}
+
+			break;
+		}
+		case state_base::RELEASE:
+		{
+			if (envelope->release == 0.0f)
+			{
+				numProcessed = 1;
+				data[0] = tick();
+				break;
+			}
+
+			numProcessed = calculateExponentialSegment(data, numSamples, current_value, releaseBase, releaseCoef, [](float v)
+			{
+				return FloatSanitizers::isSilence(v);
+			});
+
+			if (FloatSanitizers::isSilence(current_value))
+			{
+				current_value = 0.0f;
+				data[numProcessed - 1] = 0.0f;
+				current_state = state_base::IDLE;
+			}
+
+			break;
+		}
+		default:
+			numProcessed = 1;
+			data[0] = tick();
+			break;
+		}
+
+		data += numProcessed;
+		numSamples -= numProcessed;
+	}
+
+	FloatSanitizers::sanitizeFloatNumber(current_value);
+}
+
 static float ratioOrZero(double nom, double denom) { return denom != 0.0 ? nom / denom : 0.0; }
 
 float ahdsr_base::state_base::getUIPosition(double deltaMs)
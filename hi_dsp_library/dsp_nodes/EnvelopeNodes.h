@@ -246,6 +246,10 @@ struct ahdsr_base: public mothernode,
 
 		float tick();
 
+		/** Calculates the next samples. This gives the same result as calling tick() for each sample, but
+		    it calculates each segment in a single loop and fills the idle, hold and sustain segments. */
+		void tickBlock(float* data, int numSamples);
+
 		float getUIPosition(double delta);
 
 		void refreshAttackTime();
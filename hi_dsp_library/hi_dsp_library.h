@@ -153,6 +153,7 @@ Set this to 1 if you want to embed the libraries created with this module into y
 #include "dsp_basics/DelayLine.cpp"
 #include "dsp_basics/Oscillators.h"
 #include "dsp_basics/MultiChannelFilters.h"
+#include "dsp_basics/PolyphaseOversampler.h"
 
 
 #include "fft_convolver/Utilities.h"
@@ -67,6 +67,7 @@
 #include "dsp_basics/AllpassDelay.cpp"
 #include "dsp_basics/Oscillators.cpp"
 #include "dsp_basics/MultiChannelFilters.cpp"
+#include "dsp_basics/PolyphaseOversampler.cpp"
 
 #include "fft_convolver/Utilities.cpp"
 #include "fft_convolver/AudioFFT.cpp"
@@ -80,6 +81,7 @@
 #include "unit_test/wrapper_tests.cpp"
 #include "unit_test/node_tests.cpp"
 #include "unit_test/container_tests.cpp"
+#include "unit_test/oversampling_tests.cpp"
 #endif
 
 #include "dsp_nodes/CoreNodes.cpp"
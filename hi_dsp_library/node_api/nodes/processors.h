@@ -679,7 +679,7 @@ struct oversample_base
 {
 	static constexpr int MaxOversamplingExponent = 4; // => 16x oversampling (2^4).
 
-	using Oversampler = juce::dsp::Oversampling<float>;
+	using Oversampler = hise::PolyphaseOversampler;
 
 	oversample_base(int factor) :
 		oversamplingFactor(jmax(1, factor))
@@ -699,7 +699,7 @@ struct oversample_base
 
         ScopedPointer<Oversampler> newOverSampler;
         
-        newOverSampler = new Oversampler(numChannels, (int)std::log2(oversamplingFactor), Oversampler::FilterType::filterHalfBandPolyphaseIIR, false);
+        newOverSampler = new Oversampler(numChannels, (int)std::log2(oversamplingFactor), Oversampler::FilterType::MinimumPhase);
 
         if (originalBlockSize > 0)
             newOverSampler->initProcessing(originalBlockSize);
@@ -0,0 +1,193 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise
+{
+
+namespace tests
+{
+
+using namespace juce;
+
+/** Compares the PolyphaseOversampler against juce::dsp::Oversampling (output & CPU usage). */
+struct OversamplingTests : public UnitTest
+{
+	OversamplingTests() :
+		UnitTest("Testing polyphase oversampler", "dsp_tests")
+	{}
+
+	void runTest() override
+	{
+		for (int exp = 0; exp <= PolyphaseOversampler::MaxFactorExponent; exp++)
+		{
+			testAgainstJuce(PolyphaseOversampler::FilterType::MinimumPhase, exp);
+			testAgainstJuce(PolyphaseOversampler::FilterType::LinearPhase, exp);
+		}
+
+		testVoiceState();
+	}
+
+	void testAgainstJuce(PolyphaseOversampler::FilterType type, int exp)
+	{
+		const bool isMinPhase = type == PolyphaseOversampler::FilterType::MinimumPhase;
+
+		String name;
+		name << (isMinPhase ? "MinimumPhase " : "LinearPhase ") << String(1 << exp) << "x";
+
+		beginTest("Testing " + name);
+
+		using JuceOversampler = juce::dsp::Oversampling<float>;
+
+		auto juceType = isMinPhase ? JuceOversampler::FilterType::filterHalfBandPolyphaseIIR :
+									 JuceOversampler::FilterType::filterHalfBandFIREquiripple;
+
+		constexpr int BlockSize = 512;
+		constexpr int NumBlocks = 200;
+
+		JuceOversampler jos(2, exp, juceType, false);
+		PolyphaseOversampler pos(2, exp, type);
+
+		jos.initProcessing(BlockSize);
+		pos.initProcessing(BlockSize);
+
+		expectWithinAbsoluteError(pos.getLatencyInSamples(), jos.getLatencyInSamples(), 0.001f, "latency mismatch");
+
+		AudioSampleBuffer a(2, BlockSize), b(2, BlockSize);
+		auto r = getRandom();
+
+		float maxError = 0.0f;
+		double juceTime = 0.0;
+		double hiseTime = 0.0;
+
+		for (int i = 0; i < NumBlocks; i++)
+		{
+			// vary the block size to test the state handling
+			auto numSamples = BlockSize - (i % 7) * 13;
+
+			for (int c = 0; c < 2; c++)
+			{
+				for (int s = 0; s < numSamples; s++)
+				{
+					auto v = r.nextFloat() * 2.0f - 1.0f;
+					a.setSample(c, s, v);
+					b.setSample(c, s, v);
+				}
+			}
+
+			dsp::AudioBlock<float> ba(a.getArrayOfWritePointers(), 2, 0, numSamples);
+			dsp::AudioBlock<float> bb(b.getArrayOfWritePointers(), 2, 0, numSamples);
+
+			auto start = Time::getMillisecondCounterHiRes();
+			jos.processSamplesUp(ba);
+			jos.processSamplesDown(ba);
+			auto middle = Time::getMillisecondCounterHiRes();
+			pos.processSamplesUp(bb);
+			pos.processSamplesDown(bb);
+			auto end = Time::getMillisecondCounterHiRes();
+
+			juceTime += middle - start;
+			hiseTime += end - middle;
+
+			for (int c = 0; c < 2; c++)
+			{
+				for (int s = 0; s < numSamples; s++)
+					maxError = jmax(maxError, std::abs(a.getSample(c, s) - b.getSample(c, s)));
+			}
+		}
+
+		expect(maxError < 1e-5f, name + " output mismatch: " + String(maxError));
+
+		String m;
+		m << name << ": JUCE: " << String(juceTime, 2) << "ms, HISE: " << String(hiseTime, 2) << "ms";
+		logMessage(m);
+	}
+
+	void testVoiceState()
+	{
+		beginTest("Testing voice state");
+
+		constexpr int BlockSize = 64;
+
+		PolyphaseOversampler mono(1, 2, PolyphaseOversampler::FilterType::LinearPhase);
+		PolyphaseOversampler poly(1, 2, PolyphaseOversampler::FilterType::LinearPhase, 4);
+
+		mono.initProcessing(BlockSize);
+		poly.initProcessing(BlockSize);
+
+		expectEquals<int>((int)poly.getStateSizeInBytes(), 4 * (int)mono.getStateSizeInBytes(), "state size");
+
+		AudioSampleBuffer a(1, BlockSize), b(1, BlockSize);
+
+		for (int i = 0; i < 8; i++)
+		{
+			a.clear();
+			b.clear();
+			a.setSample(0, i, 1.0f);
+			b.setSample(0, i, 1.0f);
+
+			dsp::AudioBlock<float> ba(a);
+			dsp::AudioBlock<float> bb(b);
+
+			mono.processSamplesUp(ba);
+			mono.processSamplesDown(ba);
+
+			// the other voices must not affect the state of voice 2
+			for (int v = 0; v < 4; v++)
+			{
+				AudioSampleBuffer noise(1, BlockSize);
+				dsp::AudioBlock<float> bn(noise);
+				noise.clear();
+				noise.setSample(0, 0, (float)v);
+
+				if (v == 2)
+				{
+					poly.processSamplesUp(bb, v);
+					poly.processSamplesDown(bb, v);
+				}
+				else
+				{
+					poly.processSamplesUp(bn, v);
+					poly.processSamplesDown(bn, v);
+				}
+			}
+
+			for (int s = 0; s < BlockSize; s++)
+				expectWithinAbsoluteError(b.getSample(0, s), a.getSample(0, s), 1e-6f, "voice state mismatch");
+		}
+	}
+};
+
+static OversamplingTests oversamplingTests;
+
+}
+
+}
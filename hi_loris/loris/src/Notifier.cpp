@@ -79,13 +79,16 @@ static void defaultNotifierhandler( const char * s )
 //	streambuf derivative that buffers output in a std::string 
 //	and posts it to a handler (_post) when a newline is received. 
 //
+//	The string is thread local so that analyzers that run on multiple
+//	threads don't write into the same buffer.
+//
 class NotifierBuf : public streambuf
 {
 //	-- public interface --
 public:
 //	construction:
-	NotifierBuf( const std::string & s = "" ) : 
-		_str(s), _post( defaultNotifierhandler ) 
+	NotifierBuf( void ) : 
+		_post( defaultNotifierhandler ) 
 		//	confirm construction:
 		// { printf( "created a NotifierBuf.\n" ); }
 		{} 
@@ -106,6 +109,8 @@ protected:
 	//	called every time a character is written:
 	virtual int_type overflow( int_type c ) 
 	{
+		thread_local std::string _str;
+
 		if ( c == '\n' ) {
 			_post( _str.c_str() );
 			_str = "";
@@ -119,9 +124,6 @@ protected:
 	}
 	
 private:
-	//	buffer characters in a string:
-	std::string _str;
-	
 	//	handler:
 	NotificationHandler _post;
 	
@@ -16,10 +16,136 @@
  */
 
 #include "LorisState.h"
+#include "../loris/src/Analyzer.h"
 
 namespace loris2hise {
 
 LorisState* LorisState::currentInstance = nullptr;
+thread_local LorisState* LorisState::workerInstance = nullptr;
+
+struct LorisState::BatchJob
+{
+	juce::Array<juce::File> files;
+	juce::Array<double> rootFrequencies;
+	juce::File cacheDirectory;
+
+	std::atomic<int> nextIndex { 0 };
+	std::atomic<int> numFinished { 0 };
+	juce::WaitableEvent fileFinished;
+
+	// every slot is only written by the worker that picked up the file
+	std::vector<std::unique_ptr<MultichannelPartialList>> results;
+};
+
+/** A thread that picks the next file of the batch job until all files are analysed.
+
+	It uses its own LorisState so that the messages and errors are not written into the
+	state of the calling thread and its own thread controller so that the Analyzer stops
+	when the batch gets cancelled.
+*/
+struct LorisState::BatchWorker: public juce::Thread
+{
+	BatchWorker(BatchJob& job_, const Options& options, int index):
+		Thread("Loris Analysis " + juce::String(index + 1)),
+		job(job_),
+		threadController(this, &progress, 500, lastTime)
+	{
+		state.currentOption = options;
+		state.currentOption.threadController = &threadController;
+	}
+
+	void run() override
+	{
+		workerInstance = &state;
+
+		while (!threadShouldExit())
+		{
+			auto index = job.nextIndex++;
+
+			if (index >= job.files.size())
+				break;
+
+			auto f = job.files[index];
+			auto rootFrequency = job.rootFrequencies[index];
+
+			progress = 0.0;
+			state.lastError = juce::Result::ok();
+
+			auto cacheFile = getCacheFile(job.cacheDirectory, f, rootFrequency, state.currentOption);
+
+			std::unique_ptr<MultichannelPartialList> result;
+
+			if (cacheFile.existsAsFile())
+			{
+				juce::FileInputStream fis(cacheFile);
+
+				if (fis.openedOk())
+					result.reset(MultichannelPartialList::createFromStream(f.getFullPathName(), fis));
+
+				if (result != nullptr)
+				{
+					result->setOptions(state.currentOption);
+					result->saveAsOriginal();
+					state.messages.add("Load " + f.getFileName() + " from cache");
+				}
+			}
+
+			if (result == nullptr)
+			{
+				result.reset(state.analyseWithLocalAnalyzer(f, rootFrequency));
+
+				// Don't store the partials of a cancelled analysis
+				if (threadShouldExit())
+					break;
+
+				if (result != nullptr && cacheFile != juce::File())
+					writeCacheFile(*result, cacheFile);
+			}
+
+			if (result == nullptr)
+			{
+				auto error = state.lastError.failed() ? state.lastError.getErrorMessage() : juce::String("Can't read file");
+				errors.add(f.getFileName() + ": " + error);
+			}
+
+			job.results[index] = std::move(result);
+			job.numFinished++;
+			job.fileFinished.signal();
+		}
+
+		workerInstance = nullptr;
+		job.fileFinished.signal();
+	}
+
+	void writeCacheFile(const MultichannelPartialList& l, const juce::File& cacheFile)
+	{
+		juce::TemporaryFile tmp(cacheFile);
+		bool ok = false;
+
+		{
+			juce::FileOutputStream fos(tmp.getFile());
+
+			if (fos.openedOk())
+			{
+				l.writeToStream(fos);
+				fos.flush();
+				ok = fos.getStatus().wasOk();
+			}
+		}
+
+		if (ok)
+			tmp.overwriteTargetFileWithTemporary();
+	}
+
+	BatchJob& job;
+
+	double progress = 0.0;
+	juce::uint32 lastTime = 0;
+	hise::ThreadController threadController;
+
+	LorisState state;
+	juce::StringArray errors;
+};
 
 LorisState::LorisState() :
 	lastError(juce::Result::ok())
@@ -36,6 +162,9 @@ LorisState::~LorisState()
 
 LorisState* LorisState::getCurrentInstance(bool forceCreate /*= false*/)
 {
+	if (workerInstance != nullptr && !forceCreate)
+		return workerInstance;
+
 	if (currentInstance == nullptr || forceCreate)
 		currentInstance = new LorisState();
 
@@ -84,8 +213,6 @@ bool LorisState::analyse(const juce::File& audioFile, double rootFrequency)
 			}
 		}
 	}
-	juce::AudioFormatManager m;
-	m.registerBasicFormats();
 
     auto driftFactor = std::pow(2.0, currentOption.freqdrift / 1200.0);
     
@@ -104,11 +231,159 @@ bool LorisState::analyse(const juce::File& audioFile, double rootFrequency)
 	analyzer_setHopTime(currentOption.hoptime);
 	analyzer_setCropTime(currentOption.croptime);
 
+	if (auto newEntry = createPartialList(audioFile, rootFrequency, [](const double* buffer, int numSamples, double sampleRate, PartialList* list)
+	{
+		analyze(buffer, numSamples, sampleRate, list);
+	}))
+	{
+		analysedFiles.add(newEntry);
+
+		messages.add("... Analysed OK");
+		return true;
+	}
+
+	return false;
+}
+
+bool LorisState::analyseBatch(const juce::Array<juce::File>& audioFiles, const juce::Array<double>& rootFrequencies, int numThreads, const juce::File& cacheDirectory)
+{
+	if (audioFiles.size() != rootFrequencies.size())
+	{
+		lastError = juce::Result::fail("The number of root frequencies doesn't match the number of files");
+		return false;
+	}
+
+	if (audioFiles.isEmpty())
+		return true;
+
+	if (!currentOption.initialised)
+	{
+		// initialise the options with the same values as analyse()
+		analyzer_configure(rootFrequencies[0] * 0.8, rootFrequencies[0] * currentOption.windowwidth, nullptr);
+		currentOption.initLorisParameters();
+		currentOption.initialised = true;
+	}
+
+	BatchJob job;
+
+	for (int i = 0; i < audioFiles.size(); i++)
+	{
+		if (currentOption.enablecache && getExisting(audioFiles[i]) != nullptr)
+		{
+			messages.add("Skip " + audioFiles[i].getFileName());
+			continue;
+		}
+
+		job.files.add(audioFiles[i]);
+		job.rootFrequencies.add(rootFrequencies[i]);
+	}
+
+	auto numFiles = job.files.size();
+
+	if (numFiles == 0)
+		return true;
+
+	job.results.resize(numFiles);
+
+	if (cacheDirectory != juce::File() && cacheDirectory.createDirectory())
+		job.cacheDirectory = cacheDirectory;
+
+	if (numThreads <= 0)
+		numThreads = juce::SystemStats::getNumCpus();
+
+	numThreads = juce::jlimit(1, numFiles, numThreads);
+
+	messages.add("Analyse " + juce::String(numFiles) + " files with " + juce::String(numThreads) + " threads");
+
+	// The workers are created on this thread because the LorisState constructor sets the global loris handlers
+	juce::OwnedArray<BatchWorker> workers;
+
+	for (int i = 0; i < numThreads; i++)
+		workers.add(new BatchWorker(job, currentOption, i));
+
+	for (auto w : workers)
+		w->startThread();
+
+	auto tc = currentOption.threadController;
+	bool cancelled = false;
+
+	auto isRunning = [&workers]()
+	{
+		for (auto w : workers)
+		{
+			if (w->isThreadRunning())
+				return true;
+		}
+
+		return false;
+	};
+
+	while (job.numFinished.load() < numFiles && isRunning())
+	{
+		if (tc != nullptr && !tc->setProgress((double)job.numFinished.load() / (double)numFiles))
+		{
+			cancelled = true;
+			break;
+		}
+
+		job.fileFinished.wait(100);
+	}
+
+	for (auto w : workers)
+	{
+		if (cancelled)
+			w->signalThreadShouldExit();
+
+		w->waitForThreadToExit(-1);
+	}
+
+	juce::StringArray errors;
+
+	for (auto w : workers)
+	{
+		messages.addArray(w->state.messages);
+		errors.addArray(w->errors);
+	}
+
+	for (int i = 0; i < numFiles; i++)
+	{
+		if (auto& r = job.results[i])
+		{
+			if (auto existing = getExisting(job.files[i]))
+				analysedFiles.removeObject(existing);
+
+			// the worker options point to the thread controller of the worker
+			r->setOptions(currentOption);
+			analysedFiles.add(r.release());
+		}
+	}
+
+	if (cancelled)
+	{
+		messages.add("... Batch analysis cancelled");
+		return false;
+	}
+
+	if (!errors.isEmpty())
+	{
+		lastError = juce::Result::fail(errors.joinIntoString("\n"));
+		return false;
+	}
+
+	messages.add("... Analysed " + juce::String(numFiles) + " files OK");
+	return true;
+}
+
+MultichannelPartialList* LorisState::createPartialList(const juce::File& audioFile, double rootFrequency, const std::function<void(const double*, int, double, PartialList*)>& analyseChannel)
+{
+	juce::AudioFormatManager m;
+	m.registerBasicFormats();
+
 	if (juce::ScopedPointer<juce::AudioFormatReader> r = m.createReaderFor(audioFile))
 	{
 		messages.add("Analyse " + audioFile.getFileName());
 
-		auto newEntry = new MultichannelPartialList(audioFile.getFullPathName(), r->numChannels);
+		std::unique_ptr<MultichannelPartialList> newEntry(new MultichannelPartialList(audioFile.getFullPathName(), r->numChannels));
 
 		newEntry->setMetadata(r, rootFrequency);
 		newEntry->setOptions(currentOption);
@@ -126,27 +401,110 @@ bool LorisState::analyse(const juce::File& audioFile, double rootFrequency)
 			if (auto s = hise::ThreadController::ScopedStepScaler(currentOption.threadController, c, bf.getNumChannels()))
 			{
 				if (!s)
-					return false;
+					return nullptr;
 
 				for (int i = 0; i < bf.getNumSamples(); i++)
 					buffer[i] = bf.getSample(c, i);
 
-				auto list = newEntry->get(c);
-
-				analyze(buffer, bf.getNumSamples(), r->sampleRate, list);
+				analyseChannel(buffer, bf.getNumSamples(), r->sampleRate, newEntry->get(c));
 			}
 		}
 
 		newEntry->saveAsOriginal();
         //newEntry->prepareToMorph();
-        
-		analysedFiles.add(newEntry);
 
-		messages.add("... Analysed OK");
-		return true;
+		return newEntry.release();
 	}
 
-	return false;
+	return nullptr;
+}
+
+MultichannelPartialList* LorisState::analyseWithLocalAnalyzer(const juce::File& audioFile, double rootFrequency)
+{
+	// Use the same configuration as analyse(), but with an Analyzer that isn't shared with other threads
+	try
+	{
+		Loris::Analyzer analyzer(rootFrequency * 0.8, rootFrequency * currentOption.windowwidth);
+
+		analyzer.threadController = currentOption.threadController;
+		analyzer.setFreqDrift(rootFrequency * 0.25);
+		analyzer.storeNoBandwidth();
+		analyzer.setHopTime(currentOption.hoptime);
+		analyzer.setCropTime(currentOption.croptime);
+
+		return createPartialList(audioFile, rootFrequency, [&analyzer](const double* buffer, int numSamples, double sampleRate, PartialList* list)
+		{
+			if (numSamples > 0)
+			{
+				analyzer.analyze(buffer, buffer + numSamples, sampleRate);
+				list->splice(list->end(), analyzer.partials());
+			}
+		});
+	}
+	catch (std::exception& e)
+	{
+		reportError(e.what());
+	}
+
+	return nullptr;
+}
+
+juce::File LorisState::getCacheFile(const juce::File& cacheDirectory, const juce::File& audioFile, double rootFrequency, const Options& options)
+{
+	if (!cacheDirectory.isDirectory())
+		return {};
+
+	juce::FileInputStream fis(audioFile);
+
+	if (!fis.openedOk())
+		return {};
+
+	// FNV-1a hash of the file content (so moving the samples doesn't invalidate the cache)
+	auto hash = [](juce::uint64 h, const juce::uint8* data, int numBytes)
+	{
+		for (int i = 0; i < numBytes; i++)
+		{
+			h ^= data[i];
+			h *= 1099511628211ull;
+		}
+
+		return h;
+	};
+
+	constexpr juce::uint64 offset = 14695981039346656037ull;
+	constexpr int BufferSize = 65536;
+
+	juce::HeapBlock<juce::uint8> buffer(BufferSize);
+	auto fileHash = offset;
+
+	for (;;)
+	{
+		auto numRead = fis.read(buffer, BufferSize);
+
+		if (numRead <= 0)
+			break;
+
+		fileHash = hash(fileHash, buffer, numRead);
+	}
+
+	// all options that change the analysis result
+	juce::String optionString;
+	optionString << juce::String(rootFrequency, 9) << ";";
+	optionString << juce::String(options.windowwidth, 9) << ";";
+	optionString << juce::String(options.freqfloor, 9) << ";";
+	optionString << juce::String(options.ampfloor, 9) << ";";
+	optionString << juce::String(options.sidelobes, 9) << ";";
+	optionString << juce::String(options.freqdrift, 9) << ";";
+	optionString << juce::String(options.hoptime, 9) << ";";
+	optionString << juce::String(options.croptime, 9) << ";";
+	optionString << juce::String(options.bwregionwidth, 9);
+
+	auto optionHash = hash(offset, reinterpret_cast<const juce::uint8*>(optionString.toRawUTF8()), (int)optionString.getNumBytesAsUTF8());
+
+	juce::String fileName;
+	fileName << juce::String::toHexString((juce::int64)fileHash) << "_" << juce::String::toHexString((juce::int64)optionHash) << ".partials";
+
+	return cacheDirectory.getChildFile(fileName);
 }
 
 double LorisState::getOption(const juce::Identifier &id) const
@@ -43,6 +43,19 @@ struct LorisState
     void reportError(const char* msg);
     
     bool analyse(const juce::File& audioFile, double rootFrequency);
+
+    /** Analyses multiple files on a pool of worker threads.
+
+        Every worker uses its own LorisState and Loris::Analyzer instance so they don't share the global state of the procedural
+        analyzer. The calling thread waits until all files are analysed and reports the progress (and checks for cancellation) through
+        the thread controller. If the cache directory is a valid directory, the partials will be stored there with a key that is
+        created from the file content and the analysis options, so the next call with the same file and options skips the analysis.
+
+        - numThreads: the number of worker threads. If this is zero or negative, it uses all CPU cores.
+
+        Returns false if one of the files could not be analysed or the batch was cancelled.
+    */
+    bool analyseBatch(const juce::Array<juce::File>& audioFiles, const juce::Array<double>& rootFrequencies, int numThreads, const juce::File& cacheDirectory);
     
     bool setOption(const juce::Identifier& id, const juce::var& data);
     
@@ -75,6 +88,15 @@ struct LorisState
 private:
 
     friend struct Helpers;
+
+    struct BatchJob;
+    struct BatchWorker;
+
+    MultichannelPartialList* createPartialList(const juce::File& audioFile, double rootFrequency, const std::function<void(const double*, int, double, PartialList*)>& analyseChannel);
+
+    MultichannelPartialList* analyseWithLocalAnalyzer(const juce::File& audioFile, double rootFrequency);
+
+    static juce::File getCacheFile(const juce::File& cacheDirectory, const juce::File& audioFile, double rootFrequency, const Options& options);
     
     Options currentOption;
 
@@ -86,6 +108,9 @@ private:
     
 	static LorisState* currentInstance;
 
+	/** The state of the batch worker that runs on the current thread. */
+	static thread_local LorisState* workerInstance;
+
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LorisState);
 };
 
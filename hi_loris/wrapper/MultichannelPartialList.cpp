@@ -122,6 +122,94 @@ void MultichannelPartialList::saveAsOriginal()
 	jassert(list.size() == original.size());
 }
 
+static constexpr int CacheFileVersion = 1;
+static constexpr int CacheFileEndMarker = 0x4c4f5253;
+
+void MultichannelPartialList::writeToStream(juce::OutputStream& output) const
+{
+	output.writeInt(CacheFileVersion);
+	output.writeInt(list.size());
+	output.writeInt(numSamples);
+	output.writeDouble(sampleRate);
+	output.writeDouble(rootFrequency);
+
+	for (auto l : list)
+	{
+		output.writeInt((int)l->size());
+
+		for (const auto& p : *l)
+		{
+			output.writeInt(p.label());
+			output.writeInt((int)p.numBreakpoints());
+
+			for (auto iter = p.begin(); iter != p.end(); ++iter)
+			{
+				const auto& b = iter.breakpoint();
+
+				output.writeDouble(iter.time());
+				output.writeDouble(b.frequency());
+				output.writeDouble(b.amplitude());
+				output.writeDouble(b.bandwidth());
+				output.writeDouble(b.phase());
+			}
+		}
+	}
+
+	output.writeInt(CacheFileEndMarker);
+}
+
+MultichannelPartialList* MultichannelPartialList::createFromStream(const juce::String& name, juce::InputStream& input)
+{
+	if (input.readInt() != CacheFileVersion)
+		return nullptr;
+
+	auto numChannels = input.readInt();
+
+	if (!isPositiveAndBelow(numChannels, 256))
+		return nullptr;
+
+	std::unique_ptr<MultichannelPartialList> newEntry(new MultichannelPartialList(name, numChannels));
+
+	newEntry->numSamples = input.readInt();
+	newEntry->sampleRate = input.readDouble();
+	newEntry->rootFrequency = input.readDouble();
+
+	for (auto l : newEntry->list)
+	{
+		auto numPartials = input.readInt();
+
+		for (int i = 0; i < numPartials; i++)
+		{
+			if (input.isExhausted())
+				return nullptr;
+
+			Partial p;
+			p.setLabel(input.readInt());
+
+			auto numBreakpoints = input.readInt();
+
+			for (int j = 0; j < numBreakpoints; j++)
+			{
+				auto time = input.readDouble();
+				auto frequency = input.readDouble();
+				auto amplitude = input.readDouble();
+				auto bandwidth = input.readDouble();
+				auto phase = input.readDouble();
+
+				p.insert(time, Breakpoint(frequency, amplitude, bandwidth, phase));
+			}
+
+			l->push_back(p);
+		}
+	}
+
+	// A truncated file will return zero for every read after the end
+	if (input.readInt() != CacheFileEndMarker)
+		return nullptr;
+
+	return newEntry.release();
+}
+
 void MultichannelPartialList::checkArgs(bool condition, const juce::String& error, const std::function<void()>& additionalCleanupFunction /*= {}*/)
 {
 	if (!condition)
@@ -108,6 +108,12 @@ struct MultichannelPartialList
     /** @internal */
 	void saveAsOriginal();
 
+    /** @internal Writes the metadata and the partials of all channels to the stream (used by the analysis cache). */
+	void writeToStream(juce::OutputStream& output) const;
+
+    /** @internal Creates a partial list from the data written by writeToStream(). Returns nullptr if the data is invalid. */
+	static MultichannelPartialList* createFromStream(const juce::String& name, juce::InputStream& input);
+
     bool prepareToMorph(bool removeUnlabeled=false);
     
 private:
@@ -70,6 +70,46 @@ bool LorisLibrary::loris_analyze(void* state, char* file, double rootFrequency)
 	return typed->analyse(f, rootFrequency);
 }
 
+bool LorisLibrary::loris_analyze_batch(void* state, const char* json)
+{
+	loris2hise::LorisState::resetState(state);
+
+	auto typed = (loris2hise::LorisState*)state;
+
+	auto data = juce::JSON::parse(juce::String(json));
+
+	juce::Array<juce::File> files;
+	juce::Array<double> rootFrequencies;
+
+	if (auto list = data["files"].getArray())
+	{
+		for (const auto& item : *list)
+		{
+			auto path = item["file"].toString();
+
+			if (!juce::File::isAbsolutePath(path))
+			{
+				juce::String msg;
+				msg << "Invalid file path: " << path;
+				typed->reportError(msg.getCharPointer().getAddress());
+				return false;
+			}
+
+			files.add(juce::File(path));
+			rootFrequencies.add((double)item["rootFrequency"]);
+		}
+	}
+
+	juce::File cacheDirectory;
+
+	auto cachePath = data["cacheDirectory"].toString();
+
+	if (juce::File::isAbsolutePath(cachePath))
+		cacheDirectory = juce::File(cachePath);
+
+	return typed->analyseBatch(files, rootFrequencies, (int)data["numThreads"], cacheDirectory);
+}
+
 bool LorisLibrary::loris_process(void* state, const char* file, const char* command, const char* json)
 {
 	loris2hise::LorisState::resetState(state);
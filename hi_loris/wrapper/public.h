@@ -56,6 +56,24 @@ struct LorisLibrary
 	*/
 	static bool loris_analyze(void* state, char* file, double rootFrequency);
 
+	/** Analyses multiple files on a pool of worker threads.
+
+	    - state the state context created with createLorisState().
+	    - json a JSON object with the batch properties:
+
+	    {
+	      "files": [ { "file": "C:/path/to/file.wav", "rootFrequency": 440.0 } ],
+	      "numThreads": 0,             // the number of worker threads (0 = all CPU cores)
+	      "cacheDirectory": "C:/cache" // an optional directory for caching the analysis result
+	    }
+
+	    Every worker thread uses its own loris analyzer. The progress and the cancellation is handled through
+	    the thread controller passed into setThreadController(). The partials of every file will be stored in
+	    the cache directory using the hash of the file content and the analysis options, so analysing a file
+	    again with the same options will load the partials from the cache.
+	*/
+	static bool loris_analyze_batch(void* state, const char* json);
+
 	/** Processes the analyzed partials with a predefined function.
 	 
 	    - state: the state context pointer
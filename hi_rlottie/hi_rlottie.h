@@ -79,6 +79,15 @@ END_JUCE_MODULE_DECLARATION
 #define HISE_RLOTTIE_DYNAMIC_LIBRARY 0
 #endif
 
+/** Config: HISE_RLOTTIE_FRAME_CACHE_MB
+
+    The memory limit (in megabytes) for the rendered frames of all Lottie animations.
+    Set this to zero to disable the frame cache and render every frame on the message thread.
+*/
+#ifndef HISE_RLOTTIE_FRAME_CACHE_MB
+#define HISE_RLOTTIE_FRAME_CACHE_MB 64
+#endif
+
 #if HISE_INCLUDE_RLOTTIE
 #include "include/rlottie_capi.h"
 #include "wrapper/RLottieManager.h"
@@ -13,8 +13,40 @@
 namespace hise {
 using namespace juce;
 
+struct RLottieAnimation::PrerenderJob: public ThreadPoolJob
+{
+	PrerenderJob(RLottieAnimation& parent_):
+		ThreadPoolJob("Prerender Lottie frames"),
+		parent(parent_)
+	{}
+
+	JobStatus runJob() override
+	{
+		auto& cache = parent.manager->getFrameCache();
+
+		for (int i = 0; i < parent.numFrames; i++)
+		{
+			if (shouldExit())
+				break;
+
+			if (cache.containsFrame(&parent, i, width, height))
+				continue;
+
+			if (!cache.addFrame(&parent, i, parent.renderFrame(i, width, height), false))
+				break;
+		}
 
-RLottieAnimation::RLottieAnimation(RLottieManager* manager, const String& data)
+		return jobHasFinished;
+	}
+
+	RLottieAnimation& parent;
+	int width = 0;
+	int height = 0;
+};
+
+
+RLottieAnimation::RLottieAnimation(RLottieManager* manager_, const String& data):
+	manager(manager_)
 {
 	animation = manager->createAnimation(RLottieComponent::decompressIfBase64(data));
     
@@ -28,6 +60,12 @@ RLottieAnimation::RLottieAnimation(RLottieManager* manager, const String& data)
 
 RLottieAnimation::~RLottieAnimation()
 {
+	if (manager != nullptr)
+	{
+		stopPrerendering();
+		manager->getFrameCache().removeFrames(this);
+	}
+
 	if (manager != nullptr && animation != nullptr)
 		manager->destroy(animation);
 }
@@ -42,7 +80,17 @@ void RLottieAnimation::setSize(int width, int height)
 
 	if (newWidth != canvas.getWidth() || newHeight != canvas.getHeight())
 	{
+		// The running job would add frames with the old size after the purge
+		stopPrerendering();
+
 		canvas = Image(Image::ARGB, newWidth, newHeight, true);
+		lastFrame = -1;
+
+		if (manager != nullptr)
+			manager->getFrameCache().removeFrames(this);
+
+		if (prerenderRequested)
+			prerenderFrames();
 	}
 }
 
@@ -60,13 +108,38 @@ void RLottieAnimation::render(Graphics& g, Point<int> topLeft)
 {
 	if (isValid() && isPositiveAndBelow(currentFrame, numFrames+1) && lastFrame != currentFrame)
 	{
-		Image::BitmapData bd(canvas, Image::BitmapData::ReadWriteMode::writeOnly);
+		auto w = canvas.getWidth();
+		auto h = canvas.getHeight();
+
+		if (isFrameCacheEnabled())
+		{
+			auto& cache = manager->getFrameCache();
+
+			auto frame = cache.getFrame(this, currentFrame, w, h);
+
+			if (!frame.isValid())
+			{
+				frame = renderFrame(currentFrame, w, h);
+				cache.addFrame(this, currentFrame, frame, true);
+			}
+
+			// the canvas now shares the pixel data with the cache, so it must not be rendered into
+			canvas = frame;
+		}
+		else
+		{
+			if (canvas.getReferenceCount() > 1)
+				canvas = Image(Image::ARGB, w, h, true);
+
+			ScopedLock sl(renderLock);
+			Image::BitmapData bd(canvas, Image::BitmapData::ReadWriteMode::writeOnly);
 
 #if HISE_RLOTTE_DYNAMIC_LIBRARY
-		rf(animation, (size_t)currentFrame, reinterpret_cast<uint32*>(bd.data), canvas.getWidth(), canvas.getHeight(), canvas.getWidth() * 4);
+			rf(animation, (size_t)currentFrame, reinterpret_cast<uint32*>(bd.data), w, h, w * 4);
 #else
-        lottie_animation_render(animation, (size_t)currentFrame, reinterpret_cast<uint32*>(bd.data), canvas.getWidth(), canvas.getHeight(), canvas.getWidth() * 4);
+			lottie_animation_render(animation, (size_t)currentFrame, reinterpret_cast<uint32*>(bd.data), w, h, w * 4);
 #endif
+		}
 
 		lastFrame = currentFrame;
 	}
@@ -104,6 +177,57 @@ int RLottieAnimation::getCurrentFrame() const
 	return currentFrame;
 }
 
+void RLottieAnimation::prerenderFrames()
+{
+	prerenderRequested = true;
+
+	if (!isFrameCacheEnabled())
+		return;
+
+	auto& pool = manager->getRenderPool();
+
+	if (prerenderJob == nullptr)
+		prerenderJob = new PrerenderJob(*this);
+	else
+		pool.removeJob(prerenderJob, true, -1);
+
+	prerenderJob->width = canvas.getWidth();
+	prerenderJob->height = canvas.getHeight();
+
+	pool.addJob(prerenderJob, false);
+}
+
+void RLottieAnimation::stopPrerendering()
+{
+	if (manager != nullptr && prerenderJob != nullptr)
+		manager->getRenderPool().removeJob(prerenderJob, true, -1);
+}
+
+Image RLottieAnimation::renderFrame(int frameIndex, int width, int height)
+{
+	Image frame(Image::ARGB, width, height, true, SoftwareImageType());
+
+	// the same animation might be rendered on the message thread and the prerender thread
+	ScopedLock sl(renderLock);
+
+	{
+		Image::BitmapData bd(frame, Image::BitmapData::ReadWriteMode::writeOnly);
+
+#if HISE_RLOTTE_DYNAMIC_LIBRARY
+		rf(animation, (size_t)frameIndex, reinterpret_cast<uint32*>(bd.data), width, height, width * 4);
+#else
+		lottie_animation_render(animation, (size_t)frameIndex, reinterpret_cast<uint32*>(bd.data), width, height, width * 4);
+#endif
+	}
+
+	return frame;
+}
+
+bool RLottieAnimation::isFrameCacheEnabled() const
+{
+	return isValid() && manager != nullptr && manager->getFrameCache().getMemoryLimit() > 0;
+}
+
 void RLottieAnimation::setScaleFactor(float newScaleFactor)
 {
 	if (scaleFactor != newScaleFactor)
@@ -114,4 +238,120 @@ void RLottieAnimation::setScaleFactor(float newScaleFactor)
 	}
 }
 
+#if HI_RUN_UNIT_TESTS
+
+/** Checks that drawn frames are served from the frame cache and that prerendering fills it. */
+class RLottieFrameCacheTest : public UnitTest
+{
+public:
+
+	RLottieFrameCacheTest() :
+		UnitTest("Testing Lottie frame cache")
+	{}
+
+	void runTest() override
+	{
+		TestManager m;
+
+		testCacheHit(m);
+		testPrerendering(m);
+	}
+
+private:
+
+	struct TestManager : public RLottieManager
+	{
+		File getLibraryFolder() const override { return {}; }
+	};
+
+	/** A 10 frame animation with a single red solid layer. */
+	static String getTestAnimation()
+	{
+		return R"({"v":"5.5.2","fr":30,"ip":0,"op":10,"w":32,"h":32,"nm":"test","ddd":0,"assets":[],)"
+			   R"("layers":[{"ddd":0,"ind":1,"ty":1,"nm":"solid","sr":1,"ks":{"o":{"a":0,"k":100},"r":{"a":0,"k":0},)"
+			   R"("p":{"a":0,"k":[16,16,0]},"a":{"a":0,"k":[16,16,0]},"s":{"a":0,"k":[100,100,100]}},)"
+			   R"("ao":0,"sw":32,"sh":32,"sc":"#ff0000","ip":0,"op":10,"st":0,"bm":0}]})";
+	}
+
+	static void renderFrame(RLottieAnimation& a, int frameIndex)
+	{
+		Image target(Image::ARGB, 32, 32, true);
+		Graphics g(target);
+
+		a.setFrame(frameIndex);
+		a.render(g, {});
+	}
+
+	void testCacheHit(RLottieManager& m)
+	{
+		beginTest("Testing cache hit for a drawn frame");
+
+		auto ok = m.init();
+		expect(ok.wasOk(), ok.getErrorMessage());
+
+		auto& cache = m.getFrameCache();
+
+		RLottieAnimation a(&m, getTestAnimation());
+		a.setSize(32, 32);
+
+		expect(a.isValid(), "animation can't be parsed");
+		expect(cache.getMemoryLimit() > 0, "frame cache is disabled");
+
+		auto numHits = cache.getNumHits();
+		auto numMisses = cache.getNumMisses();
+
+		renderFrame(a, 2);
+
+		expectEquals(cache.getNumMisses(), numMisses + 1, "first render wasn't a cache miss");
+		expect(cache.containsFrame(&a, 2, 32, 32), "drawn frame wasn't added to the cache");
+
+		// the animation skips rendering if the frame didn't change, so draw another one in between
+		renderFrame(a, 3);
+		renderFrame(a, 2);
+
+		expectEquals(cache.getNumHits(), numHits + 1, "second render of the same frame wasn't a cache hit");
+		expectEquals(cache.getNumMisses(), numMisses + 2, "second render of the same frame was rendered again");
+	}
+
+	void testPrerendering(RLottieManager& m)
+	{
+		beginTest("Testing prerendering");
+
+		auto& cache = m.getFrameCache();
+
+		RLottieAnimation a(&m, getTestAnimation());
+		a.setSize(32, 32);
+		a.prerenderFrames();
+
+		auto allFramesCached = [&]()
+		{
+			for (int i = 0; i < a.getNumFrames(); i++)
+			{
+				if (!cache.containsFrame(&a, i, 32, 32))
+					return false;
+			}
+
+			return true;
+		};
+
+		auto timeout = Time::getMillisecondCounter() + 5000;
+
+		while (!allFramesCached() && Time::getMillisecondCounter() < timeout)
+			Thread::sleep(10);
+
+		expect(a.getNumFrames() > 0, "animation has no frames");
+		expect(allFramesCached(), "prerendering didn't fill the cache");
+
+		auto numMisses = cache.getNumMisses();
+
+		renderFrame(a, 5);
+
+		expectEquals(cache.getNumMisses(), numMisses, "prerendered frame wasn't found in the cache");
+	}
+};
+
+static RLottieFrameCacheTest rLottieFrameCacheTest;
+
+#endif
+
 }
@@ -24,7 +24,7 @@ public:
 	using Ptr = WeakReference<RLottieAnimation>;
 
 	/** Creates a new RLottieAnimation from the given JSON data string. */
-	RLottieAnimation(RLottieManager* manager, const String& data);
+	RLottieAnimation(RLottieManager* manager_, const String& data);
 
 	~RLottieAnimation();
 
@@ -52,8 +52,29 @@ public:
 	/** Set a scale factor that is applied to the internal canvas. */
 	void setScaleFactor(float newScaleFactor);
 
+	/** Renders all frames on the background thread of the manager and stores them in its frame cache.
+
+		It stops when the cache is full (so it never removes frames of other animations) and starts again
+		when the size or the scale factor changes. Frames that are not prerendered will be cached when they
+		are drawn the first time.
+	*/
+	void prerenderFrames();
+
 private:
 
+	struct PrerenderJob;
+
+	Image renderFrame(int frameIndex, int width, int height);
+
+	/** Removes the prerender job from the pool and waits until it has finished. */
+	void stopPrerendering();
+
+	bool isFrameCacheEnabled() const;
+
+	CriticalSection renderLock;
+	ScopedPointer<PrerenderJob> prerenderJob;
+	bool prerenderRequested = false;
+
 	int originalWidth = 0;
 	int originalHeight = 0;
 	float scaleFactor = 1.0f;
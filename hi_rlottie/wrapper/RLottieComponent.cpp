@@ -69,6 +69,7 @@ void RLottieComponent::loadAnimation(const String& jsonCode, bool useOversamplin
 	currentFrame = 0;
 
 	resized();
+	currentAnimation->prerenderFrames();
 	repaint();
 }
 
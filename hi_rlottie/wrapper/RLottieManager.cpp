@@ -16,11 +16,126 @@ using namespace juce;
 
 
 RLottieManager::RLottieManager():
-	lastResult(Result::fail("This Manager is not initialised. Call init() before using it"))
+	lastResult(Result::fail("This Manager is not initialised. Call init() before using it")),
+	renderPool(1)
 {
 	
 }
 
+juce::Image RLottieManager::FrameCache::getFrame(const void* animation, int frameIndex, int width, int height)
+{
+	ScopedLock sl(lock);
+
+	auto e = entries.find({ animation, frameIndex });
+
+	if (e != entries.end() && e->second.frame.getWidth() == width && e->second.frame.getHeight() == height)
+	{
+		e->second.lastAccess = ++accessCounter;
+		numHits++;
+		return e->second.frame;
+	}
+
+	numMisses++;
+
+	return {};
+}
+
+bool RLottieManager::FrameCache::containsFrame(const void* animation, int frameIndex, int width, int height) const
+{
+	ScopedLock sl(lock);
+
+	auto e = entries.find({ animation, frameIndex });
+
+	return e != entries.end() && e->second.frame.getWidth() == width && e->second.frame.getHeight() == height;
+}
+
+bool RLottieManager::FrameCache::addFrame(const void* animation, int frameIndex, const Image& frame, bool allowEviction)
+{
+	ScopedLock sl(lock);
+
+	auto numBytes = getNumBytes(frame);
+	auto key = Key(animation, frameIndex);
+
+	if (!frame.isValid() || numBytes > memoryLimit)
+		return false;
+
+	auto e = entries.find(key);
+
+	if (e != entries.end())
+	{
+		memoryUsage -= getNumBytes(e->second.frame);
+		entries.erase(e);
+	}
+
+	if (memoryUsage + numBytes > memoryLimit)
+	{
+		if (!allowEviction)
+			return false;
+
+		removeLeastRecentlyUsed(memoryUsage + numBytes - memoryLimit);
+	}
+
+	auto& newEntry = entries[key];
+	newEntry.frame = frame;
+	newEntry.lastAccess = ++accessCounter;
+	memoryUsage += numBytes;
+
+	return true;
+}
+
+void RLottieManager::FrameCache::removeFrames(const void* animation)
+{
+	ScopedLock sl(lock);
+
+	for (auto it = entries.begin(); it != entries.end();)
+	{
+		if (it->first.first == animation)
+		{
+			memoryUsage -= getNumBytes(it->second.frame);
+			it = entries.erase(it);
+		}
+		else
+			++it;
+	}
+}
+
+void RLottieManager::FrameCache::setMemoryLimit(size_t numBytes)
+{
+	ScopedLock sl(lock);
+
+	memoryLimit = numBytes;
+
+	if (memoryUsage > memoryLimit)
+		removeLeastRecentlyUsed(memoryUsage - memoryLimit);
+}
+
+void RLottieManager::FrameCache::removeLeastRecentlyUsed(size_t numBytesToFree)
+{
+	// Collect the entries sorted by their access time so that a single pass is enough
+	std::vector<std::pair<uint32, Key>> accessList;
+	accessList.reserve(entries.size());
+
+	for (const auto& e : entries)
+		accessList.push_back({ e.second.lastAccess, e.first });
+
+	std::sort(accessList.begin(), accessList.end());
+
+	size_t numFreed = 0;
+
+	for (const auto& a : accessList)
+	{
+		if (numFreed >= numBytesToFree)
+			break;
+
+		auto e = entries.find(a.second);
+		auto numBytes = getNumBytes(e->second.frame);
+
+		numFreed += numBytes;
+		memoryUsage -= numBytes;
+		entries.erase(e);
+	}
+}
+
 juce::Result RLottieManager::init()
 {
 	lastResult = Result::ok();
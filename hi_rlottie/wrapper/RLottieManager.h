@@ -41,6 +41,71 @@ public:
 	/** Returns the result of the initialisation. */
 	Result getInitResult() const { return lastResult; }
 
+	/** A memory bounded cache for the rendered frames of all animations that use this manager.
+
+		The frames are stored with the size of the animation canvas (so the scale factor is
+		baked in). If the cache is full, the frames that weren't drawn for the longest time
+		are removed.
+	*/
+	class FrameCache
+	{
+	public:
+
+		/** Returns the frame or an invalid image if the frame isn't cached with the given size. */
+		Image getFrame(const void* animation, int frameIndex, int width, int height);
+
+		/** Checks whether the frame is cached without updating its access time. */
+		bool containsFrame(const void* animation, int frameIndex, int width, int height) const;
+
+		/** Adds the frame to the cache. If allowEviction is false, it will only be added if it fits into the free space. */
+		bool addFrame(const void* animation, int frameIndex, const Image& frame, bool allowEviction);
+
+		/** Removes all frames of the given animation. */
+		void removeFrames(const void* animation);
+
+		/** Sets the memory limit in bytes. Zero disables the cache. */
+		void setMemoryLimit(size_t numBytes);
+
+		size_t getMemoryLimit() const { return memoryLimit; }
+
+		size_t getMemoryUsage() const { return memoryUsage; }
+
+		/** Returns the number of getFrame() calls that found the frame in the cache. */
+		int64 getNumHits() const { return numHits; }
+
+		/** Returns the number of getFrame() calls that didn't find the frame in the cache. */
+		int64 getNumMisses() const { return numMisses; }
+
+	private:
+
+		using Key = std::pair<const void*, int>;
+
+		struct Entry
+		{
+			Image frame;
+			uint32 lastAccess = 0;
+		};
+
+		static size_t getNumBytes(const Image& img) { return (size_t)img.getWidth() * (size_t)img.getHeight() * 4; }
+
+		void removeLeastRecentlyUsed(size_t numBytesToFree);
+
+		CriticalSection lock;
+		std::map<Key, Entry> entries;
+
+		size_t memoryLimit = (size_t)HISE_RLOTTIE_FRAME_CACHE_MB * 1024 * 1024;
+		size_t memoryUsage = 0;
+		uint32 accessCounter = 0;
+		int64 numHits = 0;
+		int64 numMisses = 0;
+	};
+
+	/** Returns the frame cache that is shared between all animations. */
+	FrameCache& getFrameCache() { return frameCache; }
+
+	/** Returns the thread pool that renders the frames in the background. */
+	ThreadPool& getRenderPool() { return renderPool; }
+
 protected:
 
 	RLottieManager();
@@ -56,6 +121,11 @@ private:
 
 	bool initialised = false;
 
+	FrameCache frameCache;
+
+	// must be destroyed before the cache
+	ThreadPool renderPool;
+
 	
 
 	/** @internal */
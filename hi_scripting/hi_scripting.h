@@ -89,6 +89,52 @@ compile / debug cycle and don't need all nodes in scriptnode you might want to t
 #define HISE_CREATE_DSP_NETWORKS_FOR_HARDCODED_NODES 0
 #endif
 
+/** Config: HISE_PREEMPT_SCRIPT_CALLBACKS
+
+If enabled, a long running low priority callback (eg. a file processing function or a paint routine) will execute
+pending high priority callbacks (eg. timer callbacks) at the same statement boundaries where the scripting engine 
+checks the timeout. This means that a high priority callback might be executed in the middle of a low priority 
+callback, so don't enable this if your callbacks rely on the old execution order. This is the default value for
+JavascriptThreadPool::setPreemptionEnabled().
+*/
+#ifndef HISE_PREEMPT_SCRIPT_CALLBACKS
+#define HISE_PREEMPT_SCRIPT_CALLBACKS 0
+#endif
+
+/** Config: HISE_NUM_SCRIPT_PAINT_THREADS
+
+The number of threads that execute the paint routines of script panels. These threads only acquire the look and feel
+render lock (like the LAF functions), so make sure that your paint routines only access inline function scopes or data 
+that is not modified by other callbacks. If this is zero, the paint routines are executed on the scripting thread.
+This is the default value for JavascriptThreadPool::setNumPaintThreads().
+*/
+#ifndef HISE_NUM_SCRIPT_PAINT_THREADS
+#define HISE_NUM_SCRIPT_PAINT_THREADS 0
+#endif
+
+/** Config: HISE_FUSE_SCRIPTNODE_NETWORKS
+
+If enabled, every monophonic DSP network will be compiled with the SNEX JIT compiler into a single function that is
+processed instead of the node tree. The network is recompiled on a background thread whenever you change it and
+uses the node tree until the new function is ready. Networks with modulation outputs, global connections or nodes
+that can't be compiled will always use the node tree. The switch between the node tree and the compiled function is
+crossfaded, but the incoming path starts from a reset state, so tails that are longer than the crossfade (50ms) are
+shortened when you edit the network. This requires HISE_INCLUDE_SNEX.
+*/
+#ifndef HISE_FUSE_SCRIPTNODE_NETWORKS
+#define HISE_FUSE_SCRIPTNODE_NETWORKS 0
+#endif
+
+/** Config: HISE_FRAME_CONTAINER_BLOCK_PROCESSING
+
+If enabled, the frame containers (frame1_block, frame2_block, framex_block) process their child nodes with the entire
+block if none of the child nodes sends a signal or modulation value to another node (cables, send / receive nodes
+or modulation targets). This skips the virtual per-sample calls but changes the block size of the child nodes.
+*/
+#ifndef HISE_FRAME_CONTAINER_BLOCK_PROCESSING
+#define HISE_FRAME_CONTAINER_BLOCK_PROCESSING 0
+#endif
+
 #define MAX_SCRIPT_HEIGHT 700
 
 #include "AppConfig.h"
@@ -155,6 +155,7 @@ void HardcodedScriptProcessor::processHiseEvent(HiseEvent &m)
 		case HiseEvent::Type::PitchFade:
 		case HiseEvent::Type::numTypes:
         case HiseEvent::Type::ProgramChange:
+		case HiseEvent::Type::ParameterChange:
 			break;
 		}
 	}
@@ -2295,16 +2295,29 @@ JavascriptThreadPool::JavascriptThreadPool(MainController* mc) :
 	taskNames[Task::HiPriorityCallbackExecution] = "Hi Priority Callback Counter";
 	taskNames[Task::LowPriorityCallbackExecution] = "Low Priority Callback Counter";
 	taskNames[Task::DeferredPanelRepaintJob] = "Deferred Paint Routine Counter";
+
+	setNumPaintThreads(HISE_NUM_SCRIPT_PAINT_THREADS);
 }
 
 JavascriptThreadPool::~JavascriptThreadPool()
 {
 	globalServer = nullptr;
+	paintThreads.clear();
 	stopThread(1000);
 }
 
 void JavascriptThreadPool::cancelAllJobs(bool shouldStopThread)
 {
+	// Stop the paint threads before acquiring the script lock (a paint routine
+	// might wait for the script lock).
+	for (auto pt : paintThreads)
+	{
+		if (shouldStopThread)
+			pt->stopThread(1000);
+
+		pt->queue.clear();
+	}
+
 	LockHelpers::SafeLock ss(getMainController(), LockHelpers::Type::ScriptLock);
 
 	if(shouldStopThread)
@@ -2325,7 +2338,8 @@ JavascriptThreadPool::Task::Task() noexcept:
 JavascriptThreadPool::Task::Task(Type t, JavascriptProcessor* jp_, const Function& functionToExecute) noexcept:
 	type(t),
 	f(functionToExecute),
-	jp(jp_)
+	jp(jp_),
+	creationTicks(Time::getHighResolutionTicks())
 {}
 
 JavascriptProcessor* JavascriptThreadPool::Task::getProcessor() const noexcept
@@ -2354,6 +2368,203 @@ SimpleReadWriteLock& JavascriptThreadPool::getLookAndFeelRenderLock()
 	return lookAndFeelRenderLock;
 }
 
+var JavascriptThreadPool::QueueLatency::toJSON() const
+{
+	auto obj = new DynamicObject();
+
+	obj->setProperty("NumTasks", numTasks);
+	obj->setProperty("Average", average);
+	obj->setProperty("Max", max);
+
+	return var(obj);
+}
+
+void JavascriptThreadPool::LatencyCounter::add(int64 microseconds) noexcept
+{
+	numTasks.fetch_add(1, std::memory_order_relaxed);
+	sum.fetch_add(microseconds, std::memory_order_relaxed);
+
+	auto prev = max.load(std::memory_order_relaxed);
+
+	while (prev < microseconds && !max.compare_exchange_weak(prev, microseconds))
+		;
+}
+
+void JavascriptThreadPool::LatencyCounter::reset() noexcept
+{
+	numTasks.store(0);
+	sum.store(0);
+	max.store(0);
+}
+
+void JavascriptThreadPool::addQueueLatency(Task::Type t, int64 creationTicks) noexcept
+{
+	if (creationTicks == 0)
+		return;
+
+	auto seconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - creationTicks);
+	latencyCounters[t].add((int64)(seconds * 1000000.0));
+}
+
+JavascriptThreadPool::QueueLatency JavascriptThreadPool::getQueueLatency(Task::Type t) const
+{
+	jassert(t < Task::Free);
+
+	QueueLatency l;
+	l.type = t;
+
+	const auto& c = latencyCounters[t];
+
+	l.numTasks = c.numTasks.load();
+
+	if (l.numTasks > 0)
+	{
+		l.average = 0.001 * (double)c.sum.load() / (double)l.numTasks;
+		l.max = 0.001 * (double)c.max.load();
+	}
+
+	return l;
+}
+
+var JavascriptThreadPool::getQueueLatencyAsJSON() const
+{
+	auto obj = new DynamicObject();
+
+	for (int i = 0; i < (int)Task::Free; i++)
+	{
+		auto t = (Task::Type)i;
+		obj->setProperty(getTaskName(t), getQueueLatency(t).toJSON());
+	}
+
+	obj->setProperty("NumPaintThreads", getNumPaintThreads());
+
+	return var(obj);
+}
+
+void JavascriptThreadPool::resetQueueLatency()
+{
+	for (auto& c : latencyCounters)
+		c.reset();
+}
+
+String JavascriptThreadPool::getTaskName(Task::Type t)
+{
+	switch (t)
+	{
+	case Task::Compilation:						return "Compilation";
+	case Task::ReplEvaluation:					return "ReplEvaluation";
+	case Task::HiPriorityCallbackExecution:		return "HiPriorityCallback";
+	case Task::LowPriorityCallbackExecution:	return "LowPriorityCallback";
+	case Task::DeferredPanelRepaintJob:			return "PaintRoutine";
+	default:									return {};
+	}
+}
+
+int JavascriptThreadPool::preemptLowPriorityTask()
+{
+	if (isPreempting || !busy || currentType != Task::LowPriorityCallbackExecution)
+		return 0;
+
+	if (Thread::getCurrentThreadId() != getThreadId())
+		return 0;
+
+	// A compilation will clear the queue anyway
+	if (!compilationQueue.isEmpty())
+		return 0;
+
+	auto start = Time::getMillisecondCounter();
+
+	// Don't check the queue at every statement of a tight loop
+	if (start - lastPreemption < 5)
+		return 0;
+
+	lastPreemption = start;
+
+	ScopedValueSetter<bool> svs(isPreempting, true);
+
+	TRACE_EVENT("scripting", "preempt low priority callback");
+
+	PendingCompilationList noCompilations;
+	auto r = executeHighPriorityTasks(noCompilations);
+
+	clearCounter(Task::HiPriorityCallbackExecution);
+
+	if (!r.wasOk() && r.getErrorMessage() != "Engine is dangling")
+		debugError(getMainController()->getMainSynthChain(), r.getErrorMessage());
+
+	return (int)(Time::getMillisecondCounter() - start);
+}
+
+void JavascriptThreadPool::setNumPaintThreads(int numThreads)
+{
+	// The destructor stops the thread
+	paintThreads.clear();
+
+	for (int i = 0; i < numThreads; i++)
+	{
+		paintThreads.add(new PaintThread(*this, i));
+		paintThreads.getLast()->startThread(6);
+	}
+}
+
+bool JavascriptThreadPool::isPaintThread() const
+{
+	auto thisThread = Thread::getCurrentThreadId();
+
+	for (auto pt : paintThreads)
+	{
+		if (pt->getThreadId() == thisThread)
+			return true;
+	}
+
+	return false;
+}
+
+JavascriptThreadPool::PaintThread::PaintThread(JavascriptThreadPool& parent_, int index):
+	Thread("Paint Thread " + String(index + 1), HISE_DEFAULT_STACK_SIZE),
+	parent(parent_),
+	queue(1024)
+{}
+
+JavascriptThreadPool::PaintThread::~PaintThread()
+{
+	stopThread(1000);
+}
+
+void JavascriptThreadPool::PaintThread::run()
+{
+	while (!threadShouldExit())
+	{
+		CallbackTask pt;
+		int waitTime = 500;
+
+		while (!threadShouldExit() && queue.pop(pt))
+		{
+			// Don't block the compilation (it will clear the queue anyway)
+			if (auto sl = SimpleReadWriteLock::ScopedTryReadLock(parent.getLookAndFeelRenderLock()))
+			{
+				parent.addQueueLatency(Task::DeferredPanelRepaintJob, pt.getFunction().getCreationTicks());
+
+				auto r = pt.call();
+
+				if (r.failed())
+				{
+					if (auto p = dynamic_cast<Processor*>(pt.getFunction().getProcessor()))
+						debugError(p, r.getErrorMessage());
+				}
+			}
+			else
+			{
+				queue.push(std::move(pt));
+				waitTime = 10;
+				break;
+			}
+		}
+
+		wait(waitTime);
+	}
+}
+
 GlobalServer* JavascriptThreadPool::getGlobalServer()
 { return globalServer.get(); }
 
@@ -2463,6 +2674,18 @@ void JavascriptThreadPool::addJob(Task::Type t, JavascriptProcessor* p, const Ta
 	if (t != Task::Type::Compilation && isSleeping)
 		return;
 
+	if (t == Task::Type::DeferredPanelRepaintJob)
+	{
+		if (!paintThreads.isEmpty())
+		{
+			pushToPaintThread(p, f);
+			return;
+		}
+
+		// No paint threads, so it's just a low priority callback
+		t = Task::Type::LowPriorityCallbackExecution;
+	}
+
 	switch (currentThread)
 	{
 	case MainController::KillStateHandler::TargetThread::SampleLoadingThread:
@@ -2546,8 +2769,59 @@ void JavascriptThreadPool::addDeferredPaintJob(ScriptingApi::Content::ScriptPane
 {
 	bumpCounter(Task::DeferredPanelRepaintJob);
 	
-	WeakReference<ScriptingApi::Content::ScriptPanel> spWeak(sp);
-	deferredPanels.push(std::move(spWeak));
+	DeferredPanel dp;
+	dp.panel = sp;
+	dp.creationTicks = Time::getHighResolutionTicks();
+	deferredPanels.push(std::move(dp));
+}
+
+void JavascriptThreadPool::pushToPaintThread(JavascriptProcessor* p, const Task::Function& f)
+{
+	bumpCounter(Task::DeferredPanelRepaintJob);
+
+	// All panels of a script processor use the same thread so that
+	// its paint routines are never executed in parallel.
+	auto index = (int)((reinterpret_cast<pointer_sized_uint>(p) >> 4) % (pointer_sized_uint)paintThreads.size());
+	auto pt = paintThreads[index];
+
+	pt->queue.push({ Task(Task::DeferredPanelRepaintJob, p, f), getMainController() });
+	pt->notify();
+}
+
+Result JavascriptThreadPool::executeHighPriorityTasks(PendingCompilationList& pendingCompilations)
+{
+	Result r = Result::ok();
+
+	preemptionPending.store(false);
+
+	TRACE_EVENT("scripting", "high priority queue");//, perfetto::Track(HighPriorityTrackId));
+	
+	CallbackTask hpt;
+
+	while (r.wasOk() && highPriorityQueue.pop(hpt))
+	{
+		jassert(hpt.getFunction().isHiPriority());
+
+		if (pendingCompilations.contains(hpt.getFunction().getProcessor()))
+			continue;
+
+#if PERFETTO
+		dispatch::StringBuilder b;
+
+		if(auto p = dynamic_cast<Processor*>(hpt.getFunction().getProcessor()))
+		{
+			b << "hi priority callback " << p->getId();
+		}
+		
+		TRACE_DYNAMIC_SCRIPTING(b);
+#endif
+
+		addQueueLatency(Task::HiPriorityCallbackExecution, hpt.getFunction().getCreationTicks());
+
+		r = hpt.call();
+	}
+
+	return r;
 }
 
 Result JavascriptThreadPool::executeQueue(const Task::Type& t, PendingCompilationList& pendingCompilations)
@@ -2581,6 +2855,9 @@ Result JavascriptThreadPool::executeQueue(const Task::Type& t, PendingCompilatio
 			lowPriorityQueue.clear();
 			highPriorityQueue.clear();
 
+			for (auto pt : paintThreads)
+				pt->queue.clear();
+
 #if PERFETTO
 			dispatch::StringBuilder b;
 			b << "compile " << dynamic_cast<Processor*>(ct.getFunction().getProcessor())->getId();
@@ -2589,6 +2866,8 @@ Result JavascriptThreadPool::executeQueue(const Task::Type& t, PendingCompilatio
 
 			killVoicesAndExtendTimeOut(ct.getFunction().getProcessor());
 
+			addQueueLatency(Task::Compilation, ct.getFunction().getCreationTicks());
+
 			r = ct.call();
 
 			pendingCompilations.addIfNotAlreadyThere(ct.getFunction().getProcessor());
@@ -2611,6 +2890,8 @@ Result JavascriptThreadPool::executeQueue(const Task::Type& t, PendingCompilatio
             if (alreadyCompiled(hpt))
                 continue;
 
+            addQueueLatency(Task::ReplEvaluation, hpt.getFunction().getCreationTicks());
+
             r = hpt.call();
         }
 #endif
@@ -2621,30 +2902,8 @@ Result JavascriptThreadPool::executeQueue(const Task::Type& t, PendingCompilatio
 	{
 		r = executeQueue(Task::ReplEvaluation, pendingCompilations);
 
-		TRACE_EVENT("scripting", "high priority queue");//, perfetto::Track(HighPriorityTrackId));
-		
-		CallbackTask hpt;
-
-		while (r.wasOk() && highPriorityQueue.pop(hpt))
-		{
-			jassert(hpt.getFunction().isHiPriority());
-
-			if (alreadyCompiled(hpt))
-				continue;
-
-#if PERFETTO
-			dispatch::StringBuilder b;
-
-			if(auto p = dynamic_cast<Processor*>(hpt.getFunction().getProcessor()))
-			{
-				b << "hi priority callback " << p->getId();
-			}
-			
-			TRACE_DYNAMIC_SCRIPTING(b);
-#endif
-
-			r = hpt.call();
-		}
+		if (r.wasOk())
+			r = executeHighPriorityTasks(pendingCompilations);
 
 		clearCounter(t);
 
@@ -2688,6 +2947,8 @@ Result JavascriptThreadPool::executeQueue(const Task::Type& t, PendingCompilatio
 			TRACE_DYNAMIC_SCRIPTING(b);
 #endif
 
+			addQueueLatency(Task::LowPriorityCallbackExecution, lpt.getFunction().getCreationTicks());
+
 			r = lpt.call();
 		}
 
@@ -2698,15 +2959,17 @@ Result JavascriptThreadPool::executeQueue(const Task::Type& t, PendingCompilatio
 
 		clearCounter(t);
 
-		WeakReference<ScriptingApi::Content::ScriptPanel> sp;
+		DeferredPanel dp;
 
 		if (r.wasOk())
 		{
-			while (deferredPanels.pop(sp))
+			while (deferredPanels.pop(dp))
 			{
 				ScopedValueSetter<bool> svs(busy, true);
 
-				if (sp.get() != nullptr)
+				addQueueLatency(Task::DeferredPanelRepaintJob, dp.creationTicks);
+
+				if (auto sp = dp.panel.get())
 				{
 #if PERFETTO
 					dispatch::StringBuilder b;
@@ -2791,6 +3054,9 @@ void JavascriptThreadPool::pushToQueue(const Task::Type& t, JavascriptProcessor*
 	case Task::HiPriorityCallbackExecution:
 	{
 		highPriorityQueue.push({ Task(t, p, f), getMainController() });
+
+		if (preemptionEnabled)
+			preemptionPending.store(true);
 		break;
 	}
 	case Task::Compilation:
@@ -2826,6 +3092,13 @@ Result JavascriptThreadPool::Task::callWithResult()
 	{
 		jassert(type != Free);
 
+		if (type == DeferredPanelRepaintJob)
+		{
+			// The paint threads only acquire the look and feel render lock
+			jassert(parent.isPaintThread());
+			return callFunction();
+		}
+
 		if(type == Compilation)
 			LockHelpers::freeToGo(parent.getMainController());
 
@@ -2834,25 +3107,30 @@ Result JavascriptThreadPool::Task::callWithResult()
 		ScopedValueSetter<bool> svs(parent.busy, true);
 		ScopedValueSetter<Task::Type> svs2(parent.currentType, type);
 
-		try
-		{
-			return f(jp.get());
-		}
-		catch (Result& r)
-		{
-			jassertfalse;
-			return Result(r);
-		}
-		catch (String& errorMessage)
-		{
-			jassertfalse;
-			return Result::fail(errorMessage);
-		}
+		return callFunction();
 	};
 
 	return Result::fail("invalid function");
 }
 
+Result JavascriptThreadPool::Task::callFunction()
+{
+	try
+	{
+		return f(jp.get());
+	}
+	catch (Result& r)
+	{
+		jassertfalse;
+		return Result(r);
+	}
+	catch (String& errorMessage)
+	{
+		jassertfalse;
+		return Result::fail(errorMessage);
+	}
+}
+
 void JavascriptProcessor::EditorHelpers::applyChangesFromActiveEditor(JavascriptProcessor* p)
 {
 	auto activeEditor = getActiveEditor(p);
@@ -700,6 +700,8 @@ public:
 
 	using SleepListener = JavascriptSleepListener;
 
+	using PendingCompilationList = Array<WeakReference<JavascriptProcessor>>;
+
 	JavascriptThreadPool(MainController* mc);
 
 	~JavascriptThreadPool();
@@ -737,11 +739,28 @@ public:
 
 		bool isHiPriority() const noexcept;
 
+		/** Returns the high resolution ticks when the task was created (used for the queue latency). */
+		int64 getCreationTicks() const noexcept { return creationTicks; }
+
 	private:
 
+		Result callFunction();
+
 		Type type;
 		WeakReference<JavascriptProcessor> jp;
 		Function f;
+		int64 creationTicks = 0;
+	};
+
+	/** The time in milliseconds between adding a job to the queue and its execution. */
+	struct QueueLatency
+	{
+		var toJSON() const;
+
+		Task::Type type;
+		int64 numTasks = 0;
+		double average = 0.0;
+		double max = 0.0;
 	};
 
 	void addJob(Task::Type t, JavascriptProcessor* p, const Task::Function& f);
@@ -760,6 +779,43 @@ public:
 
 	SimpleReadWriteLock& getLookAndFeelRenderLock();
 
+	/** Returns the queue latency of the given task type since the last reset. */
+	QueueLatency getQueueLatency(Task::Type t) const;
+
+	/** Returns the queue latency of all task types as JSON object. */
+	var getQueueLatencyAsJSON() const;
+
+	void resetQueueLatency();
+
+	static String getTaskName(Task::Type t);
+
+	/** Returns true if a high priority task is waiting. The scripting engine checks this at
+		the same statement boundaries where it checks the timeout and calls preemptLowPriorityTask().
+	*/
+	bool isPreemptionPending() const noexcept { return preemptionPending.load(std::memory_order_relaxed); }
+
+	/** Executes the pending high priority tasks if the scripting thread is currently running a
+		low priority callback (eg. a file processing function) so that timer callbacks are not
+		blocked until it returns. Returns the time in milliseconds that was spent in the high priority
+		tasks so that the engine can extend the timeout of the preempted callback.
+	*/
+	int preemptLowPriorityTask();
+
+	/** Returns true if the current thread is one of the paint threads. */
+	bool isPaintThread() const;
+
+	int getNumPaintThreads() const noexcept { return paintThreads.size(); }
+
+	/** Enables the preemption of low priority callbacks (the default is HISE_PREEMPT_SCRIPT_CALLBACKS). */
+	void setPreemptionEnabled(bool shouldBeEnabled) noexcept { preemptionEnabled.store(shouldBeEnabled); }
+
+	bool isPreemptionEnabled() const noexcept { return preemptionEnabled.load(); }
+
+	/** Stops the current paint threads and starts the given amount of new ones (the default is HISE_NUM_SCRIPT_PAINT_THREADS).
+		Pending paint routines are discarded, so only call this when no script panels are being painted.
+	*/
+	void setNumPaintThreads(int numThreads);
+
 	GlobalServer* getGlobalServer();
 
 	void resume();
@@ -788,6 +844,22 @@ public:
 
 private:
 
+	struct LatencyCounter
+	{
+		void add(int64 microseconds) noexcept;
+		void reset() noexcept;
+
+		std::atomic<int64> numTasks { 0 };
+		std::atomic<int64> sum { 0 };
+		std::atomic<int64> max { 0 };
+	};
+
+	void addQueueLatency(Task::Type t, int64 creationTicks) noexcept;
+
+	Result executeHighPriorityTasks(PendingCompilationList& pendingCompilations);
+
+	void pushToPaintThread(JavascriptProcessor* p, const Task::Function& f);
+
 	void clearCounter(Task::Type t)
 	{
 		numTasks[t] = 0;
@@ -810,8 +882,6 @@ private:
 
 	ScopedPointer<GlobalServer> globalServer;
 
-	using PendingCompilationList = Array<WeakReference<JavascriptProcessor>>;
-
 	void pushToQueue(const Task::Type& t, JavascriptProcessor* p, const Task::Function& f);
 
 	Result executeNow(const Task::Type& t, JavascriptProcessor* p, const Task::Function& f);
@@ -819,10 +889,16 @@ private:
 	Result executeQueue(const Task::Type& t, PendingCompilationList& pendingCompilations);
 
 	std::atomic<bool> pending;
+	std::atomic<bool> preemptionPending { false };
+	std::atomic<bool> preemptionEnabled { HISE_PREEMPT_SCRIPT_CALLBACKS != 0 };
 	
 	bool busy = false;
+	bool isPreempting = false;
+	uint32 lastPreemption = 0;
 	Task::Type currentType;
 
+	LatencyCounter latencyCounters[(int)Task::numTypes];
+
 	CriticalSection scriptLock;
 
 	SimpleReadWriteLock lookAndFeelRenderLock;
@@ -841,7 +917,30 @@ private:
     MultithreadedLockfreeQueue<CallbackTask, queueConfig> replQueue;
 #endif
 
-	MultithreadedLockfreeQueue<WeakReference<ScriptingApi::Content::ScriptPanel>, queueConfig> deferredPanels;
+	struct DeferredPanel
+	{
+		WeakReference<ScriptingApi::Content::ScriptPanel> panel;
+		int64 creationTicks = 0;
+	};
+
+	MultithreadedLockfreeQueue<DeferredPanel, queueConfig> deferredPanels;
+
+	/** Executes the paint routines of script panels. These threads only acquire the read lock of the
+		look and feel render lock (just like the LAF functions on the message thread), so a slow
+		paint routine doesn't block the scripting thread.
+	*/
+	struct PaintThread : public Thread
+	{
+		PaintThread(JavascriptThreadPool& parent_, int index);
+		~PaintThread();
+
+		void run() override;
+
+		JavascriptThreadPool& parent;
+		MultithreadedLockfreeQueue<CallbackTask, queueConfig> queue;
+	};
+
+	OwnedArray<PaintThread> paintThreads;
 };
 
 
@@ -44,8 +44,11 @@ onControlCallback(new SnippetDocument("onControl", "number value")),
 front(false),
 deferred(false),
 deferredExecutioner(this),
-deferredUpdatePending(false)
+deferredUpdatePending(false),
+profileAccumulator(CpuProfiler::Category::ScriptCallback)
 {
+	profileAccumulator.processor = this;
+
 	initContent();
 
     editorStateIdentifiers.add("contentShown");
@@ -222,6 +225,8 @@ void JavascriptMidiProcessor::processHiseEvent(HiseEvent &m)
 	{
 		ADD_GLITCH_DETECTOR(this, DebugLogger::Location::ScriptMidiEventCallback);
 
+		CpuProfiler::ScopedAccumulation sa(getMainController()->getCpuProfiler(), profileAccumulator);
+
 		if (currentMidiMessage != nullptr)
 		{
 			ScopedValueSetter<HiseEvent*> svs(currentEvent, &m);
@@ -371,6 +376,7 @@ void JavascriptMidiProcessor::runScriptCallbacks()
         case HiseEvent::Type::MidiStop:
         case HiseEvent::Type::VolumeFade:
         case HiseEvent::Type::PitchFade:
+        case HiseEvent::Type::ParameterChange:
         case HiseEvent::Type::numTypes:
         break;
 	}
@@ -166,6 +166,8 @@ private:
 
 	bool front, deferred, deferredUpdatePending;
 
+	CpuProfiler::Accumulator profileAccumulator;
+
 	
 
 	
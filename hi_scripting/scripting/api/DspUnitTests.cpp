@@ -1407,6 +1407,324 @@ private:
 
 //static ModulationTests modulationTests;
 
+/** Checks that the compiled macro connections produce the same values as the parameter data and
+	measures a macro move with 8 macros that are connected to 100 targets each. */
+class MacroControlBenchmark : public UnitTest
+{
+public:
+
+	static constexpr int NumMacros = 8;
+	static constexpr int NumTargets = 100;
+	static constexpr int NumProcessors = 20;
+	static constexpr int NumIterations = 200;
+
+	/** Outside of the -100...100 range of every connection, so a target that wasn't written will stand out. */
+	static constexpr float ResetValue = 200.0f;
+
+	MacroControlBenchmark() :
+		UnitTest("Macro control benchmark", "Benchmark")
+	{}
+
+	void runTest() override
+	{
+		ScopedValueSetter<bool> s(MainController::unitTestMode, true);
+
+		bp = new BackendProcessor(nullptr, nullptr);
+
+		createTargets();
+
+		testCompiledValues();
+		testRecompilation();
+		testMacroMoves(false);
+		testMacroMoves(true);
+
+		targets.clear();
+		bp = nullptr;
+	}
+
+private:
+
+	ModulatorSynthChain* getChain() { return bp->getMainSynthChain(); }
+
+	void createTargets()
+	{
+		beginTest("Creating " + String(NumMacros * NumTargets) + " macro connections");
+
+		auto fxChain = dynamic_cast<EffectProcessorChain*>(getChain()->getChildProcessor(ModulatorSynth::EffectChain));
+
+		for (int i = 0; i < NumProcessors; i++)
+		{
+			auto fx = new GainEffect(bp, "Gain" + String(i));
+			fxChain->getHandler()->add(fx, nullptr);
+			targets.add(fx);
+		}
+
+		// Skip the delay parameter
+		const int parameters[3] = { GainEffect::Gain, GainEffect::Width, GainEffect::Balance };
+
+		for (int m = 0; m < NumMacros; m++)
+		{
+			auto md = getChain()->getMacroControlData(m);
+
+			for (int t = 0; t < NumTargets; t++)
+			{
+				auto p = targets[(m * NumTargets + t) % NumProcessors];
+				auto parameter = parameters[t % 3];
+
+				NormalisableRange<double> range(-100.0, 100.0);
+				range.skew = t % 2 == 0 ? 1.0 : 0.3;
+
+				md->addParameter(p, parameter, "P" + String(t), {}, range, true, false, dontSendNotification);
+
+				if (t % 5 == 0)
+					md->getParameter(t)->setInverted(true);
+			}
+
+			expectEquals(md->getNumParameters(), NumTargets, "wrong parameter amount");
+		}
+	}
+
+	Array<float> getCurrentValues()
+	{
+		Array<float> values;
+
+		for (auto p : targets)
+		{
+			values.add(p->getAttribute(GainEffect::Gain));
+			values.add(p->getAttribute(GainEffect::Width));
+			values.add(p->getAttribute(GainEffect::Balance));
+		}
+
+		return values;
+	}
+
+	void resetTargets()
+	{
+		for (auto p : targets)
+		{
+			p->setAttribute(GainEffect::Gain, ResetValue, dontSendNotification);
+			p->setAttribute(GainEffect::Width, ResetValue, dontSendNotification);
+			p->setAttribute(GainEffect::Balance, ResetValue, dontSendNotification);
+		}
+	}
+
+	Array<float> setMacros(bool useCompiledConnections, float offset)
+	{
+		// Otherwise the second run would start with the values of the first one
+		resetTargets();
+
+		getChain()->setUseCompiledConnections(useCompiledConnections);
+
+		for (int m = 0; m < NumMacros; m++)
+			getChain()->setMacroControl(m, std::fmod(offset + (float)m * 17.0f, 127.0f), dontSendNotification);
+
+		return getCurrentValues();
+	}
+
+	void expectValuesMatch(const Array<float>& a, const Array<float>& b)
+	{
+		expectEquals(a.size(), b.size(), "size mismatch");
+
+		for (int i = 0; i < a.size(); i++)
+		{
+			expectNotEquals(a[i], ResetValue, "target " + String(i) + " wasn't set");
+			expectEquals(a[i], b[i], "value mismatch at " + String(i));
+		}
+	}
+
+	void testCompiledValues()
+	{
+		beginTest("Testing compiled connections");
+
+		for (float offset = 0.0f; offset < 127.0f; offset += 31.0f)
+			expectValuesMatch(setMacros(false, offset), setMacros(true, offset));
+	}
+
+	void testRecompilation()
+	{
+		beginTest("Testing recompilation after a connection change");
+
+		auto md = getChain()->getMacroControlData(0);
+
+		md->getParameter(1)->setRangeEnd(50.0);
+		md->getParameter(2)->setInverted(true);
+		md->removeParameter(3, dontSendNotification);
+
+		expectValuesMatch(setMacros(false, 42.0f), setMacros(true, 42.0f));
+	}
+
+	void testMacroMoves(bool useCompiledConnections)
+	{
+		beginTest("Measuring macro moves " + String(useCompiledConnections ? "(compiled)" : "(parameter data)"));
+
+		getChain()->setUseCompiledConnections(useCompiledConnections);
+
+		auto start = Time::getHighResolutionTicks();
+
+		for (int i = 0; i < NumIterations; i++)
+		{
+			for (int m = 0; m < NumMacros; m++)
+				getChain()->setMacroControl(m, (float)((i + m) % 128), dontSendNotification);
+		}
+
+		auto seconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+		auto numMoves = (double)(NumIterations * NumMacros);
+
+		logMessage("Time per macro move with " + String(NumTargets) + " targets: " + String(seconds * 1000000.0 / numMoves, 2) + "us");
+
+		expect(seconds > 0.0, "no time measured");
+	}
+
+	ScopedPointer<BackendProcessor> bp;
+	Array<WeakReference<Processor>> targets;
+};
+
+static MacroControlBenchmark macroControlBenchmark;
+
+/** Smoke test for the preemption of low priority callbacks and the paint threads of the scripting thread pool. */
+class JavascriptThreadPoolTest : public UnitTest
+{
+public:
+
+	using Task = JavascriptThreadPool::Task;
+
+	JavascriptThreadPoolTest() :
+		UnitTest("Testing scripting thread pool")
+	{}
+
+	void runTest() override
+	{
+		ScopedValueSetter<bool> s(MainController::unitTestMode, true);
+
+		bp = new BackendProcessor(nullptr, nullptr);
+
+		auto mp = new JavascriptMidiProcessor(bp, "scripter");
+		mp->setOwnerSynth(bp->getMainSynthChain());
+
+		auto mpc = dynamic_cast<MidiProcessorChain*>(bp->getMainSynthChain()->getChildProcessor(ModulatorSynth::MidiProcessor));
+		mpc->getHandler()->add(mp, nullptr);
+
+		jp = mp;
+
+		testPaintThreads();
+		testPreemption();
+
+		jp = nullptr;
+		bp = nullptr;
+	}
+
+private:
+
+	/** Adds the job from a background thread, so it goes through the queues like a job from a timer or server thread. */
+	struct JobThread : public Thread
+	{
+		JobThread(const std::function<void()>& f_) :
+			Thread("Test job thread"),
+			f(f_)
+		{
+			startThread();
+		}
+
+		~JobThread()
+		{
+			stopThread(1000);
+		}
+
+		void run() override { f(); }
+
+		std::function<void()> f;
+	};
+
+	JavascriptThreadPool& getPool() { return bp->getJavascriptThreadPool(); }
+
+	void addJob(Task::Type t, const Task::Function& f)
+	{
+		JobThread jt([this, t, f]() { getPool().addJob(t, jp.get(), f); });
+
+		while (jt.isThreadRunning())
+			Thread::sleep(1);
+	}
+
+	void testPaintThreads()
+	{
+		beginTest("Testing paint threads");
+
+		getPool().setNumPaintThreads(2);
+		expectEquals(getPool().getNumPaintThreads(), 2, "paint threads not created");
+
+		WaitableEvent painted;
+		std::atomic<bool> wasOnPaintThread = { false };
+
+		addJob(Task::DeferredPanelRepaintJob, [&](JavascriptProcessor*)
+		{
+			wasOnPaintThread = getPool().isPaintThread();
+			painted.signal();
+			return Result::ok();
+		});
+
+		expect(painted.wait(2000), "paint routine wasn't executed");
+		expect(wasOnPaintThread.load(), "paint routine wasn't executed on a paint thread");
+
+		getPool().setNumPaintThreads(HISE_NUM_SCRIPT_PAINT_THREADS);
+	}
+
+	void testPreemption()
+	{
+		beginTest("Testing preemption of low priority callbacks");
+
+		getPool().setPreemptionEnabled(true);
+		getPool().resetQueueLatency();
+
+		WaitableEvent lowPriorityStarted, lowPriorityFinished;
+		std::atomic<bool> hiPriorityExecuted = { false };
+		std::atomic<bool> wasPreempted = { false };
+
+		addJob(Task::LowPriorityCallbackExecution, [&](JavascriptProcessor*)
+		{
+			lowPriorityStarted.signal();
+
+			auto end = Time::getMillisecondCounter() + 2000;
+
+			// This is what the engine does at every statement boundary
+			while (Time::getMillisecondCounter() < end)
+			{
+				if (getPool().isPreemptionPending())
+					getPool().preemptLowPriorityTask();
+
+				if (hiPriorityExecuted)
+				{
+					wasPreempted = true;
+					break;
+				}
+
+				Thread::sleep(1);
+			}
+
+			lowPriorityFinished.signal();
+			return Result::ok();
+		});
+
+		expect(lowPriorityStarted.wait(2000), "low priority callback wasn't started");
+
+		addJob(Task::HiPriorityCallbackExecution, [&](JavascriptProcessor*)
+		{
+			hiPriorityExecuted = true;
+			return Result::ok();
+		});
+
+		expect(lowPriorityFinished.wait(4000), "low priority callback didn't finish");
+		expect(wasPreempted.load(), "high priority callback wasn't executed during the low priority callback");
+		expect(getPool().getQueueLatency(Task::HiPriorityCallbackExecution).numTasks > 0, "queue latency wasn't recorded");
+
+		getPool().setPreemptionEnabled(HISE_PREEMPT_SCRIPT_CALLBACKS != 0);
+	}
+
+	ScopedPointer<BackendProcessor> bp;
+	WeakReference<JavascriptProcessor> jp;
+};
+
+static JavascriptThreadPoolTest javascriptThreadPoolTest;
+
 class CustomContainerTest : public UnitTest
 {
 public:
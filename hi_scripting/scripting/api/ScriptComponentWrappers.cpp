@@ -3009,6 +3009,7 @@ typedef ScriptingApi::Content::ScriptComponent ScriptedComponent;
 ScriptedControlAudioParameter::ScriptedControlAudioParameter(ScriptingApi::Content::ScriptComponent *newComponent, AudioProcessor *parentProcessor_, ScriptBaseMidiProcessor *scriptProcessor_, int index_) :
   AudioProcessorParameterWithID(newComponent->getName().toString(), 
 								getNameForComponent(newComponent)),
+  Target(dynamic_cast<MainController*>(parentProcessor_)->getHostAutomationLane()),
   id(newComponent->getName()),
   parentProcessor(parentProcessor_),
   type(getType(newComponent)),
@@ -3103,6 +3104,9 @@ void ScriptedControlAudioParameter::setValue(float newValue)
 
 		if (enableUpdate)
 		{
+			// This is false if the value comes from setParameterNotifyingHost()
+			const bool isHostAutomation = *enableUpdate;
+
 			ScopedValueSetter<bool> setter(*enableUpdate, false, true);
 
 			const float convertedValue = range.convertFrom0to1(newValue);
@@ -3112,7 +3116,11 @@ void ScriptedControlAudioParameter::setValue(float newValue)
 			{
 				lastValue = snappedValue;
 				lastValueInitialised = true;
-				scriptProcessor->setAttribute(componentIndex, snappedValue, sendNotificationAsync);
+
+				if (isHostAutomation)
+					setHostAutomationValue(snappedValue);
+				else
+					scriptProcessor->setAttribute(componentIndex, snappedValue, sendNotificationAsync);
 			}
 		}
 	}
@@ -3122,6 +3130,43 @@ void ScriptedControlAudioParameter::setValue(float newValue)
 	}
 }
 
+void ScriptedControlAudioParameter::applyHostAutomation(float value)
+{
+	if (scriptProcessor.get() != nullptr)
+	{
+		ScopedValueSetter<bool> setter(dynamic_cast<MainController*>(parentProcessor)->getPluginParameterUpdateState(), false, true);
+		scriptProcessor->setAttribute(componentIndex, value, sendNotificationAsync);
+	}
+}
+
+const Processor* ScriptedControlAudioParameter::getHostAutomationOwner() const
+{
+	if (auto sc = getControlledComponent())
+		return HostAutomationLane::getOwnerSynth(sc->getConnectedProcessor());
+
+	return nullptr;
+}
+
+bool ScriptedControlAudioParameter::shouldThrottleHostAutomation() const
+{
+	// Only components that are connected to a module skip the control callback
+	if (auto sc = getControlledComponent())
+		return !sc->isConnectedToProcessor();
+
+	return true;
+}
+
+const ScriptingApi::Content::ScriptComponent* ScriptedControlAudioParameter::getControlledComponent() const
+{
+	if (auto psc = dynamic_cast<const ProcessorWithScriptingContent*>(scriptProcessor.get()))
+	{
+		if (auto content = psc->getScriptingContent())
+			return content->getComponent(componentIndex);
+	}
+
+	return nullptr;
+}
+
 float ScriptedControlAudioParameter::getDefaultValue() const
 {
 	float value = 0.0f;
@@ -36,7 +36,8 @@
 namespace hise { using namespace juce;
 
 class ScriptedControlAudioParameter : public AudioProcessorParameterWithID,
-									  public AsyncUpdater
+									  public AsyncUpdater,
+									  public HostAutomationLane::Target
 {
 public:
 
@@ -69,6 +70,10 @@ public:
 	void setValue(float newValue) override;
 	float getDefaultValue() const override;
 
+	void applyHostAutomation(float value) override;
+	const Processor* getHostAutomationOwner() const override;
+	bool shouldThrottleHostAutomation() const override;
+
 	String getLabel() const override;
 	String getText(float value, int) const override;
 
@@ -99,6 +104,8 @@ private:
 
 	void setParameterNotifyingHostInternal(int index, float newValue);
 
+	const ScriptingApi::Content::ScriptComponent* getControlledComponent() const;
+
 	float valueForHost = 0.0f;
 	int indexForHost = -1;
 
@@ -53,6 +53,8 @@ struct ScriptUserPresetHandler::Wrapper
 	API_VOID_METHOD_WRAPPER_1(ScriptUserPresetHandler, updateSaveInPresetComponents);
 	API_VOID_METHOD_WRAPPER_0(ScriptUserPresetHandler, updateConnectedComponentsFromModuleState);
 	API_VOID_METHOD_WRAPPER_1(ScriptUserPresetHandler, setUseUndoForPresetLoading);
+	API_VOID_METHOD_WRAPPER_1(ScriptUserPresetHandler, setUseIncrementalPresetLoading);
+	API_METHOD_WRAPPER_0(ScriptUserPresetHandler, getLastPresetLoadStatistics);
 	API_METHOD_WRAPPER_0(ScriptUserPresetHandler, createObjectForSaveInPresetComponents);
 	API_VOID_METHOD_WRAPPER_0(ScriptUserPresetHandler, resetToDefaultUserPreset);
 	API_METHOD_WRAPPER_0(ScriptUserPresetHandler, createObjectForAutomationValues);
@@ -90,6 +92,8 @@ ScriptUserPresetHandler::ScriptUserPresetHandler(ProcessorWithScriptingContent*
 	ADD_API_METHOD_0(createObjectForSaveInPresetComponents);
 	ADD_API_METHOD_0(createObjectForAutomationValues);
 	ADD_API_METHOD_0(getSecondsSinceLastPresetLoad);
+	ADD_API_METHOD_1(setUseIncrementalPresetLoading);
+	ADD_API_METHOD_0(getLastPresetLoadStatistics);
 	ADD_API_METHOD_0(resetToDefaultUserPreset);
 	ADD_API_METHOD_0(runTest);
 	
@@ -164,6 +168,27 @@ void ScriptUserPresetHandler::setUseUndoForPresetLoading(bool shouldUseUndoManag
 	getMainController()->getUserPresetHandler().setAllowUndoAtUserPresetLoad(shouldUseUndoManager);
 }
 
+void ScriptUserPresetHandler::setUseIncrementalPresetLoading(bool shouldLoadIncrementally)
+{
+	getMainController()->getUserPresetHandler().setUseIncrementalPresetLoad(shouldLoadIncrementally);
+}
+
+var ScriptUserPresetHandler::getLastPresetLoadStatistics() const
+{
+	const auto& stats = getMainController()->getUserPresetHandler().getLastPresetLoadStatistics();
+
+	auto obj = new DynamicObject();
+
+	obj->setProperty("Incremental", stats.wasIncremental);
+	obj->setProperty("Suspended", stats.wasSuspended);
+	obj->setProperty("NumChanges", stats.numAppliedChanges);
+	obj->setProperty("DiffTime", stats.diffMilliseconds);
+	obj->setProperty("LoadTime", stats.loadMilliseconds);
+	obj->setProperty("TotalTime", stats.totalMilliseconds);
+
+	return var(obj);
+}
+
 void ScriptUserPresetHandler::setPreCallback(var presetCallback)
 {
 	preCallback = WeakCallbackHolder(getScriptProcessor(), this, presetCallback, 1);
@@ -2156,6 +2181,20 @@ void ScriptEncryptedExpansion::restorePool(ValueTree encryptedTree, SubDirectori
 		auto c = poolData.getChildWithName(childName);
 		auto d = c.getProperty(ExpansionIds::Data).toString();
 
+		// The audio files & images are the heavy part of an expansion, so we defer
+		// decoding them until the pool is accessed for the first time
+		if (fileType == AudioFiles || fileType == Images)
+		{
+			p->getDataProvider()->setLazyRestoreFunction([d](PoolBase::DataProvider& dp)
+			{
+				MemoryBlock lazyData;
+				lazyData.fromBase64Encoding(d);
+				return dp.restorePool(new MemoryInputStream(lazyData, true));
+			});
+
+			return;
+		}
+
 		mb.fromBase64Encoding(d);
 
 		ScopedPointer<MemoryInputStream> mis = new MemoryInputStream(mb, true);
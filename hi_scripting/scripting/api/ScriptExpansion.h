@@ -60,6 +60,12 @@ public:
 	/** Enables Engine.undo() to restore the previous user preset (default is disabled). */
 	void setUseUndoForPresetLoading(bool shouldUseUndoManager);
 
+	/** Only applies the changed UI controls without suspending the audio if nothing else differs from the current state. */
+	void setUseIncrementalPresetLoading(bool shouldLoadIncrementally);
+
+	/** Returns an object with the timings and the number of applied changes of the last preset load. */
+	var getLastPresetLoadStatistics() const;
+
 	/** Sets a callback that will be executed synchronously before the preset was loaded*/
 	void setPreCallback(var presetPreCallback);
 
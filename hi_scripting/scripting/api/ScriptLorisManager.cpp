@@ -38,6 +38,7 @@ struct ScriptLorisManager::Wrapper
     API_VOID_METHOD_WRAPPER_2(ScriptLorisManager, set);
     API_METHOD_WRAPPER_1(ScriptLorisManager, get);
     API_METHOD_WRAPPER_2(ScriptLorisManager, analyse);
+    API_METHOD_WRAPPER_4(ScriptLorisManager, analyseBatch);
     API_METHOD_WRAPPER_1(ScriptLorisManager, synthesise);
     API_VOID_METHOD_WRAPPER_3(ScriptLorisManager, process);
     API_VOID_METHOD_WRAPPER_2(ScriptLorisManager, processCustom);
@@ -66,6 +67,7 @@ ScriptLorisManager::ScriptLorisManager(ProcessorWithScriptingContent* p):
     ADD_API_METHOD_2(set);
     ADD_API_METHOD_1(get);
     ADD_API_METHOD_2(analyse);
+    ADD_API_METHOD_4(analyseBatch);
     ADD_API_METHOD_1(synthesise);
     ADD_API_METHOD_3(process);
     ADD_API_METHOD_2(processCustom);
@@ -90,6 +92,37 @@ bool ScriptLorisManager::analyse(var file, double rootFrequency)
     return false;
 }
 
+bool ScriptLorisManager::analyseBatch(var fileList, var rootFrequencies, int numThreads, var cacheDirectory)
+{
+    initThreadController();
+
+    if(!fileList.isArray())
+        reportScriptError("fileList must be an array of files");
+
+    if(rootFrequencies.isArray() && rootFrequencies.size() != fileList.size())
+        reportScriptError("the number of root frequencies must match the number of files");
+
+    Array<LorisManager::AnalyseData> data;
+
+    for(int i = 0; i < fileList.size(); i++)
+    {
+        if(auto sf = dynamic_cast<ScriptingObjects::ScriptFile*>(fileList[i].getObject()))
+        {
+            auto rootFrequency = rootFrequencies.isArray() ? (double)rootFrequencies[i] : (double)rootFrequencies;
+            data.add({ sf->f, rootFrequency });
+        }
+        else
+            reportScriptError("fileList must be an array of files");
+    }
+
+    File cache;
+
+    if(auto sf = dynamic_cast<ScriptingObjects::ScriptFile*>(cacheDirectory.getObject()))
+        cache = sf->f;
+
+    return lorisManager->analyseBatch(data, numThreads, cache);
+}
+
 var ScriptLorisManager::synthesise(var file)
 {
     initThreadController();
@@ -61,6 +61,9 @@ public:
     /** Analyse a file. */
     bool analyse(var file, double estimatedRootFrequency);
     
+    /** Analyses a list of files on multiple threads (0 = all cores). The root frequency can be a single number or an array with a value for each file. If cacheDirectory is a folder, the partials are cached there. */
+    bool analyseBatch(var fileList, var estimatedRootFrequencies, int numThreads, var cacheDirectory);
+    
     /** Processes the partial list using predefined commands. */
     void process(var file, String command, var data);
     
@@ -1130,6 +1130,9 @@ struct ScriptingApi::Engine::Wrapper
 	API_METHOD_WRAPPER_0(Engine, getHostBpm);
 	API_VOID_METHOD_WRAPPER_1(Engine, setHostBpm);
 	API_METHOD_WRAPPER_0(Engine, getCpuUsage);
+	API_METHOD_WRAPPER_0(Engine, getCpuProfile);
+	API_VOID_METHOD_WRAPPER_0(Engine, resetCpuProfile);
+	API_METHOD_WRAPPER_0(Engine, getScriptQueueLatency);
 	API_METHOD_WRAPPER_0(Engine, getNumVoices);
 	API_METHOD_WRAPPER_0(Engine, getMemoryUsage);
 	API_METHOD_WRAPPER_1(Engine, getTempoName);
@@ -1283,6 +1286,9 @@ parentMidiProcessor(dynamic_cast<ScriptBaseMidiProcessor*>(p))
 	ADD_API_METHOD_0(getHostBpm);
 	ADD_TYPED_API_METHOD_1(setHostBpm, VarTypeChecker::Number);
 	ADD_API_METHOD_0(getCpuUsage);
+	ADD_API_METHOD_0(getCpuProfile);
+	ADD_API_METHOD_0(resetCpuProfile);
+	ADD_API_METHOD_0(getScriptQueueLatency);
 	ADD_API_METHOD_0(getNumVoices);
 	ADD_API_METHOD_0(getMemoryUsage);
 	ADD_API_METHOD_1(getTempoName);
@@ -1682,6 +1688,12 @@ double ScriptingApi::Engine::getMemoryUsage() const
 }
 
 double ScriptingApi::Engine::getCpuUsage() const { return (double)getProcessor()->getMainController()->getCpuUsage(); }
+
+var ScriptingApi::Engine::getCpuProfile() const { return getProcessor()->getMainController()->getCpuProfiler().toJSON(); }
+
+void ScriptingApi::Engine::resetCpuProfile() { getProcessor()->getMainController()->getCpuProfiler().reset(); }
+
+var ScriptingApi::Engine::getScriptQueueLatency() const { return getProcessor()->getMainController()->getJavascriptThreadPool().getQueueLatencyAsJSON(); }
 int ScriptingApi::Engine::getNumVoices() const { return getProcessor()->getMainController()->getNumActiveVoices(); }
 
 String ScriptingApi::Engine::getMacroName(int index)
@@ -520,6 +520,15 @@ public:
 		/** Returns the current CPU usage in percent (0 ... 100) */
 		double getCpuUsage() const;
 
+		/** Returns a JSON object with the render time statistics (in microseconds) of every module. */
+		var getCpuProfile() const;
+
+		/** Clears the render time statistics of the CPU profiler. */
+		void resetCpuProfile();
+
+		/** Returns a JSON object with the queue latency (in milliseconds) of every scripting task type. */
+		var getScriptQueueLatency() const;
+
 		/** Returns the amount of currently active voices. */
 		int getNumVoices() const;
 
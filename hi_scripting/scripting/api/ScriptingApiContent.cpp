@@ -274,6 +274,12 @@ struct ScriptingApi::Content::ScriptComponent::GlobalCableConnection : public sc
 		// do nothing for now - we don't want to change the UI values by global connections (yet)...
 	}
 
+	ThreadAffinity getThreadAffinity() const override
+	{
+		// the value is ignored anyways, so there's no need to call this from the sender
+		return ThreadAffinity::Polling;
+	}
+
 	Path getTargetIcon() const override
 	{
 		Path path;
@@ -4342,14 +4348,17 @@ void ScriptingApi::Content::ScriptPanel::internalRepaint(bool forceRepaint/*=fal
 			return Result::ok();
 		};
 
-		mc->getJavascriptThreadPool().addJob(JavascriptThreadPool::Task::LowPriorityCallbackExecution, jp, f);
+		mc->getJavascriptThreadPool().addJob(JavascriptThreadPool::Task::DeferredPanelRepaintJob, jp, f);
 	}
 }
 
 
 bool ScriptingApi::Content::ScriptPanel::internalRepaintIdle(bool forceRepaint, Result& r)
 {
-	jassert_locked_script_thread(dynamic_cast<Processor*>(getScriptProcessor())->getMainController());
+	auto mc = dynamic_cast<Processor*>(getScriptProcessor())->getMainController();
+
+	if (!mc->getJavascriptThreadPool().isPaintThread())
+		jassert_locked_script_thread(mc);
 
 	uint64_t lastId = 0;
 
@@ -4893,6 +4902,7 @@ void ScriptingApi::Content::ScriptPanel::setAnimation(String base64LottieAnimati
 		auto pos = getPosition();
 		animation->setScaleFactor(2.0f);
 		animation->setSize(pos.getWidth(), pos.getHeight());
+		animation->prerenderFrames();
 	}
 
 	setAnimationFrame(0);
@@ -7007,59 +7017,131 @@ void ScriptingApi::Content::restoreAllControlsFromPreset(const ValueTree &preset
 		}
 #endif
 
-		
-
 		static const Identifier id_("id");
 
 		auto presetChild = preset.getChildWithProperty(id_, components[i]->getName().toString());
 
-		var v;
+		sendRestoredControlValue(i, presetChild, macroNames);
+	}
+}
 
-		if (presetChild.isValid())
-		{
-			static const Identifier value_("value");
+Array<int> ScriptingApi::Content::getChangedControlsInPreset(const ValueTree &preset) const
+{
+	jassert(preset.getType().toString() == "Content");
+
+	static const Identifier id_("id");
+
+	auto currentState = exportAsValueTree();
+
+	Array<int> changedIndexes;
+
+	for (int i = 0; i < components.size(); i++)
+	{
+		if (!components[i]->getScriptObjectProperty(ScriptComponent::Properties::saveInPreset)) continue;
 
-			auto allowStrings = dynamic_cast<ScriptLabel*>(components[i].get()) != nullptr;
+		auto name = components[i]->getName().toString();
+		auto presetChild = preset.getChildWithProperty(id_, name);
+		auto currentChild = currentState.getChildWithProperty(id_, name);
 
-			v = Helpers::getCleanedComponentValue(presetChild.getProperty(value_), allowStrings);
+		// A missing preset child resets the control to its default so we treat it as change
+		if (presetChild.isValid() && Helpers::isEquivalentPresetData(presetChild, currentChild))
+			continue;
+
+		changedIndexes.add(i);
+	}
+
+	return changedIndexes;
+}
+
+void ScriptingApi::Content::restoreChangedControlsFromPreset(const ValueTree &preset, const Array<int>& changedIndexes)
+{
+	static const Identifier id_("id");
+
+	for (auto i : changedIndexes)
+	{
+		auto presetChild = preset.getChildWithProperty(id_, components[i]->getName().toString());
+
+		if (presetChild.isValid())
+		{
+			if (presetChild.getProperty("type").toString().isNotEmpty())
+				components[i]->restoreFromValueTree(presetChild);
 		}
 		else
 		{
 			components[i]->resetValueToDefault();
-			v = components[i]->getValue();
 		}
+	}
 
-		if (dynamic_cast<ScriptingApi::Content::ScriptLabel*>(components[i].get()) != nullptr)
-		{
-			getScriptProcessor()->controlCallback(components[i].get(), v);
-		}
-        else if (auto ssp = dynamic_cast<ScriptingApi::Content::ScriptSliderPack*>(components[i].get()))
-        {
-            // This must be restored again from the ValueTree in order to maintain the correct value
-            if(presetChild.isValid())
-				ssp->restoreFromValueTree(presetChild);
+	if (changedIndexes.isEmpty())
+		return;
 
-            getScriptProcessor()->controlCallback(ssp, ssp->getValue());
-        }
-		else if (v.isObject())
-		{
-			getScriptProcessor()->controlCallback(components[i].get(), v);
-		}
-		else
+	auto macroNames = getMacroNames();
+
+	for (auto i : changedIndexes)
+	{
+#if ENABLE_SCRIPTING_BREAKPOINTS
+		if (auto jsp = dynamic_cast<JavascriptProcessor*>(getScriptProcessor()))
 		{
-			getProcessor()->setAttribute(i, (float)v, sendNotificationAsync);
+			if (jsp->getLastErrorMessage().getErrorMessage().startsWith("Breakpoint"))
+			{
+				break;
+			}
 		}
+#endif
 
-		const String macroName = components[i]->getScriptObjectProperty(ScriptComponent::macroControl).toString();
+		auto presetChild = preset.getChildWithProperty(id_, components[i]->getName().toString());
+		sendRestoredControlValue(i, presetChild, macroNames);
+	}
+}
 
-		const int macroIndex = macroNames.indexOf(macroName) - 1;
+void ScriptingApi::Content::sendRestoredControlValue(int i, const ValueTree& presetChild, const StringArray& macroNames)
+{
+	var v;
 
-		if (macroIndex >= 0)
-		{
-			NormalisableRange<float> range(components[i]->getScriptObjectProperty(ScriptComponent::min), components[i]->getScriptObjectProperty(ScriptComponent::max));
+	if (presetChild.isValid())
+	{
+		static const Identifier value_("value");
 
-			getProcessor()->getMainController()->getMacroManager().getMacroChain()->setMacroControl(macroIndex, range.convertTo0to1(components[i]->getValue()) * 127.0f, sendNotification);
-		}
+		auto allowStrings = dynamic_cast<ScriptLabel*>(components[i].get()) != nullptr;
+
+		v = Helpers::getCleanedComponentValue(presetChild.getProperty(value_), allowStrings);
+	}
+	else
+	{
+		components[i]->resetValueToDefault();
+		v = components[i]->getValue();
+	}
+
+	if (dynamic_cast<ScriptingApi::Content::ScriptLabel*>(components[i].get()) != nullptr)
+	{
+		getScriptProcessor()->controlCallback(components[i].get(), v);
+	}
+	else if (auto ssp = dynamic_cast<ScriptingApi::Content::ScriptSliderPack*>(components[i].get()))
+	{
+		// This must be restored again from the ValueTree in order to maintain the correct value
+		if(presetChild.isValid())
+			ssp->restoreFromValueTree(presetChild);
+
+		getScriptProcessor()->controlCallback(ssp, ssp->getValue());
+	}
+	else if (v.isObject())
+	{
+		getScriptProcessor()->controlCallback(components[i].get(), v);
+	}
+	else
+	{
+		getProcessor()->setAttribute(i, (float)v, sendNotificationAsync);
+	}
+
+	const String macroName = components[i]->getScriptObjectProperty(ScriptComponent::macroControl).toString();
+
+	const int macroIndex = macroNames.indexOf(macroName) - 1;
+
+	if (macroIndex >= 0)
+	{
+		NormalisableRange<float> range(components[i]->getScriptObjectProperty(ScriptComponent::min), components[i]->getScriptObjectProperty(ScriptComponent::max));
+
+		getProcessor()->getMainController()->getMacroManager().getMacroChain()->setMacroControl(macroIndex, range.convertTo0to1(components[i]->getValue()) * 127.0f, sendNotification);
 	}
 }
 
@@ -8585,6 +8667,49 @@ var ScriptingApi::Content::Helpers::getCleanedComponentValue(const var& data, bo
 	}
 }
 
+bool ScriptingApi::Content::Helpers::isEquivalentPresetData(const ValueTree& a, const ValueTree& b)
+{
+	if (a.getType() != b.getType() || a.getNumProperties() != b.getNumProperties() || a.getNumChildren() != b.getNumChildren())
+		return false;
+
+	// Compare each property by name because the order of a loaded preset might differ from the exported state
+	for (int i = 0; i < a.getNumProperties(); i++)
+	{
+		auto id = a.getPropertyName(i);
+
+		if (!b.hasProperty(id))
+			return false;
+
+		auto va = a.getProperty(id);
+		auto vb = b.getProperty(id);
+
+		// A preset loaded from XML stores numbers as strings
+		if (va.isString() != vb.isString())
+		{
+			auto s = va.isString() ? va.toString() : vb.toString();
+
+			if (s.isNotEmpty() && s.containsOnly("0123456789.-+eE"))
+			{
+				if ((double)va != (double)vb)
+					return false;
+
+				continue;
+			}
+		}
+
+		if (va != vb)
+			return false;
+	}
+
+	for (int i = 0; i < a.getNumChildren(); i++)
+	{
+		if (!isEquivalentPresetData(a.getChild(i), b.getChild(i)))
+			return false;
+	}
+
+	return true;
+}
+
 bool ScriptingApi::Content::interfaceCreationAllowed() const
 {
 	return allowGuiCreation;
@@ -2751,6 +2751,12 @@ public:
 	// Restores the content and sets the attributes so that the macros and the control callbacks gets executed.
 	void restoreAllControlsFromPreset(const ValueTree &preset);
 
+	/** Returns the indexes of the controls that are saved in presets and differ from the given preset. */
+	Array<int> getChangedControlsInPreset(const ValueTree &preset) const;
+
+	/** Restores only the given controls (use getChangedControlsInPreset() to find them). */
+	void restoreChangedControlsFromPreset(const ValueTree &preset, const Array<int>& changedIndexes);
+
 	Colour getColour() const { return colour; };
 	void endInitialization();
 
@@ -2892,6 +2898,7 @@ public:
 		static bool hasLocation(ScriptComponent* sc);
 		static void sanitizeNumberProperties(juce::ValueTree copy);
 		static var getCleanedComponentValue(const var& data, bool allowStrings);
+		static bool isEquivalentPresetData(const ValueTree& a, const ValueTree& b);
 	};
 
 	template <class SubType> SubType* createNewComponent(const Identifier& id, int x, int y)
@@ -2978,6 +2985,8 @@ public:
 
 private:
 
+	void sendRestoredControlValue(int componentIndex, const ValueTree& presetChild, const StringArray& macroNames);
+
 	WeakCallbackHolder dragCallback;
 	WeakCallbackHolder suspendCallback;
 
@@ -7236,6 +7236,10 @@ ScriptingObjects::ScriptFFT::ScriptFFT(ProcessorWithScriptingContent* p) :
 	ADD_API_METHOD_1(setSpectrum2DParameters);
 	ADD_API_METHOD_0(getSpectrum2DParameters);
 	ADD_API_METHOD_2(dumpSpectrum);
+	ADD_API_METHOD_1(processChunk);
+	ADD_API_METHOD_0(resetStream);
+	ADD_API_METHOD_2(setEnableMagnitudeOutput);
+	ADD_API_METHOD_1(setNumThreads);
 	
 	spectrumParameters = new Spectrum2D::Parameters();
 }
@@ -7364,7 +7368,7 @@ void ScriptingObjects::ScriptFFT::prepare(int powerOfTwoSize, int maxNumChannels
 
 		maxNumSamples = powerOfTwoSize;
 
-		Array<var> newWorkBuffer;
+		scratchBuffers.clear();
 
 		for (int i = 0; i < maxNumChannels; i++)
 		{
@@ -7374,7 +7378,7 @@ void ScriptingObjects::ScriptFFT::prepare(int powerOfTwoSize, int maxNumChannels
 			if (enableInverse)
 				wb.chunkOutput = new VariantBuffer(maxNumSamples * 2);
 
-			if(magnitudeFunction || enableInverse)
+			if(magnitudeFunction || enableInverse || enableMagnitudeOutput)
 				wb.magBuffer = new VariantBuffer(maxNumSamples);
 
 			if (phaseFunction || enableInverse)
@@ -7385,7 +7389,8 @@ void ScriptingObjects::ScriptFFT::prepare(int powerOfTwoSize, int maxNumChannels
 			
 		SimpleReadWriteLock::ScopedWriteLock sl(lock);
 
-		fft = new juce::dsp::FFT(log2(maxNumSamples));
+		fft = planCache->getPlan(log2(maxNumSamples));
+		resetStream();
 	}
 	else
 	{
@@ -7433,13 +7438,12 @@ var ScriptingObjects::ScriptFFT::process(var dataToProcess)
 
 	SimpleReadWriteLock::ScopedReadLock sl(lock);
 
-	if (magnitudeFunction || phaseFunction)
+	if (magnitudeFunction || phaseFunction || enableMagnitudeOutput)
 	{
-		var returnValue;
-
+		if (enableMagnitudeOutput && enableInverse)
+			reportScriptError("The magnitude output can't be used with the inverse FFT");
 
-		int offset = 0;
-		int numDelta = roundToInt((double)maxNumSamples * (1.0 - overlap));
+		var returnValue;
 
 		auto numToProcess = getNumToProcess(dataToProcess);
 		int numChannels = dataToProcess.isArray() ? dataToProcess.size() : 1;
@@ -7459,43 +7463,36 @@ var ScriptingObjects::ScriptFFT::process(var dataToProcess)
 				returnValue = var(outputData);
 		}
 
-		while (offset < numToProcess)
+		if (threadPool != nullptr)
 		{
-			copyToWorkBuffer(dataToProcess, offset, 0);
+			auto magnitudeFrames = processMultithreaded(dataToProcess, numChannels, numToProcess);
 
-			var args[2];
-			args[1] = offset;
-
-			applyFFT(numChannels, offset == 0);
-
-			if (magnitudeFunction)
-			{
-				args[0] = getBufferArgs(true, numChannels);
-				auto r = magnitudeFunction.callSync(args, 2);
+			if (enableMagnitudeOutput)
+				returnValue = magnitudeFrames;
+		}
+		else
+		{
+			Array<var> magnitudeFrames;
 
-				if (!r.wasOk())
-					reportScriptError(r.getErrorMessage());
-			}
+			int offset = 0;
+			int numDelta = getHopSize();
 
-			if (phaseFunction)
+			while (offset < numToProcess)
 			{
-				args[0] = getBufferArgs(false, numChannels);
+				copyToWorkBuffer(dataToProcess, offset, 0);
 
-				auto r = phaseFunction.callSync(args, 2);
+				processFrame(numChannels, offset, offset == 0, enableMagnitudeOutput ? &magnitudeFrames : nullptr);
 
-				if (!r.wasOk())
-					reportScriptError(r.getErrorMessage());
-			}
-
-			applyInverseFFT(numChannels);
+				for (int i = 0; i < numChannels; i++)
+				{
+					copyFromWorkBuffer(offset, i);
+				}
 
-			for (int i = 0; i < numChannels; i++)
-			{
-				copyFromWorkBuffer(offset, i);
+				offset += numDelta;
 			}
-			
 
-			offset += numDelta;
+			if (enableMagnitudeOutput)
+				returnValue = var(magnitudeFrames);
 		}
 
 		if (enableSpectrum)
@@ -7553,6 +7550,129 @@ var ScriptingObjects::ScriptFFT::getSpectrum2DParameters() const
 	return d;
 }
 
+var ScriptingObjects::ScriptFFT::processChunk(var chunkToAdd)
+{
+	TRACE_EVENT("scripting", "process FFT chunk");
+
+	if (scratchBuffers.isEmpty() || fft == nullptr || maxNumSamples == 0)
+		reportScriptError("You must call prepare before processChunk");
+
+	if (enableInverse)
+		reportScriptError("The streaming mode doesn't support the inverse FFT");
+
+	SimpleReadWriteLock::ScopedReadLock sl(lock);
+
+	if (!(magnitudeFunction || phaseFunction || enableMagnitudeOutput))
+		reportScriptError("the process function is not defined");
+
+	Array<VariantBuffer*> inputs;
+
+	if (auto a = chunkToAdd.getArray())
+	{
+		for (auto& c : *a)
+			inputs.add(c.getBuffer());
+	}
+	else
+		inputs.add(chunkToAdd.getBuffer());
+
+	if (inputs.contains(nullptr))
+		reportScriptError("processChunk needs a buffer or an array of buffers");
+
+	auto numChannels = inputs.size();
+	auto numToAdd = inputs[0]->size;
+
+	if (numChannels > scratchBuffers.size())
+		reportScriptError("Channel amount mismatch");
+
+	for (auto b : inputs)
+	{
+		if (b->size != numToAdd)
+			reportScriptError("All channels must have the same length");
+	}
+
+	if (streamBuffer.getNumChannels() != numChannels || streamBuffer.getNumSamples() != maxNumSamples)
+	{
+		streamBuffer.setSize(numChannels, maxNumSamples);
+		numStreamSamples = 0;
+		streamPosition = 0;
+	}
+
+	Array<var> magnitudeFrames;
+	auto numDelta = getHopSize();
+	int readIndex = 0;
+
+	while (readIndex < numToAdd)
+	{
+		auto numToCopy = jmin(numToAdd - readIndex, maxNumSamples - numStreamSamples);
+
+		for (int i = 0; i < numChannels; i++)
+			streamBuffer.copyFrom(i, numStreamSamples, inputs[i]->buffer, 0, readIndex, numToCopy);
+
+		numStreamSamples += numToCopy;
+		readIndex += numToCopy;
+
+		if (numStreamSamples == maxNumSamples)
+		{
+			for (int i = 0; i < numChannels; i++)
+			{
+				auto dst = scratchBuffers[i].chunkInput;
+				dst->clear();
+				dst->buffer.copyFrom(0, 0, streamBuffer, i, 0, maxNumSamples);
+			}
+
+			processFrame(numChannels, streamPosition, streamPosition == 0, enableMagnitudeOutput ? &magnitudeFrames : nullptr);
+
+			// Keep the overlapping part for the next frame
+			numStreamSamples = maxNumSamples - numDelta;
+
+			for (int i = 0; i < numChannels; i++)
+			{
+				auto d = streamBuffer.getWritePointer(i);
+				std::memmove(d, d + numDelta, sizeof(float) * (size_t)numStreamSamples);
+			}
+
+			streamPosition += numDelta;
+		}
+	}
+
+	if (enableMagnitudeOutput)
+		return var(magnitudeFrames);
+
+	return var();
+}
+
+void ScriptingObjects::ScriptFFT::resetStream()
+{
+	streamBuffer.clear();
+	numStreamSamples = 0;
+	streamPosition = 0;
+}
+
+void ScriptingObjects::ScriptFFT::setEnableMagnitudeOutput(bool shouldReturnMagnitudes, bool convertToDecibels)
+{
+	SimpleReadWriteLock::ScopedWriteLock sl(lock);
+
+	convertMagnitudesToDecibel = convertToDecibels;
+
+	if (enableMagnitudeOutput != shouldReturnMagnitudes)
+	{
+		enableMagnitudeOutput = shouldReturnMagnitudes;
+		reinitialise();
+	}
+}
+
+void ScriptingObjects::ScriptFFT::setNumThreads(int numThreadsToUse)
+{
+	SimpleReadWriteLock::ScopedWriteLock sl(lock);
+
+	numThreadsToUse = jlimit(1, SystemStats::getNumCpus(), numThreadsToUse);
+
+	if (numThreadsToUse > 1)
+		threadPool = new ParallelForPool(numThreadsToUse);
+	else
+		threadPool = nullptr;
+}
+
 bool ScriptingObjects::ScriptFFT::dumpSpectrum(var file, bool output)
 {
 	auto img = output ? outputSpectrum : spectrum;
@@ -7654,48 +7774,247 @@ void ScriptingObjects::ScriptFFT::applyFFT(int numChannelsThisTime, bool skipFir
 	if (numChannelsThisTime > scratchBuffers.size())
 		reportScriptError("Channel amount mismatch");
 
+	auto needsPhases = phaseFunction || enableInverse;
+	auto needsMagnitudes = magnitudeFunction || enableInverse || enableMagnitudeOutput;
+
 	for (int i = 0; i < numChannelsThisTime; i++)
 	{
 		auto wb = scratchBuffers[i];
 
-		// Apply window here...
-		
+		if (needsMagnitudes && wb.magBuffer == nullptr)
+			reportScriptError("The magnitude buffer is not prepared. Make sure to call prepare after setMagnitudeFunction");
+
+		forwardTransform(*fft, windowBuffer, wb.chunkInput->buffer,
+			             needsMagnitudes ? &wb.magBuffer->buffer : nullptr,
+			             needsPhases ? &wb.phaseBuffer->buffer : nullptr,
+			             convertMagnitudesToDecibel, skipFirstWindowHalf);
+	}
+}
+
+void ScriptingObjects::ScriptFFT::forwardTransform(const juce::dsp::FFT& f, const AudioSampleBuffer& window, AudioSampleBuffer& work, AudioSampleBuffer* magnitudes, AudioSampleBuffer* phases, bool convertToDecibels, bool skipFirstWindowHalf)
+{
+	// Apply window here...
+
+	{
+		auto wdst = work.getWritePointer(0);
+		auto wsrc = window.getReadPointer(0);
+		auto windowSize = window.getNumSamples();
+
+		if (skipFirstWindowHalf)
 		{
-			auto wdst = wb.chunkInput->buffer.getWritePointer(0);
-			auto wsrc = windowBuffer.getReadPointer(0);
-			auto windowSize = windowBuffer.getNumSamples();
+			auto firstHalf = windowSize / 4;
 
-			if (skipFirstWindowHalf)
+			wdst += firstHalf;
+			wsrc += firstHalf;
+			windowSize -= firstHalf;
+		}
+
+		FloatVectorOperations::multiply(wdst, wsrc, windowSize);
+	}
+
+	f.performRealOnlyForwardTransform(work.getWritePointer(0), false);
+
+	if (phases != nullptr)
+		FFTHelpers::toPhaseSpectrum(work, *phases);
+
+	if (magnitudes != nullptr)
+	{
+		FFTHelpers::toFreqSpectrum(work, *magnitudes);
+		FFTHelpers::scaleFrequencyOutput(*magnitudes, convertToDecibels);
+	}
+}
+
+void ScriptingObjects::ScriptFFT::inverseTransform(const juce::dsp::FFT& f, AudioSampleBuffer& magnitudes, AudioSampleBuffer& phases, AudioSampleBuffer& output, bool convertToDecibels)
+{
+	FFTHelpers::scaleFrequencyOutput(magnitudes, convertToDecibels, true);
+	FFTHelpers::toComplexArray(phases, magnitudes, output);
+
+	f.performRealOnlyInverseTransform(output.getWritePointer(0));
+}
+
+void ScriptingObjects::ScriptFFT::processFrame(int numChannels, int64 offset, bool skipFirstWindowHalf, Array<var>* magnitudeOutput)
+{
+	applyFFT(numChannels, skipFirstWindowHalf);
+
+	if (magnitudeOutput != nullptr)
+	{
+		magnitudeOutput->add(createMagnitudeFrame(numChannels, [this](int c) -> const AudioSampleBuffer&
+		{
+			return scratchBuffers.getReference(c).magBuffer->buffer;
+		}));
+	}
+
+	callScriptFunctions(numChannels, offset);
+	applyInverseFFT(numChannels);
+}
+
+void ScriptingObjects::ScriptFFT::callScriptFunctions(int numChannels, int64 offset)
+{
+	var args[2];
+	args[1] = offset;
+
+	if (magnitudeFunction)
+	{
+		args[0] = getBufferArgs(true, numChannels);
+		auto r = magnitudeFunction.callSync(args, 2);
+
+		if (!r.wasOk())
+			reportScriptError(r.getErrorMessage());
+	}
+
+	if (phaseFunction)
+	{
+		args[0] = getBufferArgs(false, numChannels);
+
+		auto r = phaseFunction.callSync(args, 2);
+
+		if (!r.wasOk())
+			reportScriptError(r.getErrorMessage());
+	}
+}
+
+var ScriptingObjects::ScriptFFT::createMagnitudeFrame(int numChannels, const std::function<const AudioSampleBuffer&(int)>& getMagnitudes) const
+{
+	Array<var> channels;
+
+	for (int i = 0; i < numChannels; i++)
+	{
+		auto& m = getMagnitudes(i);
+
+		VariantBuffer::Ptr b = new VariantBuffer(m.getNumSamples());
+		b->buffer.copyFrom(0, 0, m, 0, 0, m.getNumSamples());
+		channels.add(var(b.get()));
+	}
+
+	if (channels.size() == 1)
+		return channels[0];
+
+	return var(channels);
+}
+
+var ScriptingObjects::ScriptFFT::processMultithreaded(var dataToProcess, int numChannels, int numToProcess)
+{
+	if (numChannels > scratchBuffers.size())
+		reportScriptError("Channel amount mismatch");
+
+	Array<VariantBuffer*> inputs;
+
+	if (auto a = dataToProcess.getArray())
+	{
+		for (auto& d : *a)
+			inputs.add(d.getBuffer());
+	}
+	else
+		inputs.add(dataToProcess.getBuffer());
+
+	if (inputs.contains(nullptr))
+		reportScriptError("Illegal input data");
+
+	auto numDelta = getHopSize();
+	auto numFrames = (numToProcess + numDelta - 1) / numDelta;
+
+	auto needsMagnitudes = magnitudeFunction || enableInverse || enableMagnitudeOutput;
+	auto needsPhases = phaseFunction || enableInverse;
+
+	std::vector<FrameChannel> frames((size_t)(numFrames * numChannels));
+
+	// Transform all frames in parallel...
+	threadPool->parallelFor((int)frames.size(), [&](int index)
+	{
+		auto& fc = frames[index];
+		auto offset = (index / numChannels) * numDelta;
+		auto input = inputs[index % numChannels];
+
+		fc.work.setSize(1, maxNumSamples * 2);
+		fc.work.clear();
+
+		auto numToCopy = jmin(input->size - offset, maxNumSamples);
+
+		if (numToCopy > 0)
+			fc.work.copyFrom(0, 0, input->buffer, 0, offset, numToCopy);
+
+		if (needsMagnitudes)
+			fc.magnitudes.setSize(1, maxNumSamples);
+
+		if (needsPhases)
+			fc.phases.setSize(1, maxNumSamples);
+
+		forwardTransform(*fft, windowBuffer, fc.work,
+			             needsMagnitudes ? &fc.magnitudes : nullptr,
+			             needsPhases ? &fc.phases : nullptr,
+			             convertMagnitudesToDecibel, offset == 0);
+	});
+
+	Array<var> magnitudeFrames;
+
+	// ...call the script functions in the original order...
+	for (int i = 0; i < numFrames; i++)
+	{
+		auto frame = frames.data() + i * numChannels;
+
+		if (enableMagnitudeOutput)
+		{
+			magnitudeFrames.add(createMagnitudeFrame(numChannels, [frame](int c) -> const AudioSampleBuffer&
 			{
-				auto firstHalf = windowSize / 4;
+				return frame[c].magnitudes;
+			}));
+		}
 
-				//FloatVectorOperations::multiply(wdst, 2.0f, firstHalf);
+		if (!(magnitudeFunction || phaseFunction))
+			continue;
 
-				wdst += firstHalf;
-				wsrc += firstHalf;
-				windowSize -= firstHalf;
-			}
+		for (int c = 0; c < numChannels; c++)
+		{
+			auto& wb = scratchBuffers.getReference(c);
 
-			FloatVectorOperations::multiply(wdst, wsrc, windowSize);
+			if (magnitudeFunction && wb.magBuffer != nullptr)
+				wb.magBuffer->buffer.copyFrom(0, 0, frame[c].magnitudes, 0, 0, maxNumSamples);
+
+			if (phaseFunction && wb.phaseBuffer != nullptr)
+				wb.phaseBuffer->buffer.copyFrom(0, 0, frame[c].phases, 0, 0, maxNumSamples);
 		}
-		
 
-		fft->performRealOnlyForwardTransform(wb.chunkInput->buffer.getWritePointer(0), false);
+		callScriptFunctions(numChannels, i * numDelta);
 
-		if (phaseFunction || enableInverse)
+		if (enableInverse)
 		{
-			FFTHelpers::toPhaseSpectrum(wb.chunkInput->buffer, wb.phaseBuffer->buffer);
+			for (int c = 0; c < numChannels; c++)
+			{
+				auto& wb = scratchBuffers.getReference(c);
+
+				if (magnitudeFunction)
+					frame[c].magnitudes.copyFrom(0, 0, wb.magBuffer->buffer, 0, 0, maxNumSamples);
+
+				if (phaseFunction)
+					frame[c].phases.copyFrom(0, 0, wb.phaseBuffer->buffer, 0, 0, maxNumSamples);
+			}
 		}
+	}
 
-		if (magnitudeFunction || enableInverse)
+	// ...and reconstruct the signal in parallel with a serial overlap-add
+	if (enableInverse)
+	{
+		threadPool->parallelFor((int)frames.size(), [&](int index)
 		{
-            if(wb.magBuffer == nullptr)
-                reportScriptError("The magnitude buffer is not prepared. Make sure to call prepare after setMagnitudeFunction");
-            
-			FFTHelpers::toFreqSpectrum(wb.chunkInput->buffer, wb.magBuffer->buffer);
-			FFTHelpers::scaleFrequencyOutput(wb.magBuffer->buffer, convertMagnitudesToDecibel);
+			auto& fc = frames[index];
+			inverseTransform(*fft, fc.magnitudes, fc.phases, fc.work, convertMagnitudesToDecibel);
+		});
+
+		for (int i = 0; i < (int)frames.size(); i++)
+		{
+			auto offset = (i / numChannels) * numDelta;
+
+			if (auto out = outputData[i % numChannels].getBuffer())
+			{
+				auto numToCopy = jmin(frames[i].work.getNumSamples(), out->size - offset);
+
+				if (numToCopy > 0)
+					out->buffer.addFrom(0, offset, frames[i].work, 0, 0, numToCopy);
+			}
 		}
 	}
+
+	return var(magnitudeFrames);
 }
 
 void ScriptingObjects::ScriptFFT::applyInverseFFT(int numChannelsThisTime)
@@ -7709,11 +8028,7 @@ void ScriptingObjects::ScriptFFT::applyInverseFFT(int numChannelsThisTime)
 	for (int i = 0; i < numChannelsThisTime; i++)
 	{
 		auto wb = scratchBuffers[i];
-		
-		FFTHelpers::scaleFrequencyOutput(wb.magBuffer->buffer, convertMagnitudesToDecibel, true);
-		FFTHelpers::toComplexArray(wb.phaseBuffer->buffer, wb.magBuffer->buffer, wb.chunkOutput->buffer);
-
-		fft->performRealOnlyInverseTransform(wb.chunkOutput->buffer.getWritePointer(0));
+		inverseTransform(*fft, wb.magBuffer->buffer, wb.phaseBuffer->buffer, wb.chunkOutput->buffer, convertMagnitudesToDecibel);
 	}
 }
 
@@ -8120,11 +8435,9 @@ void ScriptingObjects::GlobalCableReference::setRangeWithStep(double min, double
 	inputRange.checkIfIdentity();
 }
 
-struct ScriptingObjects::GlobalCableReference::Callback: public scriptnode::routing::GlobalRoutingManager::CableTargetBase,
-														 public PooledUIUpdater::SimpleTimer
+struct ScriptingObjects::GlobalCableReference::Callback: public scriptnode::routing::GlobalRoutingManager::CableTargetBase
 {
 	Callback(GlobalCableReference& p, const var& f, bool synchronous) :
-		SimpleTimer(p.getScriptProcessor()->getMainController_()->getGlobalUIUpdater()),
 		parent(p),
 		sync(synchronous),
 		callback(p.getScriptProcessor(), &p, f, 1)
@@ -8149,29 +8462,9 @@ struct ScriptingObjects::GlobalCableReference::Callback: public scriptnode::rout
 			{
 				c->addTarget(this);
 			}
-
-			if (!synchronous)
-				start();
-			else
-				stop();
-		}
-		else
-		{
-			stop();
 		}
 	}
 
-	void timerCallback() override
-	{
-		if (sync)
-			return;
-
-		double nv;
-
-		if (value.getChangedValue(nv))
-			callback.call1(nv);
-	}
-
 	String getTargetId() const override { return id; }
 
 	Path getTargetIcon() const override
@@ -8181,6 +8474,12 @@ struct ScriptingObjects::GlobalCableReference::Callback: public scriptnode::rout
 		return path;
 	}
 
+	ThreadAffinity getThreadAffinity() const override
+	{
+		// asynchronous callbacks are called with the latest value by the cable dispatcher
+		return sync ? ThreadAffinity::Sender : ThreadAffinity::UIThread;
+	}
+
 	void selectCallback(Component* rootEditor) override
 	{
 #if USE_BACKEND
@@ -8213,7 +8512,13 @@ struct ScriptingObjects::GlobalCableReference::Callback: public scriptnode::rout
             callback.callSync(&a, 1);
 		}
 		else
-			value.setModValueIfChanged(v);
+		{
+			// this is already called by the UI timer, so we can call the function directly
+			double nv;
+
+			if (value.setModValueIfChanged(v) && value.getChangedValue(nv))
+				callback.call1(nv);
+		}
 	}
 
 	~Callback()
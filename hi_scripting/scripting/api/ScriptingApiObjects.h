@@ -705,6 +705,10 @@ namespace ScriptingObjects
 			API_VOID_METHOD_WRAPPER_1(ScriptFFT, setSpectrum2DParameters);
 			API_METHOD_WRAPPER_0(ScriptFFT, getSpectrum2DParameters);
 			API_METHOD_WRAPPER_2(ScriptFFT, dumpSpectrum);
+			API_METHOD_WRAPPER_1(ScriptFFT, processChunk);
+			API_VOID_METHOD_WRAPPER_0(ScriptFFT, resetStream);
+			API_VOID_METHOD_WRAPPER_2(ScriptFFT, setEnableMagnitudeOutput);
+			API_VOID_METHOD_WRAPPER_1(ScriptFFT, setNumThreads);
 		};
 
 		ScriptFFT(ProcessorWithScriptingContent* pwsc);
@@ -755,6 +759,18 @@ namespace ScriptingObjects
 		/** Dumps the spectrum image to the given file (as PNG image). */
 		bool dumpSpectrum(var file, bool output);
 
+		/** Adds a chunk of audio (either a buffer or an array of buffers) to the stream and processes every frame that was completed. */
+		var processChunk(var chunkToAdd);
+
+		/** Clears the samples that were added with processChunk() and starts a new stream. */
+		void resetStream();
+
+		/** Enables the native magnitude output. If enabled, process() and processChunk() return an array with the magnitudes of every frame. */
+		void setEnableMagnitudeOutput(bool shouldReturnMagnitudes, bool convertToDecibels);
+
+		/** Sets the number of threads that are used for transforming the frames in process(). */
+		void setNumThreads(int numThreadsToUse);
+
 		// ======================================================================================================= End of API Methods
 
 		Image getSpectrum(bool getOutput) const { return getOutput ? outputSpectrum : spectrum; }
@@ -788,6 +804,27 @@ namespace ScriptingObjects
 
 		static int getNumToProcess(var inputData);
 
+		struct FrameChannel
+		{
+			AudioSampleBuffer work;
+			AudioSampleBuffer magnitudes;
+			AudioSampleBuffer phases;
+		};
+
+		static void forwardTransform(const juce::dsp::FFT& f, const AudioSampleBuffer& window, AudioSampleBuffer& work, AudioSampleBuffer* magnitudes, AudioSampleBuffer* phases, bool convertToDecibels, bool skipFirstWindowHalf);
+
+		static void inverseTransform(const juce::dsp::FFT& f, AudioSampleBuffer& magnitudes, AudioSampleBuffer& phases, AudioSampleBuffer& output, bool convertToDecibels);
+
+		var processMultithreaded(var dataToProcess, int numChannels, int numToProcess);
+
+		void processFrame(int numChannels, int64 offset, bool skipFirstWindowHalf, Array<var>* magnitudeOutput);
+
+		void callScriptFunctions(int numChannels, int64 offset);
+
+		var createMagnitudeFrame(int numChannels, const std::function<const AudioSampleBuffer&(int)>& getMagnitudes) const;
+
+		int getHopSize() const { return jmax(1, roundToInt((double)maxNumSamples * (1.0 - overlap))); }
+
 		void copyToWorkBuffer(var inputData, int offset, int channel);
 
 		void copyFromWorkBuffer(int offset, int channel);
@@ -812,7 +849,17 @@ namespace ScriptingObjects
 
 		Array<var> outputData;
 
-		ScopedPointer<juce::dsp::FFT> fft;
+		SharedResourcePointer<FFTHelpers::PlanCache> planCache;
+		juce::dsp::FFT* fft = nullptr;
+
+		bool enableMagnitudeOutput = false;
+
+		AudioSampleBuffer streamBuffer;
+		int numStreamSamples = 0;
+		int64 streamPosition = 0;
+
+		ScopedPointer<ParallelForPool> threadPool;
+
 		WeakCallbackHolder magnitudeFunction;
 		WeakCallbackHolder phaseFunction;
 
@@ -577,6 +577,12 @@ struct HiseJavascriptEngine::RootObject::Scope
 	{
 		ignoreUnused(location);
 
+		if (root->threadPool != nullptr && root->threadPool->isPreemptionPending())
+		{
+			if (auto ms = root->threadPool->preemptLowPriorityTask())
+				root->timeout = Time(root->timeout.toMilliseconds() + ms);
+		}
+
 #if USE_BACKEND
 		if (Time::getCurrentTime() > root->timeout)
 			location.throwError("Execution timed-out");
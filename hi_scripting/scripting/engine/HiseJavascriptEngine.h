@@ -401,6 +401,9 @@ public:
 
 		Time timeout;
 
+		/** Used to check whether a pending high priority task should preempt the current callback. */
+		JavascriptThreadPool* threadPool = nullptr;
+
 		Array<Breakpoint> breakpoints;
 
 		typedef const var::NativeFunctionArgs& Args;
@@ -153,6 +153,7 @@ HiseJavascriptEngine::HiseJavascriptEngine(JavascriptProcessor *p, MainControlle
 {
     
 	root->hiseSpecialData.setProcessor(p);
+	root->threadPool = &mc->getJavascriptThreadPool();
 
     preprocessor = dynamic_cast<HiseJavascriptPreprocessor*>(mc->getGlobalPreprocessor());
     root->preprocessor = preprocessor;
@@ -1035,6 +1035,308 @@ struct ScriptNodeTests : public juce::UnitTest
 
 static ScriptNodeTests snt;
 
+#if USE_BACKEND
+
+/** Compares the CPU usage of a frame container that is processed dynamically (per frame or blockwise),
+	as fused JIT network and as the C++ template code that a frozen network compiles to. */
+struct FrameContainerBenchmark : public juce::UnitTest
+{
+	static constexpr int NumGroups = 8;
+	static constexpr int BlockSize = 512;
+	static constexpr double SampleRate = 44100.0;
+
+	using Group = container::chain<parameter::empty, wrap::fix<2, math::add<1>>, math::mul<1>, math::tanh<1>>;
+	using FrozenType = wrap::frame<2, container::chain<parameter::empty, wrap::fix<2, Group>, Group, Group, Group, Group, Group, Group, Group>>;
+
+	FrameContainerBenchmark() :
+		UnitTest("Frame container benchmark", "Benchmark")
+	{}
+
+	void runTest() override
+	{
+		ScopedValueSetter<bool> s(MainController::unitTestMode, true);
+
+		bp = new BackendProcessor(nullptr, nullptr);
+
+		createNetwork();
+		createInput();
+
+		auto dynamicOutput = testDynamic(false);
+		auto blockOutput = testDynamic(true);
+
+		expectBuffersMatch(dynamicOutput, blockOutput, "blockwise");
+
+#if HISE_INCLUDE_SNEX
+		testFused(dynamicOutput);
+#endif
+
+		testFrozen(dynamicOutput);
+
+		network = nullptr;
+		bp = nullptr;
+	}
+
+private:
+
+	static void setGroupValues(Group& g)
+	{
+		g.get<0>().getObject().setValue(0.05);
+		g.get<1>().setValue(1.1);
+		g.get<2>().setValue(1.0);
+	}
+
+	template <size_t... I> static void setFrozenValues(FrozenType& f, std::index_sequence<I...>)
+	{
+		(setGroupValues(f.getObject().template get<I>().getObject()), ...);
+	}
+
+	void createNetwork()
+	{
+		beginTest("Creating network with " + String(NumGroups * 3) + " nodes in a frame container");
+
+		auto fxChain = dynamic_cast<EffectProcessorChain*>(bp->getMainSynthChain()->getChildProcessor(ModulatorSynth::EffectChain));
+
+		auto fx = new JavascriptMasterEffect(bp, "ScriptFX");
+		fxChain->getHandler()->add(fx, nullptr);
+
+		network = fx->getOrCreate("benchmark");
+
+		auto frame = network->createAndAdd("container.frame2_block", "frame", var(network.get()));
+
+		auto container = dynamic_cast<NodeBase*>(frame.getObject());
+		expect(container != nullptr, "frame container wasn't created");
+
+		if (container == nullptr)
+			return;
+
+		network->setAllowFrameBlockProcessing(false);
+
+		const std::pair<String, double> nodes[3] = { { "math.add", 0.05 }, { "math.mul", 1.1 }, { "math.tanh", 1.0 } };
+
+		for (int i = 0; i < NumGroups; i++)
+		{
+			for (const auto& n : nodes)
+			{
+				auto node = dynamic_cast<NodeBase*>(network->createAndAdd(n.first, {}, frame).getObject());
+				node->getParameterFromIndex(0)->setValueSync(n.second);
+			}
+		}
+
+		expectEquals(container->getValueTree().getChildWithName(PropertyIds::Nodes).getNumChildren(), NumGroups * 3, "wrong node amount");
+
+		network->setNumChannels(2);
+		network->prepareToPlay(SampleRate, BlockSize);
+	}
+
+	void createInput()
+	{
+		input.setSize(2, BlockSize);
+
+		for (int i = 0; i < BlockSize; i++)
+		{
+			auto v = 0.5f * std::sin((float)i * 0.05f);
+			input.setSample(0, i, v);
+			input.setSample(1, i, -v);
+		}
+	}
+
+	void expectBuffersMatch(const AudioSampleBuffer& a, const AudioSampleBuffer& b, const String& mode)
+	{
+		float maxError = 0.0f;
+
+		for (int c = 0; c < 2; c++)
+			for (int i = 0; i < BlockSize; i++)
+				maxError = jmax(maxError, std::abs(a.getSample(c, i) - b.getSample(c, i)));
+
+		expect(maxError < 1e-4f, mode + " output mismatch: " + String(maxError));
+	}
+
+	template <typename F> void measure(const String& mode, const F& processBlock)
+	{
+		const int numBlocks = roundToInt(2.0 * SampleRate / (double)BlockSize);
+
+		AudioSampleBuffer b(2, BlockSize);
+
+		auto start = Time::getHighResolutionTicks();
+
+		for (int i = 0; i < numBlocks; i++)
+		{
+			b.makeCopyOf(input, true);
+			processBlock(b);
+		}
+
+		auto renderSeconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+		auto audioSeconds = (double)(numBlocks * BlockSize) / SampleRate;
+
+		logMessage(mode + ": " + String(renderSeconds * 1000000.0 / (double)numBlocks, 2) + "us per block, " +
+				   String(audioSeconds / jmax(renderSeconds, 0.000001), 1) + " instances per core");
+	}
+
+	AudioSampleBuffer processNetwork()
+	{
+		AudioSampleBuffer b;
+		b.makeCopyOf(input);
+
+		ProcessDataDyn d(b.getArrayOfWritePointers(), BlockSize, 2);
+		network->process(d);
+
+		return b;
+	}
+
+	AudioSampleBuffer testDynamic(bool processBlockwise)
+	{
+		auto mode = String(processBlockwise ? "Dynamic (blockwise)" : "Dynamic (per frame)");
+
+		beginTest("Measuring " + mode);
+
+		network->setAllowFrameBlockProcessing(processBlockwise);
+		expectEquals(network->getNumBlockwiseFrameContainers(), (int)processBlockwise, "processing mode wasn't changed");
+
+		measure(mode, [this](AudioSampleBuffer& b)
+		{
+			ProcessDataDyn d(b.getArrayOfWritePointers(), BlockSize, 2);
+			network->process(d);
+		});
+
+		return processNetwork();
+	}
+
+#if HISE_INCLUDE_SNEX
+	void testFused(const AudioSampleBuffer& reference)
+	{
+		beginTest("Measuring fused network");
+
+		network->setAllowFrameBlockProcessing(false);
+		network->setUseFusedNode(true);
+
+		if (!waitForFusedNetwork())
+		{
+			logMessage("Skipping fused network: " + network->getFusedCompileResult().getErrorMessage());
+			network->setUseFusedNode(false);
+			return;
+		}
+
+		skipFusedCrossfade();
+		expectBuffersMatch(reference, processNetwork(), "fused");
+
+		measure("Fused", [this](AudioSampleBuffer& b)
+		{
+			ProcessDataDyn d(b.getArrayOfWritePointers(), BlockSize, 2);
+			network->process(d);
+		});
+
+		testFusedChanges(reference);
+
+		network->setUseFusedNode(false);
+	}
+
+	void testFusedChanges(const AudioSampleBuffer& reference)
+	{
+		beginTest("Testing fused network after parameter and bypass changes");
+
+		auto nodes = network->getValueTree().getChild(0).getChildWithName(PropertyIds::Nodes).getChild(0).getChildWithName(PropertyIds::Nodes);
+
+		auto mulNode = network->getNodeWithId(nodes.getChild(1)[PropertyIds::ID].toString());
+		auto tanhNode = network->getNodeWithId(nodes.getChild(2)[PropertyIds::ID].toString());
+
+		expect(mulNode != nullptr && tanhNode != nullptr, "nodes not found");
+
+		if (mulNode == nullptr || tanhNode == nullptr)
+			return;
+
+		mulNode->getParameterFromIndex(0)->setValueSync(1.7);
+		tanhNode->setValueTreeProperty(PropertyIds::Bypassed, true);
+
+		expect(!network->isFused(), "changes didn't invalidate the fused network");
+
+		// the network falls back to the node tree until the new function is compiled
+		skipFusedCrossfade();
+		auto unfused = processNetwork();
+
+		float maxDelta = 0.0f;
+
+		for (int c = 0; c < 2; c++)
+			for (int i = 0; i < BlockSize; i++)
+				maxDelta = jmax(maxDelta, std::abs(reference.getSample(c, i) - unfused.getSample(c, i)));
+
+		expect(maxDelta > 1e-3f, "changes had no effect on the node tree");
+
+		if (waitForFusedNetwork())
+		{
+			skipFusedCrossfade();
+			expectBuffersMatch(unfused, processNetwork(), "fused after changes");
+		}
+		else
+			expect(false, "recompilation failed: " + network->getFusedCompileResult().getErrorMessage());
+
+		// restore the values for the frozen reference
+		mulNode->getParameterFromIndex(0)->setValueSync(1.1);
+		tanhNode->setValueTreeProperty(PropertyIds::Bypassed, false);
+	}
+
+	void skipFusedCrossfade()
+	{
+		// the switch between the node tree and the fused function is crossfaded
+		auto numBlocks = (int)std::ceil(DspNetwork::FusedCrossfadeMilliseconds * 0.001 * SampleRate / (double)BlockSize);
+
+		for (int i = 0; i < numBlocks; i++)
+			processNetwork();
+	}
+
+	bool waitForFusedNetwork()
+	{
+		auto timeout = Time::getMillisecondCounter() + 10000;
+
+		// the audio thread picks up the compiled function in the process call
+		while (!network->isFused() && Time::getMillisecondCounter() < timeout)
+		{
+			MessageManager::getInstance()->runDispatchLoopUntil(50);
+			processNetwork();
+		}
+
+		return network->isFused();
+	}
+#endif
+
+	void testFrozen(const AudioSampleBuffer& reference)
+	{
+		beginTest("Measuring frozen network");
+
+		FrozenType frozen;
+		setFrozenValues(frozen, std::make_index_sequence<NumGroups>());
+
+		PrepareSpecs ps;
+		ps.sampleRate = SampleRate;
+		ps.blockSize = BlockSize;
+		ps.numChannels = 2;
+
+		frozen.prepare(ps);
+		frozen.reset();
+
+		auto processFrozen = [&frozen](AudioSampleBuffer& b)
+		{
+			ProcessData<2> d(b.getArrayOfWritePointers(), BlockSize);
+			frozen.process(d);
+		};
+
+		AudioSampleBuffer b;
+		b.makeCopyOf(input);
+		processFrozen(b);
+
+		expectBuffersMatch(reference, b, "frozen");
+
+		measure("Frozen", processFrozen);
+	}
+
+	ScopedPointer<BackendProcessor> bp;
+	WeakReference<DspNetwork> network;
+	AudioSampleBuffer input;
+};
+
+static FrameContainerBenchmark frameContainerBenchmark;
+
+#endif
+
 }
 
 #endif
@@ -64,10 +64,16 @@ DspNetwork::DspNetwork(hise::ProcessorWithScriptingContent* p, ValueTree data_,
 	codeManager(*this),
 #endif
 	parentHolder(dynamic_cast<Holder*>(p)),
-	projectNodeHolder(*this)
+	projectNodeHolder(*this),
+#if HISE_INCLUDE_SNEX
+	fusedNodeHolder(*this),
+#endif
+	profileAccumulator(CpuProfiler::Category::DspNetwork)
 {
 	jassert(data.getType() == PropertyIds::Network);
 
+	profileAccumulator.processor = dynamic_cast<Processor*>(p);
+
 	tempoSyncer.publicModValue = &networkModValue;
 
 	auto mc_ = p->getMainController_();
@@ -238,12 +244,20 @@ DspNetwork::DspNetwork(hise::ProcessorWithScriptingContent* p, ValueTree data_,
 	checkIfDeprecated();
 
 	runPostInitFunctions();
+
+#if HISE_INCLUDE_SNEX
+	fusedNodeHolder.setEnabled(HISE_FUSE_SCRIPTNODE_NETWORKS);
+#endif
 }
 
 DspNetwork::~DspNetwork()
 {
 	stopTimer();
 
+#if HISE_INCLUDE_SNEX
+	fusedNodeHolder.setEnabled(false);
+#endif
+
 	root = nullptr;
 	selectionUpdater = nullptr;
 	nodes.clear();
@@ -507,12 +521,20 @@ void DspNetwork::reset()
 		projectNodeHolder.n.reset();
 	else if (auto rn = getRootNode())
 		rn->reset();
+
+#if HISE_INCLUDE_SNEX
+	fusedNodeHolder.reset();
+#endif
 }
 
 void DspNetwork::handleHiseEvent(HiseEvent& e)
 {
 	if (projectNodeHolder.isActive())
 		projectNodeHolder.n.handleHiseEvent(e);
+#if HISE_INCLUDE_SNEX
+	else if (fusedNodeHolder.handleHiseEvent(e))
+		return;
+#endif
 	else
 		getRootNode()->handleHiseEvent(e);
 }
@@ -531,6 +553,8 @@ void DspNetwork::process(ProcessDataDyn& data)
     
     if(!isInitialised())
         return;
+
+	CpuProfiler::ScopedAccumulation sa(getMainController()->getCpuProfiler(), profileAccumulator);
     
 	if (projectNodeHolder.isActive())
 	{
@@ -541,7 +565,14 @@ void DspNetwork::process(ProcessDataDyn& data)
 	if (auto s = SimpleReadWriteLock::ScopedTryReadLock(getConnectionLock()))
 	{
 		if (exceptionHandler.isOk())
+		{
+#if HISE_INCLUDE_SNEX
+			if (fusedNodeHolder.process(data))
+				return;
+#endif
+
 			getRootNode()->process(data);
+		}
 	}
 }
 
@@ -605,6 +636,10 @@ void DspNetwork::prepareToPlay(double sampleRate, double blockSize)
 
 				if (projectNodeHolder.isActive())
 					projectNodeHolder.prepare(currentSpecs);
+
+#if HISE_INCLUDE_SNEX
+				fusedNodeHolder.prepare(currentSpecs);
+#endif
 			}
             
             initialised = true;
@@ -1264,6 +1299,29 @@ void DspNetwork::setUseFrozenNode(bool shouldBeEnabled)
 	reset();
 }
 
+#if HISE_INCLUDE_SNEX
+void DspNetwork::setUseFusedNode(bool shouldBeEnabled)
+{
+	fusedNodeHolder.setEnabled(shouldBeEnabled);
+}
+#endif
+
+void DspNetwork::setAllowFrameBlockProcessing(bool shouldBeAllowed)
+{
+	for (auto n : getListOfNodesWithType<FrameProcessingNode>(true))
+		dynamic_cast<FrameProcessingNode*>(n.get())->setAllowBlockProcessing(shouldBeAllowed);
+}
+
+int DspNetwork::getNumBlockwiseFrameContainers()
+{
+	int numBlockwise = 0;
+
+	for (auto n : getListOfNodesWithType<FrameProcessingNode>(false))
+		numBlockwise += (int)dynamic_cast<FrameProcessingNode*>(n.get())->isProcessingBlockwise();
+
+	return numBlockwise;
+}
+
 bool DspNetwork::hashMatches()
 {
 	return projectNodeHolder.hashMatches;
@@ -1278,6 +1336,10 @@ hise::ScriptParameterHandler* DspNetwork::getCurrentParameterHandler()
 {
 	if (projectNodeHolder.isActive())
 		return &projectNodeHolder;
+#if HISE_INCLUDE_SNEX
+	else if (fusedNodeHolder.isEnabled())
+		return &fusedNodeHolder;
+#endif
 	else
 		return &networkParameterHandler;
 }
@@ -1371,6 +1433,10 @@ ScriptParameterHandler* DspNetwork::Holder::getCurrentNetworkParameterHandler(
 		{
 			if(n->projectNodeHolder.isActive())
 				return const_cast<ScriptParameterHandler*>(static_cast<const ScriptParameterHandler*>(&n->projectNodeHolder));
+#if HISE_INCLUDE_SNEX
+			else if (n->fusedNodeHolder.isEnabled())
+				return const_cast<ScriptParameterHandler*>(static_cast<const ScriptParameterHandler*>(&n->fusedNodeHolder));
+#endif
 			else
 				return const_cast<ScriptParameterHandler*>(static_cast<const ScriptParameterHandler*>(&n->networkParameterHandler));
 					
@@ -2410,6 +2476,448 @@ void DspNetwork::ProjectNodeHolder::init(dll::StaticLibraryHostFactory* staticLi
 	}
 }
 
+#if HISE_INCLUDE_SNEX
+DspNetwork::FusedNodeHolder::FusedNodeHolder(DspNetwork& parent):
+	Thread("Fused DSP Network Compiler"),
+	network(parent),
+	lastResult(Result::ok())
+{
+	FloatVectorOperations::clear(parameterValues, OpaqueNode::NumMaxParameters);
+}
+
+DspNetwork::FusedNodeHolder::~FusedNodeHolder()
+{
+	setEnabled(false);
+}
+
+Identifier DspNetwork::FusedNodeHolder::getParameterId(int index) const
+{ return network.networkParameterHandler.getParameterId(index); }
+
+int DspNetwork::FusedNodeHolder::getParameterIndexForIdentifier(const Identifier& id) const
+{ return network.networkParameterHandler.getParameterIndexForIdentifier(id); }
+
+int DspNetwork::FusedNodeHolder::getNumParameters() const
+{ return network.networkParameterHandler.getNumParameters(); }
+
+float DspNetwork::FusedNodeHolder::getParameter(int index) const
+{ return network.networkParameterHandler.getParameter(index); }
+
+void DspNetwork::FusedNodeHolder::setParameter(int index, float newValue)
+{
+	// Keep the node tree in sync so that we can fall back to it at any time
+	network.networkParameterHandler.setParameter(index, newValue);
+
+	if (isPositiveAndBelow(index, OpaqueNode::NumMaxParameters))
+	{
+		parameterValues[index] = newValue;
+		dirtyParameters.fetch_or(1u << (uint32)index);
+	}
+}
+
+void DspNetwork::FusedNodeHolder::setEnabled(bool shouldBeEnabled)
+{
+	if (enabled == shouldBeEnabled)
+		return;
+
+	enabled = shouldBeEnabled;
+
+	auto networkData = network.getValueTree();
+
+	if (enabled)
+	{
+		networkData.addListener(this);
+		startThread(4);
+		invalidate();
+	}
+	else
+	{
+		networkData.removeListener(this);
+		stopTimer();
+
+		// the compiler can't be interrupted, so wait until it's done
+		stopThread(-1);
+
+		// The audio thread falls back to the node tree, but it might still hold the last
+		// function, so the published networks are kept alive until the next swap.
+		activeVersion = -1;
+		nextNetwork = nullptr;
+
+		ScopedLock sl(swapLock);
+		treeToCompile = {};
+		lastCompiledVersion = -1;
+	}
+}
+
+bool DspNetwork::FusedNodeHolder::isActive() const
+{
+	return enabled && activeVersion.load() == version.load();
+}
+
+Result DspNetwork::FusedNodeHolder::canBeFused() const
+{
+	using Iterator = snex::cppgen::ValueTreeIterator;
+
+	if (network.isPolyphonic())
+		return Result::fail("Polyphonic networks can't be fused");
+
+	if (network.getParentNetwork() != nullptr)
+		return Result::fail("Nested networks can't be fused");
+
+	if (network.networkParameterHandler.getNumParameters() > OpaqueNode::NumMaxParameters)
+		return Result::fail("Too many parameters");
+
+	auto rootTree = network.getValueTree().getChild(0);
+
+	if (Iterator::isPolyphonicOrHasPolyphonicTemplate(rootTree))
+		return Result::fail("Polyphonic nodes can't be fused");
+
+	// These nodes need a connection to the outside world that the compiled function doesn't have
+	for (const auto& id : { PropertyIds::IsPublicMod, PropertyIds::UncompileableNode, PropertyIds::IsFixRuntimeTarget, PropertyIds::IsDynamicRuntimeTarget })
+	{
+		if (Iterator::hasChildNodeWithProperty(rootTree, id))
+			return Result::fail("Nodes with the property " + id.toString() + " can't be fused");
+	}
+
+	return Result::ok();
+}
+
+Result DspNetwork::FusedNodeHolder::getLastResult() const
+{
+	ScopedLock sl(swapLock);
+	return lastResult;
+}
+
+void DspNetwork::FusedNodeHolder::prepare(PrepareSpecs ps)
+{
+	ScopedLock sl(swapLock);
+
+	auto channelsChanged = ps.numChannels != lastSpecs.numChannels;
+
+	lastSpecs = ps;
+
+	fadeBuffer.setSize(ps.numChannels, ps.blockSize);
+	numFadeSamples = roundToInt(ps.sampleRate * DspNetwork::FusedCrossfadeMilliseconds * 0.001);
+	numFadeSamplesLeft = 0;
+
+	for (auto cn : publishedNetworks)
+	{
+		if (cn->node->getNumChannels() <= ps.numChannels)
+			cn->node->prepare(ps);
+	}
+
+	// The graph hasn't changed, so we can recompile the last tree with the new channel amount
+	if (enabled && channelsChanged && compileVersion == version.load())
+	{
+		compileVersion = ++version;
+		notify();
+	}
+}
+
+void DspNetwork::FusedNodeHolder::reset()
+{
+	swapIfPending();
+
+	numFadeSamplesLeft = 0;
+
+	if (currentNetwork != nullptr)
+		currentNetwork->node->reset();
+}
+
+bool DspNetwork::FusedNodeHolder::process(ProcessDataDyn& data)
+{
+	swapIfPending();
+
+	auto shouldBeActive = currentNetwork != nullptr &&
+						  activeVersion.load() == version.load() &&
+						  data.getNumChannels() >= currentNetwork->node->getNumChannels();
+
+	if (shouldBeActive != wasActive)
+	{
+		wasActive = shouldBeActive;
+
+		// the path that was inactive has an outdated state
+		if (shouldBeActive)
+			currentNetwork->node->reset();
+		else
+			network.getRootNode()->reset();
+
+		startCrossfade(data);
+	}
+
+	if (!shouldBeActive && numFadeSamplesLeft == 0)
+		return false;
+
+	if (auto dirty = dirtyParameters.exchange(0))
+	{
+		for (int i = 0; i < currentNetwork->parameters.size(); i++)
+		{
+			if (dirty & (1u << (uint32)i))
+				currentNetwork->parameters.getReference(i).callback.call((double)parameterValues[i]);
+		}
+	}
+
+	NodeProfiler np(network.getRootNode(), data.getNumSamples());
+
+	if (numFadeSamplesLeft > 0)
+		processCrossfade(data);
+	else
+		currentNetwork->node->process(data);
+
+	return true;
+}
+
+void DspNetwork::FusedNodeHolder::startCrossfade(const ProcessDataDyn& data)
+{
+	// The outgoing function must be able to process the block, otherwise we switch without a fade
+	auto canFade = numFadeSamples > 0 && currentNetwork != nullptr &&
+				   data.getNumChannels() >= currentNetwork->node->getNumChannels() &&
+				   data.getNumChannels() <= fadeBuffer.getNumChannels() &&
+				   data.getNumSamples() <= fadeBuffer.getNumSamples();
+
+	numFadeSamplesLeft = canFade ? numFadeSamples : 0;
+}
+
+void DspNetwork::FusedNodeHolder::processCrossfade(ProcessDataDyn& data)
+{
+	auto numSamples = data.getNumSamples();
+	auto numChannels = data.getNumChannels();
+
+	if (numSamples > fadeBuffer.getNumSamples() || numChannels > fadeBuffer.getNumChannels())
+	{
+		numFadeSamplesLeft = 0;
+
+		if (wasActive)
+			currentNetwork->node->process(data);
+		else
+			network.getRootNode()->process(data);
+
+		return;
+	}
+
+	for (int i = 0; i < numChannels; i++)
+		FloatVectorOperations::copy(fadeBuffer.getWritePointer(i), data.getRawDataPointers()[i], numSamples);
+
+	ProcessDataDyn fadeData(fadeBuffer.getArrayOfWritePointers(), numSamples, numChannels);
+	fadeData.copyNonAudioDataFrom(data);
+
+	// the incoming path processes the block, the outgoing path keeps its state in the fade buffer
+	if (wasActive)
+	{
+		currentNetwork->node->process(data);
+		network.getRootNode()->process(fadeData);
+	}
+	else
+	{
+		network.getRootNode()->process(data);
+		currentNetwork->node->process(fadeData);
+	}
+
+	auto delta = 1.0f / (float)numFadeSamples;
+
+	for (int c = 0; c < numChannels; c++)
+	{
+		auto dst = data.getRawDataPointers()[c];
+		auto src = fadeBuffer.getReadPointer(c);
+		auto gain = 1.0f - (float)numFadeSamplesLeft * delta;
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			dst[i] = src[i] + jmin(1.0f, gain) * (dst[i] - src[i]);
+			gain += delta;
+		}
+	}
+
+	numFadeSamplesLeft = jmax(0, numFadeSamplesLeft - numSamples);
+}
+
+bool DspNetwork::FusedNodeHolder::handleHiseEvent(HiseEvent& e)
+{
+	swapIfPending();
+
+	if (!wasActive || currentNetwork == nullptr || activeVersion.load() != version.load())
+		return false;
+
+	currentNetwork->node->handleHiseEvent(e);
+	return true;
+}
+
+void DspNetwork::FusedNodeHolder::invalidate()
+{
+	++version;
+	startTimer(300);
+}
+
+void DspNetwork::FusedNodeHolder::valueTreePropertyChanged(ValueTree& v, const Identifier& id)
+{
+	// These properties only change the appearance of the network
+	for (const auto& uiId : { PropertyIds::Folded, PropertyIds::Comment, PropertyIds::NodeColour,
+							  PropertyIds::ShowParameters, PropertyIds::ShowComments, PropertyIds::ShowClones,
+							  PropertyIds::DisplayedClones, PropertyIds::Locked, PropertyIds::Debug })
+	{
+		if (id == uiId)
+			return;
+	}
+
+	// A root parameter is forwarded to the compiled function without recompiling it
+	if (id == PropertyIds::Value && v.getType() == PropertyIds::Parameter &&
+		v.getParent().getParent() == network.getValueTree().getChild(0))
+	{
+		auto index = v.getParent().indexOf(v);
+
+		if (isPositiveAndBelow(index, OpaqueNode::NumMaxParameters))
+		{
+			parameterValues[index] = (float)v[PropertyIds::Value];
+			dirtyParameters.fetch_or(1u << (uint32)index);
+		}
+
+		return;
+	}
+
+	// The listener is attached to the network tree, so this catches bypass
+	// states and property changes of every nested node
+	invalidate();
+}
+
+void DspNetwork::FusedNodeHolder::swapIfPending()
+{
+	if (auto n = nextNetwork.exchange(nullptr))
+	{
+		currentNetwork = n;
+		wasActive = false;
+		dirtyParameters.store(0xFFFFFFFF);
+
+		// the crossfade would use the new function for the outgoing path
+		numFadeSamplesLeft = 0;
+	}
+}
+
+void DspNetwork::FusedNodeHolder::timerCallback()
+{
+	stopTimer();
+
+	auto r = canBeFused();
+
+	ScopedLock sl(swapLock);
+
+	if (!r.wasOk())
+	{
+		lastResult = r;
+		return;
+	}
+
+	for (int i = 0; i < jmin(OpaqueNode::NumMaxParameters, getNumParameters()); i++)
+		parameterValues[i] = getParameter(i);
+
+	treeToCompile = network.getValueTree().getChild(0).createCopy();
+	compileVersion = version.load();
+
+	notify();
+}
+
+void DspNetwork::FusedNodeHolder::run()
+{
+	while (!threadShouldExit())
+	{
+		ValueTree v;
+		int versionToCompile;
+
+		{
+			ScopedLock sl(swapLock);
+			v = treeToCompile;
+			versionToCompile = compileVersion;
+		}
+
+		if (v.isValid() && versionToCompile != lastCompiledVersion)
+		{
+			lastCompiledVersion = versionToCompile;
+
+			auto r = compile(v, versionToCompile);
+
+			ScopedLock sl(swapLock);
+			lastResult = r;
+		}
+
+		wait(-1);
+	}
+}
+
+Result DspNetwork::FusedNodeHolder::compile(const ValueTree& v, int versionToCompile)
+{
+	snex::cppgen::ValueTreeBuilder builder(v, snex::cppgen::ValueTreeBuilder::Format::JitCompiledInstance);
+
+	auto br = builder.createCppCode();
+
+	if (!br.r.wasOk())
+		return br.r;
+
+	int numChannels;
+
+	{
+		ScopedLock sl(swapLock);
+		numChannels = lastSpecs.numChannels;
+	}
+
+	if (numChannels == 0)
+		return Result::fail("The network is not prepared");
+
+	// The graph has changed in the meantime, so don't bother
+	if (versionToCompile != version.load())
+		return Result::ok();
+
+	snex::jit::Compiler::Ptr cc = new snex::jit::Compiler(scope);
+
+	CompiledNetwork::Ptr cn = new CompiledNetwork();
+	cn->node = new snex::jit::JitCompiledNode(*cc, br.code, v[PropertyIds::ID].toString(), numChannels);
+
+	if (!cn->node->r.wasOk())
+		return cn->node->r;
+
+	cn->parameters = cn->node->getParameterList();
+
+	if (cn->parameters.size() != v.getChildWithName(PropertyIds::Parameters).getNumChildren())
+		return Result::fail("Parameter mismatch");
+
+	if (auto dh = network.getExternalDataHolder())
+		cn->node->setExternalDataHolder(dh);
+
+	publish(cn, versionToCompile);
+
+	return Result::ok();
+}
+
+void DspNetwork::FusedNodeHolder::publish(CompiledNetwork::Ptr cn, int versionToCompile)
+{
+	{
+		ScopedLock sl(swapLock);
+
+		// the channel amount has changed, there's another compilation coming
+		if (cn->node->getNumChannels() > lastSpecs.numChannels)
+			return;
+
+		cn->node->prepare(lastSpecs);
+		publishedNetworks.add(cn);
+		nextNetwork.store(cn.get());
+	}
+
+	activeVersion.store(versionToCompile);
+
+	// Give the audio thread some time to pick up the new function
+	for (int i = 0; i < 50 && nextNetwork.load() != nullptr && !threadShouldExit(); i++)
+		Thread::sleep(10);
+
+	// If the audio thread has picked up this function, it can't use any of the older
+	// ones anymore. Otherwise they are kept alive until the next publish call.
+	if (nextNetwork.load() == nullptr)
+	{
+		ReferenceCountedArray<CompiledNetwork> oldNetworks;
+
+		ScopedLock sl(swapLock);
+		oldNetworks.swapWith(publishedNetworks);
+		publishedNetworks.add(cn);
+	}
+}
+#endif
+
 int HostHelpers::getNumMaxDataObjects(const ValueTree& v, snex::ExternalData::DataType t)
 {
 	auto id = Identifier(snex::ExternalData::getDataTypeName(t, false));
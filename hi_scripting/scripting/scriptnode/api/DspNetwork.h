@@ -703,6 +703,27 @@ public:
 
 	bool isFrozen() const { return projectNodeHolder.isActive(); }
 
+#if HISE_INCLUDE_SNEX
+	/** Enables the in-process compilation of the signal graph. If the network can be fused, it will be compiled
+	    with the SNEX JIT compiler on a background thread and processed as a single function instead of the node tree. */
+	void setUseFusedNode(bool shouldBeEnabled);
+
+	/** Returns true if the next block will be processed by the JIT compiled function. */
+	bool isFused() const { return fusedNodeHolder.isActive(); }
+
+	/** Returns the result of the last compilation of the fused network. */
+	Result getFusedCompileResult() const { return fusedNodeHolder.getLastResult(); }
+
+	/** The length of the crossfade when the network switches between the node tree and the fused function. */
+	static constexpr double FusedCrossfadeMilliseconds = 50.0;
+#endif
+
+	/** Allows the frame containers to process their child nodes blockwise if they don't require per sample processing. */
+	void setAllowFrameBlockProcessing(bool shouldBeAllowed);
+
+	/** Returns the number of frame containers that process their child nodes blockwise. */
+	int getNumBlockwiseFrameContainers();
+
 	bool hashMatches();
 
 	void setExternalData(const snex::ExternalData & d, int index);
@@ -882,6 +903,135 @@ private:
 		bool loaded = false;
 		bool forwardToNode = false;
 	} projectNodeHolder;
+
+#if HISE_INCLUDE_SNEX
+	/** Compiles the signal graph of the network into a single JIT compiled function.
+
+		Every change to the network marks the compiled function as outdated, so the network falls back
+		to the node tree immediately while a background thread compiles the new graph. The audio thread
+		picks up the new function at the start of the next block, so the swap doesn't need a lock.
+
+		The node tree and the compiled function can't share their state, so the path that becomes active
+		starts from a reset state and fades in while the other path keeps processing for the length of the
+		crossfade. Tails that are longer than that (eg. reverbs or delays) are shortened by a graph edit.
+
+		Parameter changes of the root node are forwarded to the compiled function without recompiling it.
+	*/
+	struct FusedNodeHolder: public hise::ScriptParameterHandler,
+							public ValueTree::Listener,
+							private Timer,
+							private Thread
+	{
+		FusedNodeHolder(DspNetwork& parent);
+
+		~FusedNodeHolder();
+
+		Identifier getParameterId(int index) const override;
+
+		int getParameterIndexForIdentifier(const Identifier& id) const override;
+
+		int getNumParameters() const override;
+
+		void setParameter(int index, float newValue) override;
+
+		float getParameter(int index) const override;
+
+		void setEnabled(bool shouldBeEnabled);
+
+		bool isEnabled() const { return enabled; }
+
+		bool isActive() const;
+
+		/** Checks whether the network can be compiled into a single function. */
+		Result canBeFused() const;
+
+		Result getLastResult() const;
+
+		/** Call this with the write lock of the network. */
+		void prepare(PrepareSpecs ps);
+
+		/** Call this with the write lock of the network. */
+		void reset();
+
+		/** Processes the compiled function. Returns false if the node tree needs to be processed instead. */
+		bool process(ProcessDataDyn& data);
+
+		bool handleHiseEvent(HiseEvent& e);
+
+	private:
+
+		void startCrossfade(const ProcessDataDyn& data);
+
+		void processCrossfade(ProcessDataDyn& data);
+
+		struct CompiledNetwork: public ReferenceCountedObject
+		{
+			using Ptr = ReferenceCountedObjectPtr<CompiledNetwork>;
+
+			snex::jit::JitCompiledNode::Ptr node;
+			ParameterDataList parameters;
+		};
+
+		void invalidate();
+
+		void swapIfPending();
+
+		void timerCallback() override;
+
+		void run() override;
+
+		Result compile(const ValueTree& v, int versionToCompile);
+
+		void publish(CompiledNetwork::Ptr cn, int versionToCompile);
+
+		void valueTreePropertyChanged(ValueTree& v, const Identifier& id) override;
+		void valueTreeChildAdded(ValueTree&, ValueTree&) override { invalidate(); }
+		void valueTreeChildRemoved(ValueTree&, ValueTree&, int) override { invalidate(); }
+		void valueTreeChildOrderChanged(ValueTree&, int, int) override { invalidate(); }
+		void valueTreeParentChanged(ValueTree&) override {}
+
+		DspNetwork& network;
+
+		bool enabled = false;
+
+		// the network is fused if the published function was compiled from the current version of the graph
+		std::atomic<int> version = { 0 };
+		std::atomic<int> activeVersion = { -1 };
+
+		int lastCompiledVersion = -1;
+
+		// guarded by the swap lock
+		ValueTree treeToCompile;
+		int compileVersion = 0;
+		PrepareSpecs lastSpecs;
+		Result lastResult;
+
+		// every function that the audio thread might still use
+		ReferenceCountedArray<CompiledNetwork> publishedNetworks;
+
+		mutable CriticalSection swapLock;
+
+		float parameterValues[OpaqueNode::NumMaxParameters];
+		std::atomic<uint32> dirtyParameters = { 0 };
+
+		std::atomic<CompiledNetwork*> nextNetwork = { nullptr };
+
+		// only accessed by the audio thread through swapIfPending()
+		CompiledNetwork* currentNetwork = nullptr;
+		bool wasActive = false;
+
+		// the outgoing path is processed into this buffer during the crossfade
+		AudioSampleBuffer fadeBuffer;
+		int numFadeSamples = 0;
+		int numFadeSamplesLeft = 0;
+
+		snex::jit::GlobalScope scope;
+
+		JUCE_DECLARE_NON_COPYABLE(FusedNodeHolder);
+	} fusedNodeHolder;
+#endif
+
+	CpuProfiler::Accumulator profileAccumulator;
     
 	JUCE_DECLARE_WEAK_REFERENCEABLE(DspNetwork);
 };
@@ -45,6 +45,7 @@ scriptnode::routing::GlobalRoutingManager::Ptr GlobalRoutingManager::Helpers::ge
 	{
 		newP = new GlobalRoutingManager();
 		newP->additionalEventStorage.getBroadcaster().enableLockFreeUpdate(mc->getGlobalUIUpdater());
+		newP->cableDispatcher = new CableDispatcher(*newP, mc->getGlobalUIUpdater());
 		mc->setGlobalRoutingManager(newP.get());
 		mc->getProcessorChangeHandler().sendProcessorChangeMessage(mc->getMainSynthChain(), MainController::ProcessorChangeHandler::EventType::RebuildModuleList, false);
 	}
@@ -272,6 +273,16 @@ struct GlobalRoutingManager::DebugComponent : public Component,
 			valueArea = valueArea.removeFromLeft(jmax<float>(valueArea.getHeight(), valueArea.getWidth() * c->lastValue));
 
 			g.fillRoundedRectangle(valueArea, valueArea.getHeight() / 2.0f);
+
+			String s;
+			s << String(c->getNumUpdates()) << " updates";
+
+			if (auto numCoalesced = c->getNumCoalescedUpdates())
+				s << ", " << String(numCoalesced) << " coalesced";
+
+			g.setFont(GLOBAL_FONT());
+			g.setColour(Colours::white.withAlpha(0.5f));
+			g.drawText(s, b.removeFromRight(150.0f).reduced(5.0f, 0.0f), Justification::right);
 		}
 
 		Cable* getCable() { return static_cast<Cable*>(slot.get()); }
@@ -534,6 +545,12 @@ struct HiseOSCSender: public OSCSender,
 			return "OSC Output";
 		}
 
+		ThreadAffinity getThreadAffinity() const override
+		{
+			// don't send network messages from the audio thread
+			return ThreadAffinity::UIThread;
+		}
+
 		Path getTargetIcon() const override
 		{
 			return {};
@@ -1681,9 +1698,24 @@ bool GlobalRoutingManager::Cable::cleanup()
 			targets.remove(i--);
 	}
 
+	updateNumDeferredTargets();
+
 	return targets.isEmpty();
 }
 
+void GlobalRoutingManager::Cable::updateNumDeferredTargets()
+{
+	int numDeferred = 0;
+
+	for (auto t : targets)
+	{
+		if (t != nullptr && t->getThreadAffinity() != CableTargetBase::ThreadAffinity::Sender)
+			numDeferred++;
+	}
+
+	numDeferredTargets.store(numDeferred);
+}
+
 
 
 scriptnode::routing::GlobalRoutingManager::SelectableTargetBase::List GlobalRoutingManager::Cable::getTargetList() const
@@ -1705,6 +1737,7 @@ void GlobalRoutingManager::Cable::addTarget(CableTargetBase* n)
 {
 	SimpleReadWriteLock::ScopedWriteLock sl(lock);
 	targets.addIfNotAlreadyThere(n);
+	updateNumDeferredTargets();
 	n->sendValue(lastValue);
 }
 
@@ -1712,21 +1745,71 @@ void GlobalRoutingManager::Cable::removeTarget(CableTargetBase* n)
 {
 	SimpleReadWriteLock::ScopedWriteLock sl(lock);
 	targets.removeAllInstancesOf(n);
+	updateNumDeferredTargets();
 }
 
 void GlobalRoutingManager::Cable::sendValue(CableTargetBase* source, double v)
 {
 	lastValue = jlimit(0.0, 1.0, v);
 
+	numUpdates.fetch_add(1, std::memory_order_relaxed);
+
+	// Write the value into the lock-free slot for the targets that don't want to be called from here
+	latestSource.store(source);
+	latestValue.store(lastValue);
+	latestVersion.fetch_add(1);
+
+	const auto hasDeferredTargets = numDeferredTargets.load() > 0;
+
 	for (auto t : targets)
 	{
 		if (t == source)
 			continue;
 
+		if (hasDeferredTargets && t->getThreadAffinity() != CableTargetBase::ThreadAffinity::Sender)
+			continue;
+
 		t->sendValue(lastValue);
 	}
 }
 
+void GlobalRoutingManager::Cable::dispatchLatestValue()
+{
+	if (numDeferredTargets.load() == 0)
+		return;
+
+	auto previousVersion = lastDispatchedVersion;
+
+	double v;
+
+	if (!readLatestValue(lastDispatchedVersion, v))
+		return;
+
+	auto numSkipped = (int)(lastDispatchedVersion - previousVersion) - 1;
+
+	if (numSkipped > 0)
+		numCoalescedUpdates.fetch_add(numSkipped, std::memory_order_relaxed);
+
+	auto source = latestSource.load();
+
+	SimpleReadWriteLock::ScopedReadLock sl(lock);
+
+	for (auto t : targets)
+	{
+		if (t == nullptr || t == source)
+			continue;
+
+		if (t->getThreadAffinity() == CableTargetBase::ThreadAffinity::UIThread)
+			t->sendValue(v);
+	}
+}
+
+void GlobalRoutingManager::CableDispatcher::timerCallback()
+{
+	for (auto c : manager.cables)
+		static_cast<Cable*>(c)->dispatchLatestValue();
+}
+
 GlobalRoutingManager::Signal::Signal(const String& id_) :
 	SlotBase(id_, SlotType::Signal),
 	sourceSpecs(),
@@ -108,10 +108,21 @@ struct GlobalRoutingManager: public ReferenceCountedObject
 	{
 		using List = Array<WeakReference<CableTargetBase>>;
 
+		/** Defines on which thread a cable target wants to receive its values. */
+		enum class ThreadAffinity
+		{
+			Sender,		///< sendValue() is called synchronously on the thread that sends the value (default).
+			UIThread,	///< sendValue() is called with the latest value by the global UI timer (multiple values in between are coalesced).
+			Polling		///< sendValue() is never called, the target reads the latest value with Cable::readLatestValue() at its own rate.
+		};
+
 		virtual ~CableTargetBase() {};
 
 		virtual void sendValue(double v) = 0;
 
+		/** Override this method if the target should not be called by the sender. This must not change after the target was added to a cable. */
+		virtual ThreadAffinity getThreadAffinity() const { return ThreadAffinity::Sender; }
+
 		virtual Path getTargetIcon() const = 0;
 
 		JUCE_DECLARE_WEAK_REFERENCEABLE(CableTargetBase);
@@ -242,6 +253,28 @@ struct GlobalRoutingManager: public ReferenceCountedObject
 		void sendValue(CableTargetBase* source, double v);
 		double getLastValue() const { return lastValue; }
 
+		/** Reads the latest value if it has changed since the given version. This is lock-free and can be called from any thread. */
+		bool readLatestValue(uint32& lastVersion, double& v) const noexcept
+		{
+			auto currentVersion = latestVersion.load();
+
+			if (currentVersion == lastVersion)
+				return false;
+
+			v = latestValue.load();
+			lastVersion = currentVersion;
+			return true;
+		}
+
+		/** Sends the latest value to all targets with the UIThread affinity. This is called by the global UI timer. */
+		void dispatchLatestValue();
+
+		/** Returns the number of values that were sent through this cable. */
+		int getNumUpdates() const noexcept { return numUpdates.load(); }
+
+		/** Returns the number of values that were skipped for the UIThread targets because a newer value arrived before the timer callback. */
+		int getNumCoalescedUpdates() const noexcept { return numCoalescedUpdates.load(); }
+
 		double lastValue = 0.0;
 		CableTargetBase::List targets;
         
@@ -290,6 +323,19 @@ struct GlobalRoutingManager: public ReferenceCountedObject
         
         ScopedPointer<RuntimeTarget> runtimeTarget;
 
+	private:
+
+		void updateNumDeferredTargets();
+
+		std::atomic<double> latestValue = { 0.0 };
+		std::atomic<uint32> latestVersion = { 0 };
+		std::atomic<CableTargetBase*> latestSource = { nullptr };
+
+		uint32 lastDispatchedVersion = 0;
+		std::atomic<int> numDeferredTargets = { 0 };
+
+		std::atomic<int> numUpdates = { 0 };
+		std::atomic<int> numCoalescedUpdates = { 0 };
 	};
 
 	struct Signal: public SlotBase
@@ -328,6 +374,21 @@ struct GlobalRoutingManager: public ReferenceCountedObject
 
 	struct DebugComponent;
 
+	/** Delivers the latest cable values to the targets with the UIThread affinity. */
+	struct CableDispatcher : public PooledUIUpdater::SimpleTimer
+	{
+		CableDispatcher(GlobalRoutingManager& m, PooledUIUpdater* updater) :
+			SimpleTimer(updater),
+			manager(m)
+		{};
+
+		void timerCallback() override;
+
+		GlobalRoutingManager& manager;
+	};
+
+	ScopedPointer<CableDispatcher> cableDispatcher;
+
 	/** Connects the global routing manager to an OSC port. */
 	bool connectToOSC(OSCConnectionData::Ptr data);
 
@@ -671,8 +671,79 @@ ParameterDataList BranchNode::createInternalParameterList()
 	return data;
 }
 
-SingleSampleBlockX::SingleSampleBlockX(DspNetwork* n, ValueTree d) :
+FrameProcessingNode::FrameProcessingNode(DspNetwork* n, ValueTree d) :
 	SerialNode(n, d)
+{
+	structureListener.setTypesToWatch({ PropertyIds::Nodes, PropertyIds::ModulationTargets, PropertyIds::SwitchTargets });
+	structureListener.setCallback(d, valuetree::AsyncMode::Asynchronously, [this](ValueTree, bool)
+	{
+		updateBlockProcessing();
+	});
+}
+
+void FrameProcessingNode::setAllowBlockProcessing(bool shouldBeAllowed)
+{
+	allowBlockProcessing = shouldBeAllowed;
+	updateBlockProcessing();
+}
+
+bool FrameProcessingNode::requiresFrameProcessing(const ValueTree& containerTree)
+{
+	return valuetree::Helpers::forEach(containerTree.getChildWithName(PropertyIds::Nodes), [](ValueTree& v)
+	{
+		if (v.getType() == PropertyIds::Node)
+		{
+			// cables, send / receive feedback loops and control nodes
+			for (const auto& id : { PropertyIds::IsRoutingNode, PropertyIds::IsControlNode, PropertyIds::IsCloneCableNode })
+			{
+				if (cppgen::CustomNodeProperties::nodeHasProperty(v, id))
+					return true;
+			}
+		}
+
+		// a modulation source that changes a parameter within the block
+		if (v.getType() == PropertyIds::ModulationTargets || v.getType() == PropertyIds::SwitchTargets)
+			return v.getNumChildren() > 0;
+
+		return false;
+	});
+}
+
+int FrameProcessingNode::getBlockSizeForChildNodes() const
+{
+	return (isBypassed() || processBlockwise) ? originalBlockSize : 1;
+}
+
+void FrameProcessingNode::updateBlockProcessing()
+{
+	auto shouldProcessBlockwise = allowBlockProcessing && !requiresFrameProcessing(getValueTree());
+
+	if (shouldProcessBlockwise == processBlockwise)
+		return;
+
+	{
+		SimpleReadWriteLock::ScopedWriteLock sl(getRootNetwork()->getConnectionLock(), getRootNetwork()->isInitialised());
+
+		processBlockwise = shouldProcessBlockwise;
+
+		// the child nodes need to be prepared with the new block size
+		if (originalBlockSize != 0 && originalSampleRate != 0.0)
+		{
+			PrepareSpecs ps;
+			ps.blockSize = originalBlockSize;
+			ps.sampleRate = originalSampleRate;
+			ps.numChannels = getCurrentChannelAmount();
+			ps.voiceIndex = lastVoiceIndex;
+
+			prepare(ps);
+		}
+	}
+
+	getRootNetwork()->runPostInitFunctions();
+}
+
+SingleSampleBlockX::SingleSampleBlockX(DspNetwork* n, ValueTree d) :
+	FrameProcessingNode(n, d)
 {
 	initListeners();
 	obj.getObject().initialise(this);
@@ -680,7 +751,7 @@ SingleSampleBlockX::SingleSampleBlockX(DspNetwork* n, ValueTree d) :
 
 void SingleSampleBlockX::setBypassed(bool shouldBeBypassed)
 {
-	SerialNode::setBypassed(shouldBeBypassed);
+	FrameProcessingNode::setBypassed(shouldBeBypassed);
 
 	if (originalBlockSize == 0 || originalSampleRate == 0.0)
 		return;
@@ -709,11 +780,12 @@ void SingleSampleBlockX::reset()
 
 void SingleSampleBlockX::process(ProcessDataDyn& data)
 {
-	NodeProfiler np(this, isBypassed() ? data.getNumSamples() : 1);
-	ProcessDataPeakChecker pd(this, data);
+	auto processBlock = isBypassed() || isProcessingBlockwise();
 
+	NodeProfiler np(this, processBlock ? data.getNumSamples() : 1);
+	ProcessDataPeakChecker pd(this, data);
 
-	if (isBypassed())
+	if (processBlock)
 		obj.getObject().process(data);
 	else
 		obj.process(data);
@@ -725,11 +797,6 @@ void SingleSampleBlockX::processFrame(NodeBase::FrameType& data)
 	obj.processFrame(data);
 }
 
-int SingleSampleBlockX::getBlockSizeForChildNodes() const
-{
-	return isBypassed() ? originalBlockSize : 1;
-}
-
 void SingleSampleBlockX::handleHiseEvent(HiseEvent& e)
 {
 	obj.handleHiseEvent(e);
@@ -888,7 +888,42 @@ public:
 	int currentIndex = 0;
 };
 
-class SingleSampleBlockX : public SerialNode
+/** The base class for the frame containers.
+
+	If no child node sends a signal or modulation value to another node within the same sample, the result
+	of the per sample processing is the same as processing each child node with the entire block, so the
+	container skips the virtual processFrame() call for every node and sample and processes the block instead.
+
+	This is disabled by default (see HISE_FRAME_CONTAINER_BLOCK_PROCESSING).
+*/
+class FrameProcessingNode : public SerialNode
+{
+public:
+
+	FrameProcessingNode(DspNetwork* n, ValueTree d);
+
+	/** Allows the container to process its child nodes blockwise if it doesn't change the result. */
+	void setAllowBlockProcessing(bool shouldBeAllowed);
+
+	/** Returns true if the child nodes are processed with the entire block. */
+	bool isProcessingBlockwise() const noexcept { return processBlockwise; }
+
+	/** Checks whether a child node sends a signal or modulation value to another node within the same sample. */
+	static bool requiresFrameProcessing(const ValueTree& containerTree);
+
+	int getBlockSizeForChildNodes() const override;
+
+private:
+
+	void updateBlockProcessing();
+
+	bool allowBlockProcessing = HISE_FRAME_CONTAINER_BLOCK_PROCESSING;
+	bool processBlockwise = false;
+
+	valuetree::RecursiveTypedChildListener structureListener;
+};
+
+class SingleSampleBlockX : public FrameProcessingNode
 {
 public:
 
@@ -904,7 +939,6 @@ public:
 	void reset() final override;
 	void process(ProcessDataDyn& data) final override;
 	void processFrame(FrameType& data) final override;
-	int getBlockSizeForChildNodes() const override;;
 	void handleHiseEvent(HiseEvent& e) override;
 
 	wrap::frame_x<SerialNode::DynamicSerialProcessor> obj;
@@ -932,7 +966,7 @@ public:
     wrap::sidechain<SerialNode::DynamicSerialProcessor> obj;
 };
 
-template <int NumChannels> class SingleSampleBlock : public SerialNode
+template <int NumChannels> class SingleSampleBlock : public FrameProcessingNode
 {
 public:
 
@@ -942,7 +976,7 @@ public:
 	String getNodeDescription() const override { return "Per sample processing for " + String(NumChannels) + " audio channels"; }
 
 	SingleSampleBlock(DspNetwork* n, ValueTree d) :
-		SerialNode(n, d)
+		FrameProcessingNode(n, d)
 	{
 		initListeners();
 		obj.getObject().initialise(this);
@@ -981,7 +1015,7 @@ public:
 			
 		else
 		{
-			NodeProfiler np(this, 1);
+			NodeProfiler np(this, isProcessingBlockwise() ? data.getNumSamples() : 1);
 			ProcessDataPeakChecker pd(this, data);
 			float* channels[NumChannels];
 			int numChannels = jmin(NumChannels, data.getNumChannels());
@@ -1002,7 +1036,11 @@ public:
 			auto& cd = FixProcessType::ChannelDataType::as(channels);
 			FixProcessType copy(cd.begin(), data.getNumSamples());
 			copy.copyNonAudioDataFrom(data);
-			obj.process(copy);
+
+			if (isProcessingBlockwise())
+				obj.getObject().process(copy);
+			else
+				obj.process(copy);
 		}
 	}
 
@@ -1017,7 +1055,7 @@ public:
 
 	void setBypassed(bool shouldBeBypassed) override
 	{
-		SerialNode::setBypassed(shouldBeBypassed);
+		FrameProcessingNode::setBypassed(shouldBeBypassed);
 
 		if (originalBlockSize == 0)
 			return;
@@ -1032,11 +1070,6 @@ public:
 		getRootNetwork()->runPostInitFunctions();
 	}
 
-	int getBlockSizeForChildNodes() const override
-	{
-		return isBypassed() ? originalBlockSize : 1;
-	};
-
 	void handleHiseEvent(HiseEvent& e) override
 	{
 		obj.handleHiseEvent(e);
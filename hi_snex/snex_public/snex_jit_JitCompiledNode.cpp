@@ -166,16 +166,18 @@ JitCompiledNode::JitCompiledNode(Compiler& c, const String& code, const String&
 
 					auto pIndex = n.index;
 
-					if (pIndex == 0)
-						d.callback.referTo(this, setParameterStatic<0>);
-					else if (pIndex == 1)
-						d.callback.referTo(this, setParameterStatic<1>);
-					else if (pIndex == 2)
-						d.callback.referTo(this, setParameterStatic<2>);
-					else if (pIndex == 3)
-						d.callback.referTo(this, setParameterStatic<3>);
-					else if (pIndex == 4)
-						d.callback.referTo(this, setParameterStatic<4>);
+					using ParameterFunction = void(*)(void*, double);
+
+					static const ParameterFunction parameterCallbacks[] =
+					{
+						setParameterStatic<0>, setParameterStatic<1>, setParameterStatic<2>, setParameterStatic<3>,
+						setParameterStatic<4>, setParameterStatic<5>, setParameterStatic<6>, setParameterStatic<7>,
+						setParameterStatic<8>, setParameterStatic<9>, setParameterStatic<10>, setParameterStatic<11>,
+						setParameterStatic<12>, setParameterStatic<13>, setParameterStatic<14>, setParameterStatic<15>
+					};
+
+					if (isPositiveAndBelow(pIndex, numElementsInArray(parameterCallbacks)))
+						d.callback.referTo(this, parameterCallbacks[pIndex]);
 					else
 						jassertfalse;
 					
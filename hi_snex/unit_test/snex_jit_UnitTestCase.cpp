@@ -258,6 +258,7 @@ juce::var JitFileTestCase::getJSONData(const HiseEvent& e)
 	case hise::HiseEvent::Type::PitchFade:
 	case hise::HiseEvent::Type::TimerEvent:
 	case hise::HiseEvent::Type::ProgramChange:
+	case hise::HiseEvent::Type::ParameterChange:
 	case hise::HiseEvent::Type::numTypes:
 		break;
 	default:
@@ -7,8 +7,10 @@
 #include "hi_streaming/StreamingSampler.cpp"
 #include "hi_streaming/StreamingSamplerSound.cpp"
 #include "hi_streaming/StreamingSamplerVoice.cpp"
+#include "hi_streaming/VoiceBenchmark.cpp"
 
 #include "timestretch//time_stretcher.cpp"
+#include "timestretch/time_stretcher_tests.cpp"
 
 
 
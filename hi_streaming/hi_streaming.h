@@ -113,6 +113,7 @@ Set this to false to disable the release start feature.
 #include "hi_streaming/StreamingSampler.h"
 #include "hi_streaming/StreamingSamplerSound.h"
 #include "hi_streaming/StreamingSamplerVoice.h"
+#include "hi_streaming/VoiceBenchmark.h"
 
 
 #endif   // HI_STREAMING_INCLUDED
@@ -91,6 +91,18 @@ void SampleThreadPool::clearPendingTasks()
 	}
 }
 
+void SampleThreadPool::removeJob(Job* jobToRemove)
+{
+	// The jobs are executed with this lock, so this waits for the running job
+	ScopedLock sl(pimpl->clearLock);
+
+	jobToRemove->signalJobShouldExit();
+
+	// Any queued reference to this job will be skipped from now on
+	jobToRemove->masterReference.clear();
+	jobToRemove->queued.store(false);
+}
+
 void SampleThreadPool::addJob(Job* jobToAdd, bool unused)
 {
 	ignoreUnused(unused);
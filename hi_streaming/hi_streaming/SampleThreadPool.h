@@ -99,6 +99,13 @@ public:
 
 	void addJob(Job* jobToAdd, bool unused);
 
+	/** Waits until the job isn't running anymore and makes sure that it won't be run again.
+	
+		Call this in the destructor of a job that might be queued, because the base class
+		destructor is too late to stop the thread from calling runJob().
+	*/
+	void removeJob(Job* jobToRemove);
+
 	void run() override;
 
 	struct Pimpl;
@@ -1267,6 +1267,36 @@ NotificationType StreamingSamplerVoice::initStretcher(float pitchSt)
 	stretcher.setResampleBuffer(1.0, nullptr, 0);
 	stretcher.setTransposeSemitones(pitchSt, timestretchTonality);
 
+	if(warmupCache != nullptr && skipLatency != dontSendNotification && !loader.isNonRealtime())
+	{
+		TimestretchWarmupCache::Key k;
+		k.sound = sound;
+		k.sampleStart = (int)voiceUptime;
+		k.ratio = stretchRatio;
+		k.transposeSemitones = pitchSt;
+		k.tonality = timestretchTonality;
+
+		auto numConsumed = warmupCache->swapIfWarmedUp(k, stretcher);
+
+		if(numConsumed >= 0.0)
+		{
+			loader.waitForTimestretchSeek(nullptr);
+			stretcher.setTransposeSemitones(pitchSt, timestretchTonality);
+
+			voiceUptime += numConsumed;
+
+			if (!loader.advanceReadIndex(voiceUptime))
+			{
+				jassertfalse;
+				resetVoice();
+			}
+
+			return dontSendNotification;
+		}
+
+		warmupCache->requestWarmup(k);
+	}
+
 	if(skipLatency == NotificationType::sendNotificationSync || loader.isNonRealtime())
 	{
 		loader.waitForTimestretchSeek(nullptr);
@@ -1318,4 +1348,232 @@ SampleThreadPool::Job::JobStatus SampleLoader::Unmapper::runJob()
 	return SampleThreadPoolJob::jobHasFinished;
 }
 
+bool TimestretchWarmupCache::Key::operator==(const Key& other) const
+{
+	return sound == other.sound &&
+		   sampleStart == other.sampleStart &&
+		   std::abs(ratio - other.ratio) < 0.0001 &&
+		   std::abs(transposeSemitones - other.transposeSemitones) < 0.01 &&
+		   std::abs(tonality - other.tonality) < 0.001;
+}
+
+String TimestretchWarmupCache::Statistics::toString() const
+{
+	auto numTotal = numHits + numMisses;
+	auto hitRate = numTotal > 0 ? (double)numHits / (double)numTotal : 0.0;
+
+	String s;
+	s << "Timestretch warmup: " << String(numHits) << " hits, " << String(numMisses) << " misses";
+	s << " (" << String(hitRate * 100.0, 1) << "%), " << String(numWarmups) << " warmups";
+	return s;
+}
+
+TimestretchWarmupCache::TimestretchWarmupCache(SampleThreadPool* pool_, int numSlots) :
+	SampleThreadPoolJob("Timestretch warmup"),
+	pool(pool_)
+{
+	for (int i = 0; i < numSlots; i++)
+		slots.add(new Slot());
+}
+
+TimestretchWarmupCache::~TimestretchWarmupCache()
+{
+	// wait for a running warmup before deleting the slots
+	pool->removeJob(this);
+
+	ScopedLock sl(warmupLock);
+	slots.clear();
+}
+
+void TimestretchWarmupCache::setEnabled(bool shouldBeEnabled, const Identifier& engineId)
+{
+	ScopedLock sl(warmupLock);
+
+	enabled = shouldBeEnabled;
+
+	for (auto s : slots)
+	{
+		s->state.store(SlotState::Empty);
+		s->key = {};
+		s->stretcher.setEnabled(shouldBeEnabled, engineId);
+	}
+}
+
+void TimestretchWarmupCache::clear()
+{
+	ScopedLock sl(warmupLock);
+
+	for (auto s : slots)
+	{
+		s->state.store(SlotState::Empty);
+		s->key = {};
+	}
+}
+
+double TimestretchWarmupCache::swapIfWarmedUp(const Key& k, time_stretcher& stretcher)
+{
+	if (!enabled || !k.isValid())
+		return -1.0;
+
+	for (auto s : slots)
+	{
+		auto expected = SlotState::Ready;
+
+		// Claim the slot before reading the key, the background thread might be writing it
+		if (!s->state.compare_exchange_strong(expected, SlotState::Busy))
+			continue;
+
+		if (!(s->key == k))
+		{
+			s->state.store(SlotState::Ready);
+			continue;
+		}
+
+		if (s->stretcher.getCurrentEngine() != stretcher.getCurrentEngine())
+		{
+			s->state.store(SlotState::Empty);
+			continue;
+		}
+
+		stretcher.swapEngineWith(s->stretcher);
+
+		auto numConsumed = s->numConsumed;
+		numHits++;
+
+		// The slot now holds the engine of the voice, so we warm it up again
+		// for the next note with the same key
+		s->state.store(SlotState::Requested);
+
+		if (!isQueued())
+			pool->addJob(this, false);
+
+		return numConsumed;
+	}
+
+	numMisses++;
+	return -1.0;
+}
+
+void TimestretchWarmupCache::requestWarmup(const Key& k)
+{
+	if (!enabled || !k.isValid() || slots.isEmpty())
+		return;
+
+	for (auto s : slots)
+	{
+		auto state = s->state.load();
+
+		if ((state == SlotState::Requested || state == SlotState::Warming || state == SlotState::Ready) && s->key == k)
+			return;
+	}
+
+	Slot* target = nullptr;
+
+	for (auto s : slots)
+	{
+		auto expected = SlotState::Empty;
+
+		if (s->state.compare_exchange_strong(expected, SlotState::Writing))
+		{
+			target = s;
+			break;
+		}
+	}
+
+	// Replace the warmed up engines in a round robin fashion
+	for (int i = 0; i < slots.size() && target == nullptr; i++)
+	{
+		auto s = slots[(int)(nextSlot++ % (uint32)slots.size())];
+		auto expected = SlotState::Ready;
+
+		if (s->state.compare_exchange_strong(expected, SlotState::Writing))
+			target = s;
+	}
+
+	if (target == nullptr)
+		return;
+
+	target->key = k;
+	target->state.store(SlotState::Requested);
+
+	if (!isQueued())
+		pool->addJob(this, false);
+}
+
+TimestretchWarmupCache::Statistics TimestretchWarmupCache::getStatistics() const
+{
+	Statistics s;
+	s.numHits = numHits.load();
+	s.numMisses = numMisses.load();
+	s.numWarmups = numWarmups.load();
+	return s;
+}
+
+SampleThreadPoolJob::JobStatus TimestretchWarmupCache::runJob()
+{
+	for (int i = 0; i < slots.size(); i++)
+	{
+		if (shouldExit())
+			break;
+
+		ScopedLock sl(warmupLock);
+
+		auto s = slots[i];
+		auto expected = SlotState::Requested;
+
+		if (s != nullptr && s->state.compare_exchange_strong(expected, SlotState::Warming))
+		{
+			auto ok = warmSlot(*s);
+			s->state.store(ok ? SlotState::Ready : SlotState::Empty);
+		}
+	}
+
+	return SampleThreadPoolJob::jobHasFinished;
+}
+
+bool TimestretchWarmupCache::warmSlot(Slot& s)
+{
+	if (!s.stretcher.isEnabled() || !s.key.isValid())
+		return false;
+
+	auto sound = const_cast<StreamingSamplerSound*>(s.key.sound);
+
+	ScopedLock sl(sound->getSampleLock());
+
+	const auto& preloadBuffer = sound->getPreloadBuffer();
+
+	s.stretcher.configure(sound->isStereo() ? 2 : 1, sound->getSampleRate());
+	s.stretcher.setTransposeSemitones(s.key.transposeSemitones, s.key.tonality);
+
+	auto numRequired = roundToInt(s.stretcher.getLatency(s.key.ratio));
+
+	// We can only warm up the engine if the preload buffer contains all latency samples
+	if (numRequired <= 0 || s.key.sampleStart < 0 || s.key.sampleStart + numRequired > preloadBuffer.getNumSamples())
+		return false;
+
+	warmupBuffer.setSize(2, numRequired, false, false, true);
+
+	float* data[2] = { warmupBuffer.getWritePointer(0), warmupBuffer.getWritePointer(1) };
+
+	const auto numSourceChannels = jmin(2, preloadBuffer.getNumChannels());
+
+	if (preloadBuffer.isFloatingPoint())
+	{
+		for (int c = 0; c < numSourceChannels; c++)
+			FloatVectorOperations::copy(data[c], static_cast<const float*>(preloadBuffer.getReadPointer(c, s.key.sampleStart)), numRequired);
+	}
+	else
+	{
+		preloadBuffer.convertToFloatWithNormalisation(data, numSourceChannels, s.key.sampleStart, numRequired);
+	}
+
+	if (numSourceChannels == 1)
+		FloatVectorOperations::copy(data[1], data[0], numRequired);
+
+	s.numConsumed = s.stretcher.skipLatency(data, s.key.ratio);
+	numWarmups++;
+
+	return true;
+}
+
 } // namespace hise
@@ -247,6 +247,106 @@ private:
 	bool cancelled = false;
 };
 
+/** A pool of time stretch engines that are warmed up in the background with the preload buffer of recently played samples.
+*
+*	The stretch engine needs a few thousand input samples before it produces any output. Without this class a voice
+*	either has to wait for the asynchronous latency skip or it must process all these samples in the audio thread.
+*	This class keeps a few engines around that have already digested the start of a sample with a given ratio and
+*	pitch, so that the next voice playing the same sample can just swap its engine and start immediately.
+*
+*	Every swap requests a new warm up with the same key, so repeated notes will keep hitting the cache.
+*/
+class TimestretchWarmupCache : public SampleThreadPoolJob
+{
+public:
+
+	/** The properties that must match so that a warmed up engine can be used by a voice. */
+	struct Key
+	{
+		bool operator==(const Key& other) const;
+
+		bool isValid() const noexcept { return sound != nullptr; }
+
+		const StreamingSamplerSound* sound = nullptr;
+		int sampleStart = 0;
+		double ratio = 1.0;
+		double transposeSemitones = 0.0;
+		double tonality = 0.0;
+	};
+
+	struct Statistics
+	{
+		String toString() const;
+
+		int numHits = 0;
+		int numMisses = 0;
+		int numWarmups = 0;
+	};
+
+	TimestretchWarmupCache(SampleThreadPool* pool_, int numSlots=8);
+	~TimestretchWarmupCache();
+
+	/** Enables the engines of all slots. Call this whenever the timestretch options change (with all voices killed). */
+	void setEnabled(bool shouldBeEnabled, const Identifier& engineId);
+
+	/** Removes all warmed up engines. Call this with the sample lock held before deleting sounds. */
+	void clear();
+
+	/** Swaps the engine of the stretcher with a warmed up one for the given key.
+	*
+	*	Returns the number of input samples that the engine has consumed or -1.0 if there was no matching engine.
+	*	This is realtime safe and will request a new warm up for the key.
+	*/
+	double swapIfWarmedUp(const Key& k, time_stretcher& stretcher);
+
+	/** Requests a warm up for the given key. This is realtime safe. */
+	void requestWarmup(const Key& k);
+
+	Statistics getStatistics() const;
+
+	JobStatus runJob() override;
+
+private:
+
+	enum class SlotState
+	{
+		Empty,
+		Writing,
+		Requested,
+		Warming,
+		Ready,
+		Busy
+	};
+
+	struct Slot
+	{
+		Slot() : stretcher(false) {};
+
+		std::atomic<SlotState> state = { SlotState::Empty };
+		Key key;
+		double numConsumed = 0.0;
+		time_stretcher stretcher;
+	};
+
+	bool warmSlot(Slot& s);
+
+	SampleThreadPool* pool;
+
+	CriticalSection warmupLock;
+	std::atomic<bool> enabled = { false };
+
+	OwnedArray<Slot> slots;
+	std::atomic<uint32> nextSlot = { 0 };
+
+	std::atomic<int> numHits = { 0 };
+	std::atomic<int> numMisses = { 0 };
+	std::atomic<int> numWarmups = { 0 };
+
+	AudioSampleBuffer warmupBuffer;
+
+	JUCE_DECLARE_NON_COPYABLE(TimestretchWarmupCache);
+};
+
 
 /** A SamplerVoice that streams the data from a StreamingSamplerSound
 *
@@ -362,6 +462,12 @@ public:
 		timestretchTonality = jlimit(0.0, 1.0, tonality);
 	}
 
+	/** Sets a cache with warmed up engines that will be used when the voice starts. */
+	void setTimestretchWarmupCache(TimestretchWarmupCache* newCache)
+	{
+		warmupCache = newCache;
+	}
+
 #if HISE_SAMPLER_ALLOW_RELEASE_START
 
 	void jumpToRelease()
@@ -411,6 +517,8 @@ private:
 	time_stretcher stretcher;
 	double stretchRatio = 1.0;
 
+	TimestretchWarmupCache* warmupCache = nullptr;
+
 	const float *pitchData;
 
 	// This lets the wrapper class access the internal data without annoying get/setters
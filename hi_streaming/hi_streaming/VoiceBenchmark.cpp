@@ -0,0 +1,74 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+#if HI_RUN_UNIT_TESTS
+
+double VoiceBenchmark::measureVoicesPerCore(int numVoices, double sampleRate, int blockSize, double secondsToRender, const std::function<void(int blockIndex)>& renderBlock)
+{
+	const int numBlocks = getNumBlocks(sampleRate, blockSize, secondsToRender);
+
+	auto start = Time::getHighResolutionTicks();
+
+	for (int b = 0; b < numBlocks; b++)
+		renderBlock(b);
+
+	auto renderSeconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+	auto audioSeconds = (double)(numBlocks * blockSize) / sampleRate;
+
+	return (double)numVoices * audioSeconds / jmax(renderSeconds, 0.000001);
+}
+
+int VoiceBenchmark::getNumBlocks(double sampleRate, int blockSize, double secondsToRender)
+{
+	return jmax(1, roundToInt(secondsToRender * sampleRate / (double)blockSize));
+}
+
+bool VoiceBenchmark::isValidOutput(const float* data, int numSamples, float minPeak, float maxPeak)
+{
+	float peak = 0.0f;
+
+	for (int i = 0; i < numSamples; i++)
+	{
+		if (!std::isfinite(data[i]))
+			return false;
+
+		peak = jmax(peak, std::abs(data[i]));
+	}
+
+	return peak >= minPeak && peak <= maxPeak;
+}
+
+#endif
+
+}
@@ -0,0 +1,58 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef VOICEBENCHMARK_H_INCLUDED
+#define VOICEBENCHMARK_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+#if HI_RUN_UNIT_TESTS
+
+/** Helper functions for the unit tests that report how many voices a single core can render in realtime. */
+struct VoiceBenchmark
+{
+	/** Calls the render function with the index of every block that is needed to render the given amount of audio
+		and returns how many voices a single core could render in realtime. The render function must process all voices. */
+	static double measureVoicesPerCore(int numVoices, double sampleRate, int blockSize, double secondsToRender, const std::function<void(int blockIndex)>& renderBlock);
+
+	/** Returns the number of blocks that measureVoicesPerCore() renders. */
+	static int getNumBlocks(double sampleRate, int blockSize, double secondsToRender);
+
+	/** Checks that the data contains no invalid numbers and that its peak is within the given range. */
+	static bool isValidOutput(const float* data, int numSamples, float minPeak, float maxPeak);
+};
+
+#endif
+
+}
+
+#endif
@@ -285,6 +285,18 @@ void time_stretcher::registerEngines(time_stretcher& t)
 #endif
 }
 
+void time_stretcher::swapEngineWith(time_stretcher& other)
+{
+    ScopedLock sl(stretchLock);
+    ScopedLock sl2(other.stretchLock);
+
+    jassert(getCurrentEngine() == other.getCurrentEngine());
+
+    engine.swapWith(other.engine);
+    std::swap(numChannels, other.numChannels);
+    std::swap(sourceSampleRate, other.sourceSampleRate);
+}
+
 juce::Identifier time_stretcher::getCurrentEngine() const
 {
     return engine != nullptr ? engine->getEngineId() : Identifier();
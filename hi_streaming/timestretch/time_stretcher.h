@@ -59,10 +59,17 @@ struct time_stretcher
     
     static void registerEngines(time_stretcher& t);
 
-private:
+    /** Swaps the engine (and its internal state) with the other stretcher.
+    
+        This can be used to replace the engine of a voice with one that has already processed
+        the latency samples in a background thread. Both stretchers must use the same engine type.
+    */
+    void swapEngineWith(time_stretcher& other);
 
     Identifier getCurrentEngine() const;
 
+private:
+
     static Identifier getDefaultEngineId();
 
     Array<EngineFactoryFunction> availableEngines;
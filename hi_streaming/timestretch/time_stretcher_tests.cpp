@@ -0,0 +1,178 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#if HI_RUN_UNIT_TESTS
+
+namespace hise {
+using namespace juce;
+
+/** Measures how many stretching voices a single core can render and
+    how much time a warmed up engine saves at the voice start. */
+struct TimestretchBenchmark : public UnitTest
+{
+    static constexpr int BlockSize = 512;
+    static constexpr int NumVoices = 8;
+    static constexpr double SampleRate = 44100.0;
+
+    TimestretchBenchmark() :
+        UnitTest("Timestretch benchmark", "Benchmark")
+    {}
+
+    void runTest() override
+    {
+        createInput();
+
+        testEngineSwap();
+        testVoicesPerCore();
+    }
+
+private:
+
+    void createInput()
+    {
+        input.setSize(2, 16384);
+
+        Random r(1);
+
+        for (int i = 0; i < input.getNumSamples(); i++)
+        {
+            auto v = 0.5f * std::sin((float)i * 0.05f) + 0.1f * (r.nextFloat() - 0.5f);
+            input.setSample(0, i, v);
+            input.setSample(1, i, v);
+        }
+    }
+
+    static float getMagnitude(AudioSampleBuffer& b, int numSamples)
+    {
+        return b.getMagnitude(0, 0, numSamples);
+    }
+
+    void testEngineSwap()
+    {
+        beginTest("Testing engine swap with a warmed up engine");
+
+        time_stretcher voice(true), warm(true);
+
+        for (auto t : { &voice, &warm })
+        {
+            t->configure(2, SampleRate);
+            t->setResampleBuffer(1.0, nullptr, 0);
+            t->setTransposeSemitones(0.0);
+        }
+
+        auto numRequired = roundToInt(warm.getLatency(1.0));
+
+        expect(numRequired < input.getNumSamples(), "latency exceeds test input");
+
+        float* inp[2] = { input.getWritePointer(0), input.getWritePointer(1) };
+
+        auto numConsumed = warm.skipLatency(inp, 1.0);
+
+        expectEquals(roundToInt(numConsumed), numRequired, "wrong number of consumed samples");
+
+        voice.reset();
+        voice.swapEngineWith(warm);
+
+        AudioSampleBuffer output(2, BlockSize);
+        float* out[2] = { output.getWritePointer(0), output.getWritePointer(1) };
+
+        float* next[2] = { inp[0] + (int)numConsumed, inp[1] + (int)numConsumed };
+
+        voice.process(next, BlockSize, out, BlockSize);
+        expect(getMagnitude(output, BlockSize) > 0.01f, "warmed up engine should produce output immediately");
+    }
+
+    void testVoicesPerCore()
+    {
+        beginTest("Measuring voices per core");
+
+        OwnedArray<time_stretcher> voices;
+
+        for (int i = 0; i < NumVoices; i++)
+        {
+            auto v = voices.add(new time_stretcher(true));
+            v->configure(2, SampleRate);
+            v->setResampleBuffer(1.0, nullptr, 0);
+            v->setTransposeSemitones((double)i * 0.5);
+        }
+
+        AudioSampleBuffer output(2, BlockSize);
+        float* out[2] = { output.getWritePointer(0), output.getWritePointer(1) };
+
+        double warmupSeconds = 0.0;
+
+        for (auto v : voices)
+        {
+            float* inp[2] = { input.getWritePointer(0), input.getWritePointer(1) };
+
+            auto start = Time::getHighResolutionTicks();
+            v->skipLatency(inp, 1.0);
+            warmupSeconds += Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+        }
+
+        int numInvalidBlocks = 0;
+
+        auto voicesPerCore = VoiceBenchmark::measureVoicesPerCore(NumVoices, SampleRate, BlockSize, 2.0, [&](int b)
+        {
+            auto offset = (b * BlockSize) % (input.getNumSamples() - 2 * BlockSize);
+
+            for (int i = 0; i < NumVoices; i++)
+            {
+                // mix a few different ratios
+                auto numInput = roundToInt((double)BlockSize * (1.0 + 0.25 * (double)(i % 3)));
+
+                float* inp[2] = { input.getWritePointer(0, offset), input.getWritePointer(1, offset) };
+                voices[i]->process(inp, numInput, out, BlockSize);
+
+                // The engines were warmed up, so every block must contain the stretched signal
+                for (int c = 0; c < 2; c++)
+                {
+                    if (!VoiceBenchmark::isValidOutput(out[c], BlockSize, 0.01f, 2.0f))
+                        numInvalidBlocks++;
+                }
+            }
+        });
+
+        logMessage("Voices per core: " + String(voicesPerCore, 1));
+        logMessage("Latency warm up per voice: " + String(warmupSeconds * 1000.0 / (double)NumVoices, 2) + "ms");
+
+        expectEquals(numInvalidBlocks, 0, "silent or invalid output");
+    }
+
+    AudioSampleBuffer input;
+};
+
+static TimestretchBenchmark timestretchBenchmark;
+
+}
+
+#endif
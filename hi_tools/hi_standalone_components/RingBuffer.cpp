@@ -305,15 +305,18 @@ void SimpleRingBuffer::onComplexDataEvent(ComplexDataUIUpdaterBase::EventType t,
 {
 	if(t == ComplexDataUIUpdaterBase::EventType::ContentRedirected)
 		setupReadBuffer(externalBuffer);
-	else
-	{
-        ScopedLock sl(getReadBufferLock());
-        
-		read(externalBuffer);
+	else if (!isAnalysedInBackground())
+		updateReadBuffer();
+}
 
-		if (properties != nullptr && getReferenceCount() > 1)
-			properties->transformReadBuffer(externalBuffer);
-	}
+void SimpleRingBuffer::updateReadBuffer()
+{
+	ScopedLock sl(getReadBufferLock());
+
+	read(externalBuffer);
+
+	if (properties != nullptr && getReferenceCount() > 1)
+		properties->transformReadBuffer(externalBuffer);
 }
 
 void SimpleRingBuffer::setProperty(const Identifier& id, const var& newValue)
@@ -462,12 +465,285 @@ void RingBufferComponentBase::setComplexDataUIBase(ComplexDataUIBase* newData)
 		rb->getUpdater().addEventListener(this);
 	}
 
+	updateBackgroundDisplay();
 	refresh();
 }
 
 RingBufferComponentBase::LookAndFeelMethods::~LookAndFeelMethods()
 {}
 
+RingBufferComponentBase::~RingBufferComponentBase()
+{
+	if (backgroundDisplay != nullptr)
+		analysisService->unregisterDisplay(backgroundDisplay.get());
+}
+
+void RingBufferComponentBase::setUseBackgroundAnalysis(bool shouldUseBackgroundAnalysis)
+{
+	if (useBackgroundAnalysis != shouldUseBackgroundAnalysis)
+	{
+		useBackgroundAnalysis = shouldUseBackgroundAnalysis;
+		updateBackgroundDisplay();
+	}
+}
+
+void RingBufferComponentBase::updateBackgroundDisplay()
+{
+	if (backgroundDisplay != nullptr)
+	{
+		analysisService->unregisterDisplay(backgroundDisplay.get());
+		backgroundDisplay = nullptr;
+	}
+
+	auto type = getDisplayType();
+
+	if (useBackgroundAnalysis && rb != nullptr && type != RingBufferAnalysisService::DisplayType::numDisplayTypes)
+		backgroundDisplay = analysisService->registerDisplay(rb.get(), type);
+}
+
+RingBufferAnalysisService::Display::Display(SimpleRingBuffer* rb, DisplayType t) :
+	type(t),
+	buffer(rb)
+{}
+
+void RingBufferAnalysisService::Display::setBounds(Rectangle<float> newBounds)
+{
+	ScopedLock sl(lock);
+	bounds = newBounds;
+}
+
+Path RingBufferAnalysisService::Display::getPath(Rectangle<float> targetBounds) const
+{
+	ScopedLock sl(lock);
+
+	auto p = path;
+
+	// The bounds might have changed since the last update, so we scale the old path
+	if (targetBounds != dataBounds && !dataBounds.isEmpty())
+		p.applyTransform(AffineTransform::fromTargetPoints(dataBounds.getTopLeft(), targetBounds.getTopLeft(),
+			                                               dataBounds.getTopRight(), targetBounds.getTopRight(),
+			                                               dataBounds.getBottomLeft(), targetBounds.getBottomLeft()));
+
+	return p;
+}
+
+RectangleList<float> RingBufferAnalysisService::Display::getDots() const
+{
+	ScopedLock sl(lock);
+	return dots;
+}
+
+var RingBufferAnalysisService::Display::toJSON() const
+{
+	static const StringArray typeNames = { "FFT", "Oscilloscope", "Goniometer" };
+
+	auto obj = new DynamicObject();
+	obj->setProperty("Type", typeNames[(int)type]);
+	obj->setProperty("NumUpdates", getNumUpdates());
+	obj->setProperty("AverageMicroseconds", getAverageMicroseconds());
+	return var(obj);
+}
+
+void RingBufferAnalysisService::Display::update(double bufferMicroseconds)
+{
+	auto start = Time::getHighResolutionTicks();
+
+	Rectangle<float> area;
+
+	{
+		ScopedLock sl(lock);
+		area = bounds;
+	}
+
+	if (area.isEmpty())
+		return;
+
+	Path newPath;
+	RectangleList<float> newDots;
+
+	createData(area, newPath, newDots);
+
+	{
+		ScopedLock sl(lock);
+		path.swapWithPath(newPath);
+		dots.swapWith(newDots);
+		dataBounds = area;
+	}
+
+	auto microseconds = bufferMicroseconds + Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start) * 1000000.0;
+	auto n = ++numUpdates;
+
+	// Use a running average that ignores the first updates after some time
+	auto alpha = jmax(1.0 / (double)n, 0.05);
+	averageMicroseconds.store(averageMicroseconds.load() * (1.0 - alpha) + microseconds * alpha);
+}
+
+void RingBufferAnalysisService::Display::createData(Rectangle<float> area, Path& p, RectangleList<float>& d) const
+{
+	auto rb = buffer;
+
+	if (rb == nullptr)
+		return;
+
+	SimpleReadWriteLock::ScopedTryReadLock sl(rb->getDataLock());
+
+	if (!sl)
+		return;
+
+	ScopedLock rl(rb->getReadBufferLock());
+
+	auto po = rb->getPropertyObject();
+	const auto& b = rb->getReadBuffer();
+
+	switch (type)
+	{
+	case DisplayType::FFT:
+		p = po->createPath({}, {}, area, 0.0);
+		break;
+	case DisplayType::Oscilloscope:
+		p = po->createPath({ 0, b.getNumSamples() }, { -1.0f, 1.0f }, area, 0.0);
+		break;
+	case DisplayType::Goniometer:
+	{
+		if (b.getNumChannels() < 2 || b.getNumSamples() < 128)
+			return;
+
+		auto size = jmin<int>((int)area.getWidth(), (int)area.getHeight());
+		Rectangle<int> square((int)(area.getWidth() - size) / 2, (int)(area.getHeight() - size) / 2, size, size);
+
+		d = GoniometerBase::Shape(b, square).points;
+		break;
+	}
+	case DisplayType::numDisplayTypes:
+		break;
+	}
+}
+
+RingBufferAnalysisService::RingBufferAnalysisService() :
+	Thread("Ring Buffer Analysis"),
+	intervalMilliseconds(roundToInt(1000.0 / (double)jmax(1, HISE_BACKGROUND_ANALYSIS_RATE)))
+{}
+
+RingBufferAnalysisService::~RingBufferAnalysisService()
+{
+	stopThread(1000);
+}
+
+RingBufferAnalysisService::Display::Ptr RingBufferAnalysisService::registerDisplay(SimpleRingBuffer* rb, DisplayType t)
+{
+	Display::Ptr d = new Display(rb, t);
+
+	{
+		ScopedLock sl(displayLock);
+		displays.add(d);
+	}
+
+	rb->setAnalysedInBackground(true);
+
+	// The thread might still be running after the last display was removed
+	if (!isThreadRunning() || threadShouldExit())
+	{
+		stopThread(1000);
+		startThread(4);
+	}
+
+	return d;
+}
+
+void RingBufferAnalysisService::unregisterDisplay(Display* d)
+{
+	bool stillUsed = false;
+	bool isEmpty = false;
+
+	{
+		ScopedLock sl(displayLock);
+		displays.removeObject(d);
+
+		for (auto other : displays)
+			stillUsed |= other->buffer == d->buffer;
+
+		isEmpty = displays.isEmpty();
+	}
+
+	// Wait for a running update, so that the last reference to the display
+	// and its buffer isn't released on the background thread
+	{
+		ScopedLock sl(updateLock);
+	}
+
+	// Let the message thread analyse the buffer again
+	if (!stillUsed && d->buffer != nullptr)
+		d->buffer->setAnalysedInBackground(false);
+
+	if (isEmpty)
+		signalThreadShouldExit();
+}
+
+void RingBufferAnalysisService::setRefreshRate(double newRateHz)
+{
+	intervalMilliseconds = roundToInt(1000.0 / jlimit(1.0, 240.0, newRateHz));
+}
+
+var RingBufferAnalysisService::getStatistics() const
+{
+	Array<var> list;
+
+	ScopedLock sl(displayLock);
+
+	for (auto d : displays)
+		list.add(d->toJSON());
+
+	return var(list);
+}
+
+void RingBufferAnalysisService::run()
+{
+	while (!threadShouldExit())
+	{
+		auto start = Time::getMillisecondCounter();
+
+		{
+			ScopedLock ul(updateLock);
+
+			ReferenceCountedArray<Display> thisTime;
+
+			{
+				ScopedLock sl(displayLock);
+				thisTime.addArray(displays);
+			}
+
+			ReferenceCountedArray<SimpleRingBuffer> updatedBuffers;
+
+			for (auto d : thisTime)
+			{
+				SimpleRingBuffer::Ptr rb = d->buffer;
+
+				if (rb == nullptr || !rb->isActive())
+					continue;
+
+				double bufferMicroseconds = 0.0;
+
+				// Read and transform every buffer only once, even if it has multiple displays
+				if (!updatedBuffers.contains(rb.get()))
+				{
+					auto bufferStart = Time::getHighResolutionTicks();
+					rb->updateReadBuffer();
+					bufferMicroseconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - bufferStart) * 1000000.0;
+					updatedBuffers.add(rb);
+				}
+
+				d->update(bufferMicroseconds);
+
+				if (threadShouldExit())
+					return;
+			}
+		}
+
+		auto elapsed = (int)(Time::getMillisecondCounter() - start);
+		wait(jmax(1, intervalMilliseconds.load() - elapsed));
+	}
+}
+
 RingBufferComponentBase::RingBufferComponentBase()
 {
 	setSpecialLookAndFeel(new DefaultLookAndFeel(), true);
@@ -1192,7 +1468,15 @@ void FFTDisplayBase::drawSpectrum(Graphics& g)
 
 	if (rb != nullptr)
 	{
-		auto lPath = rb->getPropertyObject()->createPath({}, {}, targetBounds, 0.0);
+		Path lPath;
+
+		if (backgroundDisplay != nullptr)
+		{
+			backgroundDisplay->setBounds(targetBounds);
+			lPath = backgroundDisplay->getPath(targetBounds);
+		}
+		else
+			lPath = rb->getPropertyObject()->createPath({}, {}, targetBounds, 0.0);
 
 		Path grid;
 
@@ -1313,7 +1597,16 @@ void OscilloscopeBase::drawOscilloscope(Graphics &g, const AudioSampleBuffer &b)
 {
 	auto asComponent = dynamic_cast<Component*>(this);
 	auto lb = asComponent->getLocalBounds().toFloat();
-	auto path = rb->getPropertyObject()->createPath({ 0, b.getNumSamples() }, { -1.0f, 1.0f }, lb, 0.0);
+
+	Path path;
+
+	if (backgroundDisplay != nullptr)
+	{
+		backgroundDisplay->setBounds(lb);
+		path = backgroundDisplay->getPath(lb);
+	}
+	else
+		path = rb->getPropertyObject()->createPath({ 0, b.getNumSamples() }, { -1.0f, 1.0f }, lb, 0.0);
 
 	auto laf = getSpecialLookAndFeel<LookAndFeelMethods>();
 
@@ -1415,7 +1708,13 @@ void GoniometerBase::paintSpacialDots(Graphics& g)
 			laf->drawAnalyserGrid(g, *this, grid);
 
 			shapeIndex = (shapeIndex + 1) % 6;
-			shapes[shapeIndex] = Shape(rb->getReadBuffer(), area);
+			if (backgroundDisplay != nullptr)
+			{
+				backgroundDisplay->setBounds(asComponent->getLocalBounds().toFloat());
+				shapes[shapeIndex] = Shape(backgroundDisplay->getDots());
+			}
+			else
+				shapes[shapeIndex] = Shape(rb->getReadBuffer(), area);
 
 			for (int i = 0; i < 6; i++)
 			{
@@ -1428,4 +1727,58 @@ void GoniometerBase::paintSpacialDots(Graphics& g)
 
 }
 
+#if HI_RUN_UNIT_TESTS
+
+struct RingBufferAnalysisServiceTest: public UnitTest
+{
+	RingBufferAnalysisServiceTest():
+	  UnitTest("Testing ring buffer analysis service")
+	{}
+
+	void runTest() override
+	{
+		beginTest("Registering a display");
+
+		SimpleRingBuffer::Ptr rb = new SimpleRingBuffer();
+		rb->setRingBufferSize(1, 1024);
+
+		AudioSampleBuffer input(1, 1024);
+
+		for (int i = 0; i < input.getNumSamples(); i++)
+			input.setSample(0, i, 0.5f * std::sin((float)i * 0.05f));
+
+		rb->write(input, 0, input.getNumSamples());
+
+		SharedResourcePointer<RingBufferAnalysisService> service;
+		service->setRefreshRate(100.0);
+
+		auto d = service->registerDisplay(rb.get(), RingBufferAnalysisService::DisplayType::Oscilloscope);
+		d->setBounds({ 0.0f, 0.0f, 200.0f, 100.0f });
+
+		expect(rb->isAnalysedInBackground(), "buffer isn't analysed in the background");
+
+		auto timeout = Time::getMillisecondCounter() + 2000;
+
+		while (d->getNumUpdates() == 0 && Time::getMillisecondCounter() < timeout)
+			Thread::sleep(10);
+
+		expect(d->getNumUpdates() > 0, "display wasn't updated");
+		expect(!d->getPath({ 0.0f, 0.0f, 200.0f, 100.0f }).isEmpty(), "no path was created");
+
+		auto stats = service->getStatistics();
+
+		expectEquals(stats.size(), 1, "statistics size");
+		expectEquals(stats[0]["Type"].toString(), String("Oscilloscope"), "display type");
+
+		service->unregisterDisplay(d.get());
+
+		expect(!rb->isAnalysedInBackground(), "buffer is still analysed in the background");
+		expectEquals(service->getStatistics().size(), 0, "display wasn't removed");
+	}
+};
+
+static RingBufferAnalysisServiceTest rbasTests;
+
+#endif
+
 } // namespace hise
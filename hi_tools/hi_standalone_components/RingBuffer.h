@@ -217,6 +217,17 @@ struct SimpleRingBuffer: public ComplexDataUIBase,
 
 	int getMaxLengthInSamples() const;
 
+	/** Reads the ring buffer into the read buffer and applies the transformation of the property object.
+	
+		This is called on the message thread whenever new data was written, unless the buffer is analysed
+		by the RingBufferAnalysisService.
+	*/
+	void updateReadBuffer();
+
+	void setAnalysedInBackground(bool shouldBeAnalysedInBackground) { analysedInBackground = shouldBeAnalysedInBackground; }
+
+	bool isAnalysedInBackground() const noexcept { return analysedInBackground.load(); }
+
 private:
 
 	
@@ -256,6 +267,7 @@ private:
 	Array<var> externalBufferData;
 
 
+	std::atomic<bool> analysedInBackground = { false };
 	std::atomic<bool> isBeingWritten = { false };
 	std::atomic<int> numAvailable = { 0 };
 	std::atomic<int> writeIndex = { 0 };
@@ -274,6 +286,105 @@ private:
 };
 
 
+/** A background thread that calculates the data of all registered ring buffer displays.
+
+	Normally each display reads its ring buffer, calculates the FFT and creates the path on the message thread.
+	If you have many analysers open this adds up, so the displays can register here instead and
+	the service updates the read buffer and creates the paths for all of them on a single thread
+	with a fixed rate. The displays then only draw the latest result.
+
+	Use it with a SharedResourcePointer. The thread is only running while there are registered displays.
+*/
+class RingBufferAnalysisService : private Thread
+{
+public:
+
+	enum class DisplayType
+	{
+		FFT,
+		Oscilloscope,
+		Goniometer,
+		numDisplayTypes
+	};
+
+	/** The data of a single display. This is shared between the display and the service so that the
+		service never accesses the component.
+	*/
+	struct Display : public ReferenceCountedObject
+	{
+		using Ptr = ReferenceCountedObjectPtr<Display>;
+
+		Display(SimpleRingBuffer* rb, DisplayType t);
+
+		/** Call this in the paint routine with the current bounds of the display. */
+		void setBounds(Rectangle<float> newBounds);
+
+		/** Returns the latest path scaled to the given bounds. */
+		Path getPath(Rectangle<float> targetBounds) const;
+
+		/** Returns the latest goniometer dots. */
+		RectangleList<float> getDots() const;
+
+		/** Returns the average time in microseconds that the service spends on this display per update. */
+		double getAverageMicroseconds() const { return averageMicroseconds.load(); }
+
+		int64 getNumUpdates() const { return numUpdates.load(); }
+
+		var toJSON() const;
+
+		const DisplayType type;
+
+		// a strong reference, so the buffer can't be deleted during an update
+		const SimpleRingBuffer::Ptr buffer;
+
+	private:
+
+		friend class RingBufferAnalysisService;
+
+		void update(double bufferMicroseconds);
+
+		void createData(Rectangle<float> area, Path& p, RectangleList<float>& dots) const;
+
+		mutable CriticalSection lock;
+		Rectangle<float> bounds;
+		Rectangle<float> dataBounds;
+		Path path;
+		RectangleList<float> dots;
+
+		std::atomic<double> averageMicroseconds = { 0.0 };
+		std::atomic<int64> numUpdates = { 0 };
+	};
+
+	RingBufferAnalysisService();
+	~RingBufferAnalysisService();
+
+	/** Registers a display for the given ring buffer and starts the thread if necessary. */
+	Display::Ptr registerDisplay(SimpleRingBuffer* rb, DisplayType t);
+
+	/** Removes the display and stops the thread if it was the last one. This waits until a running update is finished. */
+	void unregisterDisplay(Display* d);
+
+	/** Sets the rate in Hz at which the displays are updated. */
+	void setRefreshRate(double newRateHz);
+
+	/** Returns a JSON array with the type, the update count and the average cost of every display. */
+	var getStatistics() const;
+
+private:
+
+	void run() override;
+
+	mutable CriticalSection displayLock;
+	ReferenceCountedArray<Display> displays;
+
+	// held by the thread while it updates the displays
+	CriticalSection updateLock;
+
+	std::atomic<int> intervalMilliseconds;
+
+	JUCE_DECLARE_NON_COPYABLE(RingBufferAnalysisService);
+};
+
 struct RingBufferComponentBase : public ComplexDataUIBase::EditorBase,
 								 public ComplexDataUIUpdaterBase::EventListener
 {
@@ -305,8 +416,13 @@ struct RingBufferComponentBase : public ComplexDataUIBase::EditorBase,
 
 	RingBufferComponentBase();
 
+	virtual ~RingBufferComponentBase();
+
 	virtual void refresh() = 0;
 
+	/** Calculates the data of this display on the thread of the RingBufferAnalysisService. */
+	void setUseBackgroundAnalysis(bool shouldUseBackgroundAnalysis);
+
 	virtual Colour getColourForAnalyserBase(int colourId);
 
 	void setUseCustomColours(bool shouldUseCustomColours)
@@ -316,10 +432,19 @@ struct RingBufferComponentBase : public ComplexDataUIBase::EditorBase,
 
 protected:
 
+	/** Override this and return the type if the display can be calculated by the RingBufferAnalysisService. */
+	virtual RingBufferAnalysisService::DisplayType getDisplayType() const { return RingBufferAnalysisService::DisplayType::numDisplayTypes; }
+
+	void updateBackgroundDisplay();
+
 	bool useCustomColours = false;
 
 	SimpleRingBuffer::Ptr rb;
 
+	bool useBackgroundAnalysis = HISE_USE_BACKGROUND_ANALYSIS;
+	SharedResourcePointer<RingBufferAnalysisService> analysisService;
+	RingBufferAnalysisService::Display::Ptr backgroundDisplay;
+
 	JUCE_DECLARE_WEAK_REFERENCEABLE(RingBufferComponentBase);
 };
 
@@ -499,6 +624,7 @@ protected:
 		dynamic_cast<Component*>(this)->repaint();
 	}
 
+	RingBufferAnalysisService::DisplayType getDisplayType() const override { return RingBufferAnalysisService::DisplayType::Oscilloscope; }
 
 private:
 
@@ -555,6 +681,8 @@ protected:
 	FFTDisplayBase()
 	{}
 
+	RingBufferAnalysisService::DisplayType getDisplayType() const override { return RingBufferAnalysisService::DisplayType::FFT; }
+
 
     ScopedPointer<juce::dsp::FFT> fftObject;
     
@@ -589,12 +717,20 @@ protected:
 
 	void paintSpacialDots(Graphics& g);
 
+	RingBufferAnalysisService::DisplayType getDisplayType() const override { return RingBufferAnalysisService::DisplayType::Goniometer; }
+
 private:
 
+	friend class RingBufferAnalysisService;
+
 	struct Shape
 	{
 		Shape() {};
 
+		Shape(const RectangleList<float>& p) :
+			points(p)
+		{}
+
 		Shape(const AudioSampleBuffer& buffer, Rectangle<int> size);
 
 		RectangleList<float> points;
@@ -114,6 +114,24 @@ will break compatibility with older projects / presets because the tempo indexes
 #define HISE_USE_EXTENDED_TEMPO_VALUES 0
 #endif
 
+/** Config: HISE_USE_BACKGROUND_ANALYSIS
+
+If this is true, the FFT, oscilloscope and goniometer displays calculate their data on the shared thread
+of the RingBufferAnalysisService instead of the message thread.
+
+*/
+#ifndef HISE_USE_BACKGROUND_ANALYSIS
+#define HISE_USE_BACKGROUND_ANALYSIS 0
+#endif
+
+/** Config: HISE_BACKGROUND_ANALYSIS_RATE
+
+The default rate in Hz at which the RingBufferAnalysisService updates the registered displays.
+*/
+#ifndef HISE_BACKGROUND_ANALYSIS_RATE
+#define HISE_BACKGROUND_ANALYSIS_RATE 30
+#endif
+
 /** Reenables using the mouse wheel to control the table curve if set to 1. */
 #ifndef HISE_USE_MOUSE_WHEEL_FOR_TABLE_CURVE
 #define HISE_USE_MOUSE_WHEEL_FOR_TABLE_CURVE 0
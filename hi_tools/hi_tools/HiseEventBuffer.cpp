@@ -58,7 +58,10 @@ HiseEvent::HiseEvent(const MidiMessage& message)
 	value = data[2];
 
     if(message.isChannelPressure())
+    {
         value = number;
+        startOffset = ChannelPressureMarker;
+    }
     
 	setTimeStamp((int)message.getTimeStamp());
 }
@@ -93,7 +96,8 @@ juce::MidiMessage HiseEvent::toMidiMesage() const
 	case Type::NoteOff:		return MidiMessage::noteOff(channel, number + transposeValue);
 	case Type::Controller:	return MidiMessage::controllerEvent(channel, number, value);
 	case Type::PitchBend:	return MidiMessage::pitchWheel(channel, getPitchWheelValue());
-	case Type::Aftertouch:	return MidiMessage::aftertouchChange(channel, number, value);
+	case Type::Aftertouch:	return isMonophonicAftertouch() ? MidiMessage::channelPressureChange(channel, value) :
+															  MidiMessage::aftertouchChange(channel, number, value);
 	case Type::ProgramChange: return MidiMessage::programChange(channel, getPitchWheelValue());
 	case Type::AllNotesOff:	return MidiMessage::allNotesOff(channel);
     default: break;
@@ -159,6 +163,7 @@ String HiseEvent::getTypeString(HiseEvent::Type t)
 	case HiseEvent::Type::PitchFade: return "PitchFade";
 	case HiseEvent::Type::TimerEvent: return "TimerEvent";
 	case HiseEvent::Type::ProgramChange: return "ProgramChange";
+	case HiseEvent::Type::ParameterChange: return "ParameterChange";
 	case HiseEvent::Type::numTypes: jassertfalse;
 	default: jassertfalse;
 	}
@@ -258,6 +263,17 @@ HiseEvent HiseEvent::createTimerEvent(uint8 timerIndex, int offset)
 	return e;
 }
 
+HiseEvent HiseEvent::createParameterChange(uint16 index, int offset)
+{
+	HiseEvent e(Type::ParameterChange, 0, 0, 1);
+
+	e.setEventId(index);
+	e.setArtificial();
+	e.setTimeStamp(offset);
+
+	return e;
+}
+
 bool HiseEvent::matchesMidiData(const HiseEvent& other) const
 {
 	return type == other.type &&
@@ -530,51 +546,122 @@ void HiseEventBuffer::clear()
 	}
 }
 
+namespace EventBufferHelpers
+{
+static std::atomic<int64> numCoalesced { 0 };
+static std::atomic<int64> numDropped { 0 };
+}
+
 void HiseEventBuffer::addEvent(const HiseEvent& hiseEvent)
 {
 	if (numUsed >= HISE_EVENT_BUFFER_SIZE)
 	{
-		// Buffer full..
-		jassertfalse;
+		addEventToFullBuffer(hiseEvent);
 		return;
 	}
 
-	if (numUsed == 0)
+	// Most events are added in chronological order, so we can skip the search
+	if (numUsed == 0 || buffer[numUsed - 1].getTimeStamp() <= hiseEvent.getTimeStamp())
 	{
-		insertEventAtPosition(hiseEvent, 0);
+		buffer[numUsed++] = hiseEvent;
 		return;
 	}
 
-	jassert(numUsed < HISE_EVENT_BUFFER_SIZE);
+	// The first event with a bigger timestamp (so events with the same timestamp keep their order)
+	auto position = std::upper_bound(begin(), end(), hiseEvent) - begin();
 
-    const int numToLookFor = jmin<int>(numUsed, HISE_EVENT_BUFFER_SIZE);
-    
-	for (int i = 0; i < numToLookFor; i++)
-	{
-		const int timestampInBuffer = buffer[i].getTimeStamp();
-		const int messageTimestamp = hiseEvent.getTimeStamp();
+	insertEventAtPosition(hiseEvent, (int)position);
 
-		if (timestampInBuffer > messageTimestamp)
-		{
-			insertEventAtPosition(hiseEvent, i);
+	jassert(timeStampsAreSorted());
+}
+
+void HiseEventBuffer::addEventToFullBuffer(const HiseEvent& e)
+{
+	jassert(numUsed == HISE_EVENT_BUFFER_SIZE);
 
-#if JUCE_DEBUG
-			if (!timeStampsAreSorted())
+	if (isContinuousController(e))
+	{
+		for (int i = numUsed - 1; i >= 0; i--)
+		{
+			if (isSameControllerStream(buffer[i], e))
 			{
-				for (int j = 0; j < numToLookFor; j++)
-					DBG(buffer[j].toDebugString());
+				overflowStatistics.numCoalesced++;
+				EventBufferHelpers::numCoalesced.fetch_add(1, std::memory_order_relaxed);
+
+				// The new value is already superseded by a later value
+				if (buffer[i].getTimeStamp() > e.getTimeStamp())
+					return;
+
+				// Remove the old value and insert the new one by moving only the events in between
+				auto position = (int)(std::upper_bound(buffer + i + 1, end(), e) - buffer) - 1;
+
+				if (position > i)
+					memmove(buffer + i, buffer + i + 1, sizeof(HiseEvent) * (position - i));
+
+				buffer[position] = e;
+
+				jassert(timeStampsAreSorted());
+				return;
 			}
-#endif
+		}
+	}
 
-			jassert(timeStampsAreSorted());
+	// Remove the oldest controller value that is superseded by a later value of the same stream
+	for (int i = 0; i < numUsed - 1; i++)
+	{
+		if (!isContinuousController(buffer[i]))
+			continue;
 
-			return;
+		for (int j = i + 1; j < numUsed; j++)
+		{
+			if (isSameControllerStream(buffer[i], buffer[j]))
+			{
+				overflowStatistics.numCoalesced++;
+				EventBufferHelpers::numCoalesced.fetch_add(1, std::memory_order_relaxed);
+
+				removeEventAtPosition(i);
+				addEvent(e);
+				return;
+			}
 		}
 	}
 
-	insertEventAtPosition(hiseEvent, numUsed);
+	// Buffer full..
+	overflowStatistics.numDropped++;
+	EventBufferHelpers::numDropped.fetch_add(1, std::memory_order_relaxed);
+	jassertfalse;
+}
 
-	jassert(timeStampsAreSorted());
+HiseEventBuffer::OverflowStatistics HiseEventBuffer::getGlobalOverflowStatistics()
+{
+	OverflowStatistics s;
+	s.numCoalesced = EventBufferHelpers::numCoalesced.load();
+	s.numDropped = EventBufferHelpers::numDropped.load();
+	return s;
+}
+
+bool HiseEventBuffer::isContinuousController(const HiseEvent& e) noexcept
+{
+	return e.isController() || e.isPitchWheel() || e.isAftertouch();
+}
+
+bool HiseEventBuffer::isSameControllerStream(const HiseEvent& a, const HiseEvent& b) noexcept
+{
+	if (a.getType() != b.getType() || a.getChannel() != b.getChannel())
+		return false;
+
+	if (a.isController())
+		return a.getControllerNumber() == b.getControllerNumber();
+
+	if (a.isAftertouch())
+	{
+		if (a.isMonophonicAftertouch() || b.isMonophonicAftertouch())
+			return a.isMonophonicAftertouch() && b.isMonophonicAftertouch();
+
+		return a.getNoteNumber() == b.getNoteNumber();
+	}
+
+	return a.isPitchWheel();
 }
 
 void HiseEventBuffer::addEvent(const MidiMessage& midiMessage, int sampleNumber)
@@ -593,32 +680,21 @@ void HiseEventBuffer::addEvents(const MidiBuffer& otherBuffer)
 	MidiMessage m;
 	int samplePos;
 
-	int index = 0;
-
 	MidiBuffer::Iterator it(otherBuffer);
 
 	while (it.getNextEvent(m, samplePos))
 	{
-		jassert(index < HISE_EVENT_BUFFER_SIZE);
-
 		HiseEvent e(m);
 
 		if (e.isEmpty()) continue;
 
-		e.swapWith(buffer[index]);
+		e.setTimeStamp(samplePos);
 
-		buffer[index].setTimeStamp(samplePos);
-
-		numUsed++;
-
-		if (numUsed >= HISE_EVENT_BUFFER_SIZE)
-		{
-			// Buffer full..
-			jassertfalse;
-			return;
-		}
-
-		index++;
+		// The MidiBuffer is sorted, so we can just append the events until the buffer is full
+		if (numUsed < HISE_EVENT_BUFFER_SIZE)
+			e.swapWith(buffer[numUsed++]);
+		else
+			addEventToFullBuffer(e);
 	}
 
 	jassert(timeStampsAreSorted());
@@ -627,13 +703,55 @@ void HiseEventBuffer::addEvents(const MidiBuffer& otherBuffer)
 
 void HiseEventBuffer::addEvents(const HiseEventBuffer &otherBuffer)
 {
-	Iterator iter(otherBuffer);
+	jassert(&otherBuffer != this);
+
+	addEvents(otherBuffer.buffer, otherBuffer.numUsed);
+}
+
+void HiseEventBuffer::addEvents(const HiseEvent* events, int numEvents)
+{
+	if (numEvents <= 0)
+		return;
+
+	// The merge would overwrite the source
+	jassert(events + numEvents <= buffer || events >= buffer + HISE_EVENT_BUFFER_SIZE);
+
+	bool isSorted = true;
+
+	for (int i = 1; i < numEvents; i++)
+		isSorted &= events[i - 1].getTimeStamp() <= events[i].getTimeStamp();
+
+	if (!isSorted || numUsed + numEvents > HISE_EVENT_BUFFER_SIZE)
+	{
+		for (int i = 0; i < numEvents; i++)
+			addEvent(events[i]);
+
+		return;
+	}
 
-	while (HiseEvent* e = iter.getNextEventPointer(false, false))
+	if (numUsed == 0 || buffer[numUsed - 1].getTimeStamp() <= events[0].getTimeStamp())
 	{
-		addEvent(*e);
+		CopyHelpers::copyEvents(buffer + numUsed, events, numEvents);
+		numUsed += numEvents;
+		return;
 	}
 
+	// Merge from the back so that we don't need a temporary buffer. The existing
+	// events stay in front of new events with the same timestamp (like in addEvent()).
+	int i = numUsed - 1;
+	int j = numEvents - 1;
+	int k = numUsed + numEvents - 1;
+
+	while (j >= 0)
+	{
+		if (i >= 0 && buffer[i].getTimeStamp() > events[j].getTimeStamp())
+			buffer[k--] = buffer[i--];
+		else
+			buffer[k--] = events[j--];
+	}
+
+	numUsed += numEvents;
+
 	jassert(timeStampsAreSorted());
 }
 
@@ -713,13 +831,7 @@ hise::HiseEvent HiseEventBuffer::popEvent(int index)
 	if (isPositiveAndBelow(index, numUsed))
 	{
 		auto e = getEvent(index);
-
-		for (int i = index; i < numUsed; i++)
-			buffer[i] = buffer[i + 1];
-
-		buffer[numUsed - 1] = {};
-		numUsed--;
-
+		removeEventAtPosition(index);
 		return e;
 	}
 	else
@@ -756,16 +868,13 @@ void HiseEventBuffer::moveEventsBelow(HiseEventBuffer& targetBuffer, int highest
 	while (HiseEvent* e = iter.getNextEventPointer())
 	{
 		if (e->getTimeStamp() < highestTimestamp)
-		{
-			targetBuffer.addEvent(*e);
 			numCopied++;
-		}
 		else
-		{
 			break;
-		}
 	}
 
+	targetBuffer.addEvents(buffer, numCopied);
+
 	const int numRemaining = numUsed - numCopied;
 
 	for (int i = 0; i < numRemaining; i++)
@@ -797,10 +906,7 @@ void HiseEventBuffer::moveEventsAbove(HiseEventBuffer& targetBuffer, int lowestT
 
 	if (indexOfFirstElementToMove == -1) return;
 
-	for (int i = indexOfFirstElementToMove; i < numUsed; i++)
-	{
-		targetBuffer.addEvent(buffer[i]);
-	}
+	targetBuffer.addEvents(buffer + indexOfFirstElementToMove, numUsed - indexOfFirstElementToMove);
 
 	HiseEvent::clear(buffer + indexOfFirstElementToMove, numUsed - indexOfFirstElementToMove);
 
@@ -890,17 +996,16 @@ void HiseEventBuffer::insertEventAtPosition(const HiseEvent& e, int positionInBu
 
 	if (numUsed > positionInBuffer)
 	{
-		for (int i = jmin<int>(numUsed-1, HISE_EVENT_BUFFER_SIZE-2); i >= positionInBuffer; i--)
-		{
-			jassert(i + 1 < HISE_EVENT_BUFFER_SIZE);
-			buffer[i + 1] = buffer[i];
-		}
+		auto numToMove = jmin<int>(numUsed, HISE_EVENT_BUFFER_SIZE - 1) - positionInBuffer;
+
+		if (numToMove > 0)
+			memmove(buffer + positionInBuffer + 1, buffer + positionInBuffer, sizeof(HiseEvent) * numToMove);
 	}
 
     if(positionInBuffer < HISE_EVENT_BUFFER_SIZE)
     {
         buffer[positionInBuffer] = HiseEvent(e);
-        numUsed++;
+        numUsed = jmin(numUsed + 1, HISE_EVENT_BUFFER_SIZE);
     }
     else
     {
@@ -908,6 +1013,19 @@ void HiseEventBuffer::insertEventAtPosition(const HiseEvent& e, int positionInBu
     }
 }
 
+void HiseEventBuffer::removeEventAtPosition(int positionInBuffer)
+{
+	jassert(isPositiveAndBelow(positionInBuffer, numUsed));
+
+	auto numToMove = numUsed - positionInBuffer - 1;
+
+	if (numToMove > 0)
+		memmove(buffer + positionInBuffer, buffer + positionInBuffer + 1, sizeof(HiseEvent) * numToMove);
+
+	numUsed--;
+	HiseEvent::clear(buffer + numUsed);
+}
+
 EventIdHandler::ChokeListener::~ChokeListener()
 {}
 
@@ -105,6 +105,7 @@ public:
 		PitchFade, ///< a pitch fade that is applied to all voices started with the given EventID
 		TimerEvent, ///< this event will fire the onTimer callback of MIDI Processors.
 		ProgramChange, ///< the MIDI ProgramChange message.
+		ParameterChange, ///< a host automation event that is applied at its timestamp by the sound generator that owns the automated module.
 		numTypes
 	};
 
@@ -250,6 +251,12 @@ public:
 	*/
 	static HiseEvent createTimerEvent(uint8 timerIndex, int offset);
 
+	/** Creates a parameter change event.
+		@param index the index of the pending value in the HostAutomationLane.
+		@param offset the sample offset within the current buffer [0 - buffer size).
+	*/
+	static HiseEvent createParameterChange(uint16 index, int offset);
+
 	/** This is a less strict comparison that does not take the event ID and the timestamp into account. */
 	bool matchesMidiData(const HiseEvent& other) const;
 
@@ -268,6 +275,12 @@ public:
 	/** Returns the index of the timer slot. */
 	int getTimerIndex() const noexcept { return channel; }	
 
+	/** Returns true if the event is a parameter change from the host automation. */
+	bool isParameterChange() const noexcept { return type == Type::ParameterChange; };
+
+	/** Returns the index of the pending value in the HostAutomationLane. */
+	int getParameterChangeIndex() const noexcept { return (int)eventId; }
+
 	// ========================================================================================================================== MIDI Message methods
 
 	/** Returns the timestamp of the message. The timestamp is the offset from 
@@ -361,6 +374,10 @@ public:
 	/** Copied from MidiMessage. */
 	bool isChannelPressure() const noexcept{ return type == Type::Aftertouch; };
 
+	/** Checks if the event was created from a MIDI channel pressure message. isChannelPressure() also
+		returns true for polyphonic aftertouch, so use this if you need to tell them apart. */
+	bool isMonophonicAftertouch() const noexcept { return type == Type::Aftertouch && startOffset == ChannelPressureMarker; }
+
 	/** Copied from MidiMessage. */
 	int getChannelPressureValue() const noexcept{ return value; };
 
@@ -459,6 +476,9 @@ public:
 
 private:
 
+	/** Channel pressure events don't use the start offset, so it marks them as monophonic. */
+	static constexpr uint16 ChannelPressureMarker = 0xFFFF;
+
 	Type type = Type::Empty;		// DWord 1
 	uint8 channel = 0;
 	uint8 number = 0;
@@ -475,15 +495,32 @@ private:
     uint32 timestamp = 0;
 };
 
+/** The number of events that fit into a HiseEventBuffer. If you're processing dense MPE streams with big
+	buffer sizes you might want to increase this (every slot takes 16 bytes).
+*/
+#ifndef HISE_EVENT_BUFFER_SIZE
 #define HISE_EVENT_BUFFER_SIZE 256
+#endif
 
 /** The buffer type for the HiseEvent.
 
+	If the buffer is full, a continuous controller event (CC, pitch bend or aftertouch) replaces the last
+	event of the same stream so that the final value of each controller is always preserved. If this isn't
+	possible, it removes a controller value that is superseded by a later value of the same stream to make
+	room for the new event. Events are only dropped if neither works, and both cases are counted so you
+	can check the overflow statistics.
 */
 class HiseEventBuffer
 {
 public:
 
+	/** The number of events that were merged or dropped because the buffer was full. */
+	struct OverflowStatistics
+	{
+		int64 numCoalesced = 0;
+		int64 numDropped = 0;
+	};
+
 	/** A simple stack type with 16 slots. */
 	class EventStack
 	{
@@ -545,7 +582,27 @@ public:
 	void addEvent(const MidiMessage& midiMessage, int sampleNumber);
 	void addEvents(const MidiBuffer& otherBuffer);
 
+	/** Merges the events of the other buffer in a single pass. Events with the same timestamp are added after
+		the existing events. */
 	void addEvents(const HiseEventBuffer &otherBuffer);
+
+	/** Merges a list of events that are sorted by their timestamp in a single pass. If the list isn't sorted
+		or doesn't fit into the buffer, the events are added one by one. */
+	void addEvents(const HiseEvent* events, int numEvents);
+
+	/** Returns the overflow statistics of this buffer since the last reset. */
+	OverflowStatistics getOverflowStatistics() const noexcept { return overflowStatistics; }
+
+	void resetOverflowStatistics() noexcept { overflowStatistics = {}; }
+
+	/** Returns the sum of the overflow statistics of all buffers. */
+	static OverflowStatistics getGlobalOverflowStatistics();
+
+	/** Checks if the event is a continuous controller that can be merged if the buffer is full. */
+	static bool isContinuousController(const HiseEvent& e) noexcept;
+
+	/** Checks if both events are values of the same controller stream. */
+	static bool isSameControllerStream(const HiseEvent& a, const HiseEvent& b) noexcept;
 	
 	void sortTimestamps();
 	
@@ -625,9 +682,15 @@ private:
 
 	void insertEventAtPosition(const HiseEvent& e, int positionInBuffer);
 
+	void removeEventAtPosition(int positionInBuffer);
+
+	void addEventToFullBuffer(const HiseEvent& e);
+
 	event_alignment HiseEvent buffer[HISE_EVENT_BUFFER_SIZE];
 
 	int numUsed = 0;
+
+	OverflowStatistics overflowStatistics;
 };
 
 #undef event_alignment
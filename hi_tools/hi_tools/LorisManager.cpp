@@ -116,6 +116,7 @@ void* LorisManager::getFunction(const String& name) const
 	RETURN_STATIC_FUNCTION(getLibraryVersion);
 	RETURN_STATIC_FUNCTION(getLorisVersion);
 	RETURN_STATIC_FUNCTION(loris_analyze);
+	RETURN_STATIC_FUNCTION(loris_analyze_batch);
 	RETURN_STATIC_FUNCTION(loris_process);
 	RETURN_STATIC_FUNCTION(loris_process_custom);
 	RETURN_STATIC_FUNCTION(loris_set);
@@ -283,6 +284,46 @@ void LorisManager::analyse(const Array<AnalyseData>& data)
 	}
 }
 
+bool LorisManager::analyseBatch(const Array<AnalyseData>& data, int numThreads, const File& cacheDirectory)
+{
+#if HISE_USE_LORIS_DLL
+	// older libraries don't have the batch function, so fall back to the serial analysis
+	if(dll != nullptr && dll->getFunction("loris_analyze_batch") == nullptr)
+	{
+		analyse(data);
+		return lastError.wasOk();
+	}
+#endif
+
+	if(auto f = (LorisAnalyseBatchFunction)getFunction("loris_analyze_batch"))
+	{
+		Array<var> fileList;
+
+		for(const auto& ad: data)
+		{
+			DynamicObject::Ptr obj = new DynamicObject();
+			obj->setProperty("file", ad.file.getFullPathName());
+			obj->setProperty("rootFrequency", ad.rootFrequency);
+			fileList.add(var(obj.get()));
+		}
+
+		DynamicObject::Ptr batchData = new DynamicObject();
+		batchData->setProperty("files", var(fileList));
+		batchData->setProperty("numThreads", numThreads);
+
+		if(cacheDirectory != File())
+			batchData->setProperty("cacheDirectory", cacheDirectory.getFullPathName());
+
+		auto json = JSON::toString(var(batchData.get()), true);
+
+		auto ok = f(state, json.getCharPointer().getAddress());
+
+		return checkError() && ok;
+	}
+
+	return false;
+}
+
 double LorisManager::get(String command) const
 {
 	if(auto f = (LorisGetFunction)getFunction("loris_get"))
@@ -38,6 +38,7 @@ struct LorisManager: public ReferenceCountedObject
     
     using GetLorisVersion = char*(*)();
     using LorisAnalyseFunction = bool(*)(void*, char*, double);
+    using LorisAnalyseBatchFunction = bool(*)(void*, const char*);
     using LorisCreateFunction = void*(*)(void);
     using LorisDestroyFunction = void(*)(void*);
     using LorisErrorFunction = char*(*)(void*);
@@ -71,6 +72,10 @@ struct LorisManager: public ReferenceCountedObject
 
     void analyse(const Array<AnalyseData>& data);
 
+    /** Analyses the files on multiple worker threads (numThreads = 0 uses all cores).
+        If the cache directory is not empty, the partials will be cached there. Returns false on errors or cancellation. */
+    bool analyseBatch(const Array<AnalyseData>& data, int numThreads, const File& cacheDirectory);
+
     Array<var> createEnvelope(const File& audioFile, const Identifier& parameter, int index);
     
     
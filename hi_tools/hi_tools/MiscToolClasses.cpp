@@ -2300,6 +2300,61 @@ void FFTHelpers::toComplexArray(const AudioSampleBuffer& phaseBuffer, const Audi
 	}
 }
 
+ParallelForPool::ParallelForPool(int numThreadsToUse):
+	pool(jmax(1, numThreadsToUse - 1))
+{}
+
+void ParallelForPool::parallelFor(int numItems, const std::function<void(int)>& f)
+{
+	std::atomic<int> nextIndex(0);
+
+	auto work = [&]()
+	{
+		for (int i = nextIndex++; i < numItems; i = nextIndex++)
+			f(i);
+	};
+
+	auto numJobs = jmin(pool.getNumThreads(), numItems - 1);
+
+	if (numJobs <= 0)
+	{
+		work();
+		return;
+	}
+
+	std::atomic<int> numPendingJobs(numJobs);
+	jobsFinished.reset();
+
+	for (int i = 0; i < numJobs; i++)
+	{
+		pool.addJob([&]()
+		{
+			work();
+
+			if (--numPendingJobs == 0)
+				jobsFinished.signal();
+		});
+	}
+
+	work();
+	jobsFinished.wait();
+}
+
+juce::dsp::FFT* FFTHelpers::PlanCache::getPlan(int order)
+{
+	if (!isPositiveAndBelow(order, 32))
+		return nullptr;
+
+	ScopedLock sl(lock);
+
+	auto& p = plans[(size_t)order];
+
+	if (p == nullptr)
+		p.reset(new juce::dsp::FFT(order));
+
+	return p.get();
+}
+
 void FFTHelpers::toPhaseSpectrum(const AudioSampleBuffer& inp, AudioSampleBuffer& out)
 {
 	auto input = inp.getReadPointer(0);
@@ -2581,7 +2636,10 @@ Image Spectrum2D::createSpectrumImage(AudioSampleBuffer& lastBuffer)
 AudioSampleBuffer Spectrum2D::createSpectrumBuffer()
 {
 	TRACE_EVENT("scripting", "create spectrum buffer");
-    auto fft = juce::dsp::FFT(parameters->order);
+	auto fft = parameters->planCache->getPlan(parameters->order);
+
+	if (fft == nullptr)
+		return {};
 
     auto numSamplesToFill = jmax(0, originalSource.getNumSamples() / parameters->Spectrum2DSize * parameters->oversamplingFactor - 1);
 
@@ -2637,7 +2695,7 @@ AudioSampleBuffer Spectrum2D::createSpectrumBuffer()
 
         {
 			TRACE_EVENT("scripting", "perform FFT");
-	        fft.performRealOnlyForwardTransform(sb.getWritePointer(0), false);
+	        fft->performRealOnlyForwardTransform(sb.getWritePointer(0), false);
         }
 
         {
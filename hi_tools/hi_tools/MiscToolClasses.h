@@ -2162,6 +2162,31 @@ public:
 	virtual void nonRealtimeModeChanged(bool isNonRealtime) = 0;
 };
 
+/** A thread pool that distributes the iterations of a loop across its threads and the calling thread. */
+class ParallelForPool
+{
+public:
+
+	/** Creates a pool for the given amount of threads including the calling thread, so it starts one thread less. */
+	ParallelForPool(int numThreadsToUse);
+
+	/** Returns the amount of threads including the calling thread. */
+	int getNumThreads() const { return pool.getNumThreads() + 1; }
+
+	/** Calls the function with every index from 0 to numItems - 1 and returns when all indexes are processed.
+
+		The calling thread takes part in the processing. Don't call this from multiple threads at once.
+	*/
+	void parallelFor(int numItems, const std::function<void(int)>& f);
+
+private:
+
+	ThreadPool pool;
+	WaitableEvent jobsFinished;
+
+	JUCE_DECLARE_NON_COPYABLE(ParallelForPool);
+};
+
 struct FFTHelpers
 {
     enum WindowType
@@ -2205,6 +2230,22 @@ struct FFTHelpers
     static void toFreqSpectrum(const AudioSampleBuffer& inp, AudioSampleBuffer& out);
 
     static void scaleFrequencyOutput(AudioSampleBuffer& b, bool convertToDb, bool invert=false);
+
+	/** A cache for FFT plans so that every object that uses the same FFT size shares the lookup tables.
+	
+		Use it with a SharedResourcePointer. The plans are kept alive until the cache is deleted and
+		the transform methods of juce::dsp::FFT are const, so you can use one plan on multiple threads.
+	*/
+	struct PlanCache
+	{
+		/** Returns the plan for the given order (log2 of the FFT size). This creates the plan if it doesn't exist yet. */
+		juce::dsp::FFT* getPlan(int order);
+
+	private:
+
+		CriticalSection lock;
+		std::array<std::unique_ptr<juce::dsp::FFT>, 32> plans;
+	};
 };
 
 struct Spectrum2D
@@ -2311,6 +2352,9 @@ struct Spectrum2D
 
 		LookupTable::Ptr lut;
 
+		// keeps the FFT plans alive as long as the parameters are used
+		SharedResourcePointer<FFTHelpers::PlanCache> planCache;
+
 		JUCE_DECLARE_WEAK_REFERENCEABLE(Parameters);
 	};
 
@@ -436,6 +436,22 @@ void VariantBuffer::addMethods()
         return var();
     });
     
+	setMethod("eval", [](const var::NativeFunctionArgs& n)
+	{
+		if (auto bf = n.thisObject.getBuffer())
+		{
+			if (n.numArguments == 0)
+				throw String("expected expression");
+
+			auto e = Expression::getOrCreate(n.arguments[0].toString());
+			e->evaluate(*bf, n.numArguments > 1 ? n.arguments[1] : var());
+
+			return n.thisObject;
+		}
+
+		return var();
+	});
+
 	setMethod("getPeakRange", [](const var::NativeFunctionArgs& n)
 	{
 		Array<var> range;
@@ -609,6 +625,383 @@ const float & VariantBuffer::operator[](int sampleIndex) const
 	return buffer.getReadPointer(0)[sampleIndex];
 }
 
+struct VariantBuffer::Expression::Parser
+{
+	Parser(Expression& e) :
+		parent(e),
+		it(e.code.getCharPointer())
+	{}
+
+	void parse()
+	{
+		parseSum();
+		skipWhitespace();
+
+		if (!it.isEmpty())
+			throwError("unexpected character " + String::charToString(*it));
+
+		if (parent.instructions.isEmpty())
+			throwError("empty expression");
+	}
+
+private:
+
+	void parseSum()
+	{
+		parseProduct();
+
+		for (;;)
+		{
+			if (matchChar('+'))
+			{
+				parseProduct();
+				add(OpCode::Add);
+			}
+			else if (matchChar('-'))
+			{
+				parseProduct();
+				add(OpCode::Subtract);
+			}
+			else
+				return;
+		}
+	}
+
+	void parseProduct()
+	{
+		parseUnary();
+
+		for (;;)
+		{
+			if (matchChar('*'))
+			{
+				parseUnary();
+				add(OpCode::Multiply);
+			}
+			else if (matchChar('/'))
+			{
+				parseUnary();
+				add(OpCode::Divide);
+			}
+			else
+				return;
+		}
+	}
+
+	void parseUnary()
+	{
+		if (matchChar('-'))
+		{
+			parseUnary();
+			add(OpCode::Negate);
+		}
+		else if (matchChar('+'))
+			parseUnary();
+		else
+			parsePrimary();
+	}
+
+	void parsePrimary()
+	{
+		skipWhitespace();
+
+		if (matchChar('('))
+		{
+			parseSum();
+			expectChar(')');
+			return;
+		}
+
+		if (CharacterFunctions::isDigit(*it) || *it == '.')
+		{
+			auto start = it;
+
+			while (CharacterFunctions::isDigit(*it) || *it == '.')
+				++it;
+
+			if (*it == 'e' || *it == 'E')
+			{
+				++it;
+
+				if (*it == '-' || *it == '+')
+					++it;
+
+				while (CharacterFunctions::isDigit(*it))
+					++it;
+			}
+
+			add(OpCode::PushConstant, 0, String(start, it).getFloatValue());
+			return;
+		}
+
+		if (CharacterFunctions::isLetter(*it) || *it == '_')
+		{
+			auto start = it;
+
+			while (CharacterFunctions::isLetterOrDigit(*it) || *it == '_')
+				++it;
+
+			String name(start, it);
+
+			if (matchChar('('))
+			{
+				if (name == "abs")
+				{
+					parseSum();
+					add(OpCode::Abs);
+				}
+				else if (name == "min" || name == "max")
+				{
+					parseSum();
+					expectChar(',');
+					parseSum();
+					add(name == "min" ? OpCode::Min : OpCode::Max);
+				}
+				else
+					throwError("unknown function " + name);
+
+				expectChar(')');
+				return;
+			}
+
+			Identifier id(name);
+			parent.variableNames.addIfNotAlreadyThere(id);
+
+			if (parent.variableNames.size() > MaxNumVariables)
+				throwError("too many variables");
+
+			add(OpCode::PushVariable, parent.variableNames.indexOf(id));
+			return;
+		}
+
+		if (it.isEmpty())
+			throwError("unexpected end of expression");
+
+		throwError("unexpected character " + String::charToString(*it));
+	}
+
+	void add(OpCode op, int index = 0, float value = 0.0f)
+	{
+		auto& ins = parent.instructions;
+
+		switch (op)
+		{
+		case OpCode::PushVariable:
+		case OpCode::PushConstant:
+			stackSize++;
+			break;
+		case OpCode::Negate:
+		case OpCode::Abs:
+			if (ins.getLast().op == OpCode::PushConstant)
+			{
+				auto& c = ins.getReference(ins.size() - 1);
+				c.value = op == OpCode::Negate ? -c.value : std::abs(c.value);
+				return;
+			}
+
+			break;
+		default:
+			stackSize--;
+
+			// Use the scalar operations if the right operand is a constant
+			if (ins.getLast().op == OpCode::PushConstant)
+			{
+				auto c = ins.getLast().value;
+
+				if (op == OpCode::Add || op == OpCode::Subtract)
+				{
+					ins.removeLast();
+					ins.add({ OpCode::AddConstant, 0, op == OpCode::Add ? c : -c });
+					return;
+				}
+
+				if (op == OpCode::Multiply || (op == OpCode::Divide && c != 0.0f))
+				{
+					ins.removeLast();
+					ins.add({ OpCode::MultiplyConstant, 0, op == OpCode::Multiply ? c : 1.0f / c });
+					return;
+				}
+			}
+
+			break;
+		}
+
+		if (stackSize > MaxStackSize)
+			throwError("expression too complex");
+
+		ins.add({ op, index, value });
+	}
+
+	void skipWhitespace()
+	{
+		while (CharacterFunctions::isWhitespace(*it))
+			++it;
+	}
+
+	bool matchChar(juce_wchar c)
+	{
+		skipWhitespace();
+
+		if (*it == c)
+		{
+			++it;
+			return true;
+		}
+
+		return false;
+	}
+
+	void expectChar(juce_wchar c)
+	{
+		if (!matchChar(c))
+			throwError("expected " + String::charToString(c));
+	}
+
+	void throwError(const String& message)
+	{
+		throw String("eval: " + message + " in " + parent.code.quoted());
+	}
+
+	Expression& parent;
+	String::CharPointerType it;
+	int stackSize = 0;
+};
+
+VariantBuffer::Expression::Expression(const String& code_) :
+	code(code_)
+{
+	Parser p(*this);
+	p.parse();
+}
+
+VariantBuffer::Expression::Ptr VariantBuffer::Expression::getOrCreate(const String& code)
+{
+	static SpinLock cacheLock;
+	static ReferenceCountedArray<Expression> cache;
+
+	{
+		SpinLock::ScopedLockType sl(cacheLock);
+
+		for (auto e : cache)
+		{
+			if (e->code == code)
+				return e;
+		}
+	}
+
+	Ptr e = new Expression(code);
+
+	SpinLock::ScopedLockType sl(cacheLock);
+
+	if (cache.size() > 256)
+		cache.remove(0);
+
+	cache.add(e);
+	return e;
+}
+
+void VariantBuffer::Expression::evaluate(VariantBuffer& target, const var& variables) const
+{
+	const float* sources[MaxNumVariables];
+	float scalars[MaxNumVariables];
+
+	auto numSamples = target.size;
+
+	for (int i = 0; i < variableNames.size(); i++)
+	{
+		auto v = variables.getProperty(variableNames[i], var());
+
+		if (auto b = v.getBuffer())
+		{
+			CHECK_CONDITION(b->size >= numSamples, "eval: buffer " + variableNames[i].toString() + " too small");
+			sources[i] = b->buffer.getReadPointer(0);
+		}
+		else if (v.isInt() || v.isInt64() || v.isDouble() || v.isBool())
+		{
+			sources[i] = nullptr;
+			scalars[i] = (float)v;
+			FloatSanitizers::sanitizeFloatNumber(scalars[i]);
+		}
+		else
+			throw String("eval: undefined variable " + variableNames[i].toString());
+	}
+
+	float stack[MaxStackSize][ChunkSize];
+	auto dst = target.buffer.getWritePointer(0);
+
+	for (int offset = 0; offset < numSamples; offset += ChunkSize)
+	{
+		auto n = jmin(ChunkSize, numSamples - offset);
+		int sp = 0;
+
+		for (const auto& ins : instructions)
+		{
+			switch (ins.op)
+			{
+			case OpCode::PushVariable:
+				if (auto s = sources[ins.index])
+					FloatVectorOperations::copy(stack[sp], s + offset, n);
+				else
+					FloatVectorOperations::fill(stack[sp], scalars[ins.index], n);
+
+				sp++;
+				break;
+			case OpCode::PushConstant:
+				FloatVectorOperations::fill(stack[sp++], ins.value, n);
+				break;
+			case OpCode::Add:
+				FloatVectorOperations::add(stack[sp - 2], stack[sp - 1], n);
+				sp--;
+				break;
+			case OpCode::Subtract:
+				FloatVectorOperations::subtract(stack[sp - 2], stack[sp - 1], n);
+				sp--;
+				break;
+			case OpCode::Multiply:
+				FloatVectorOperations::multiply(stack[sp - 2], stack[sp - 1], n);
+				sp--;
+				break;
+			case OpCode::Divide:
+			{
+				auto d = stack[sp - 2];
+				auto s = stack[sp - 1];
+
+				for (int i = 0; i < n; i++)
+					d[i] /= s[i];
+
+				sp--;
+				break;
+			}
+			case OpCode::AddConstant:
+				FloatVectorOperations::add(stack[sp - 1], ins.value, n);
+				break;
+			case OpCode::MultiplyConstant:
+				FloatVectorOperations::multiply(stack[sp - 1], ins.value, n);
+				break;
+			case OpCode::Negate:
+				FloatVectorOperations::negate(stack[sp - 1], stack[sp - 1], n);
+				break;
+			case OpCode::Abs:
+				FloatVectorOperations::abs(stack[sp - 1], stack[sp - 1], n);
+				break;
+			case OpCode::Min:
+				FloatVectorOperations::min(stack[sp - 2], stack[sp - 2], stack[sp - 1], n);
+				sp--;
+				break;
+			case OpCode::Max:
+				FloatVectorOperations::max(stack[sp - 2], stack[sp - 2], stack[sp - 1], n);
+				sp--;
+				break;
+			}
+		}
+
+		jassert(sp == 1);
+		FloatVectorOperations::copy(dst + offset, stack[0], n);
+	}
+
+	FloatSanitizers::sanitizeArray(dst, numSamples);
+}
+
 VariantBuffer::Factory::Factory(int stackSize_) :
 stackSize(stackSize_)
 {
@@ -691,4 +1084,168 @@ void operator>>(float f, VariantBuffer &b)
 	FloatVectorOperations::fill(b.buffer.getWritePointer(0), f, b.size);
 }
 
+#if HI_RUN_UNIT_TESTS
+
+/** Checks the fused buffer expressions against the operators and compares their speed. */
+class VariantBufferExpressionTest : public UnitTest
+{
+public:
+
+	static constexpr int BufferSize = 1000;
+	static constexpr int NumIterations = 20000;
+
+	VariantBufferExpressionTest() :
+		UnitTest("Testing buffer expressions", "Benchmark")
+	{}
+
+	void runTest() override
+	{
+		testParser();
+		testResult();
+		testSpeed();
+	}
+
+private:
+
+	VariantBuffer::Ptr createRandomBuffer(Random& r)
+	{
+		VariantBuffer::Ptr b = new VariantBuffer(BufferSize);
+
+		for (int i = 0; i < BufferSize; i++)
+			b->buffer.setSample(0, i, r.nextFloat() * 2.0f - 1.0f);
+
+		return b;
+	}
+
+	void testParser()
+	{
+		beginTest("Testing expression parser");
+
+		auto expectError = [this](const String& code)
+		{
+			try
+			{
+				VariantBuffer::Expression e(code);
+				expect(false, "no error for " + code);
+			}
+			catch (String&)
+			{
+			}
+		};
+
+		expectError("");
+		expectError("a +");
+		expectError("(a * b");
+		expectError("foo(a)");
+		expectError("min(a)");
+		expectError("a $ b");
+
+		VariantBuffer::Expression e("a * 0.5 + min(b, a) - abs(-c) / 2");
+		expectEquals(e.getVariableNames().size(), 3, "wrong variable amount");
+
+		expect(VariantBuffer::Expression::getOrCreate("a + b") == VariantBuffer::Expression::getOrCreate("a + b"), "expression isn't cached");
+	}
+
+	void testResult()
+	{
+		beginTest("Testing expression result");
+
+		Random r(42);
+
+		auto a = createRandomBuffer(r);
+		auto c = createRandomBuffer(r);
+		auto d = createRandomBuffer(r);
+
+		VariantBuffer::Ptr target = new VariantBuffer(BufferSize);
+
+		auto obj = new DynamicObject();
+		obj->setProperty("a", var(a.get()));
+		obj->setProperty("c", var(c.get()));
+		obj->setProperty("d", var(d.get()));
+		obj->setProperty("g", 0.25);
+		var variables(obj);
+
+		VariantBuffer::Expression e("max(a * 0.5 + c * d, -g) / (2 - a) - -1e-1");
+		e.evaluate(*target, variables);
+
+		float maxError = 0.0f;
+
+		for (int i = 0; i < BufferSize; i++)
+		{
+			auto av = a->buffer.getSample(0, i);
+			auto expected = jmax(av * 0.5f + c->buffer.getSample(0, i) * d->buffer.getSample(0, i), -0.25f) / (2.0f - av) + 0.1f;
+			maxError = jmax(maxError, std::abs(expected - target->buffer.getSample(0, i)));
+		}
+
+		expect(maxError < 1e-5f, "Error: " + String(maxError));
+
+		// The target can be used as variable
+		obj->setProperty("t", var(target.get()));
+		VariantBuffer::Expression("t * 0").evaluate(*target, variables);
+
+		expectEquals(target->buffer.getMagnitude(0, BufferSize), 0.0f, "target not cleared");
+	}
+
+	void testSpeed()
+	{
+		beginTest("Comparing fused expression with the operators");
+
+		Random r(42);
+
+		auto a = createRandomBuffer(r);
+		auto c = createRandomBuffer(r);
+		auto d = createRandomBuffer(r);
+
+		VariantBuffer::Ptr chained = new VariantBuffer(BufferSize);
+		VariantBuffer::Ptr temp = new VariantBuffer(BufferSize);
+		VariantBuffer::Ptr fused = new VariantBuffer(BufferSize);
+
+		auto obj = new DynamicObject();
+		obj->setProperty("a", var(a.get()));
+		obj->setProperty("c", var(c.get()));
+		obj->setProperty("d", var(d.get()));
+		var variables(obj);
+
+		auto e = VariantBuffer::Expression::getOrCreate("(a * 0.5 + c * d) * 0.8 - a * c");
+
+		auto start = Time::getHighResolutionTicks();
+
+		for (int i = 0; i < NumIterations; i++)
+		{
+			*chained << *a;
+			*chained *= 0.5f;
+			*temp << *c;
+			*temp *= *d;
+			*chained += *temp;
+			*chained *= 0.8f;
+			*temp << *a;
+			*temp *= *c;
+			*chained -= *temp;
+		}
+
+		auto chainedSeconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+
+		start = Time::getHighResolutionTicks();
+
+		for (int i = 0; i < NumIterations; i++)
+			e->evaluate(*fused, variables);
+
+		auto fusedSeconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+
+		float maxError = 0.0f;
+
+		for (int i = 0; i < BufferSize; i++)
+			maxError = jmax(maxError, std::abs(chained->buffer.getSample(0, i) - fused->buffer.getSample(0, i)));
+
+		expect(maxError < 1e-5f, "Error: " + String(maxError));
+
+		logMessage("Chained operators: " + String(chainedSeconds * 1000.0, 2) + "ms");
+		logMessage("Fused expression: " + String(fusedSeconds * 1000.0, 2) + "ms");
+	}
+};
+
+static VariantBufferExpressionTest variantBufferExpressionTest;
+
+#endif
+
 } // namespace juce
@@ -130,7 +130,73 @@ public:
 
 	String toDebugString() const;
 	
+	/** A compiled expression that calculates a whole buffer in a single pass.
 	
+		The expression can use +, -, *, /, parentheses, numbers, the functions abs(x), min(a, b), max(a, b)
+		and variables that are either buffers or numbers. Instead of running each operation over the
+		entire buffer (and allocating temporary buffers), the samples are processed in small chunks that
+		live on the stack, so every operation is still vectorised, but each buffer is only read once.
+
+			b.eval("a * 0.5 + c * d", { a: a, c: c, d: d });
+	*/
+	class Expression : public ReferenceCountedObject
+	{
+	public:
+
+		using Ptr = ReferenceCountedObjectPtr<Expression>;
+
+		/** Parses the expression. Throws a String if there is a syntax error. */
+		Expression(const String& code);
+
+		/** Returns the expression from a global cache so that it's only parsed once. */
+		static Ptr getOrCreate(const String& code);
+
+		/** Calculates the expression and writes the result into the target buffer.
+		
+			The variables must be an object with a buffer or a number for each variable of the expression.
+			This doesn't allocate, so you can call it in the audio callback.
+		*/
+		void evaluate(VariantBuffer& target, const var& variables) const;
+
+		const String& getCode() const { return code; }
+
+		const Array<Identifier>& getVariableNames() const { return variableNames; }
+
+		static constexpr int ChunkSize = 64;
+		static constexpr int MaxStackSize = 16;
+		static constexpr int MaxNumVariables = 16;
+
+	private:
+
+		enum class OpCode : uint8
+		{
+			PushVariable,
+			PushConstant,
+			Add,
+			Subtract,
+			Multiply,
+			Divide,
+			AddConstant,
+			MultiplyConstant,
+			Negate,
+			Abs,
+			Min,
+			Max
+		};
+
+		struct Instruction
+		{
+			OpCode op;
+			int index;
+			float value;
+		};
+
+		struct Parser;
+
+		String code;
+		Array<Instruction> instructions;
+		Array<Identifier> variableNames;
+	};
 	
 	class Factory : public DynamicObject
 	{
@@ -170,6 +170,19 @@ public:
 		print("");
 		print("run_unit_tests");
 		print("Runs the unit tests. In order for this to work, HISE must be built with the CI configuration");
+		print("");
+		print("render -p:PATH -m:MIDI_FILE -o:OUTPUT_FILE [-bs:BLOCKSIZE] [-sr:SAMPLERATE] [-tail:SECONDS]");
+		print("       [-json:REPORT_FILE] [-deterministic]");
+		print("Loads the given project file without the GUI, renders the MIDI file and writes the output");
+		print("as 32bit WAV file. The timings are printed as JSON (or written to the -json: file).");
+		print(" - the progress is printed to stderr, so stdout only contains the JSON report.");
+		print(" - the block size defaults to 512 samples, the sample rate to 44100Hz.");
+		print(" - the tail is the time rendered after the last MIDI event (default: 1 second).");
+		print(" - use -deterministic to seed the random generator for diffable output.");
+		print("");
+		print("benchmark -p:PATH -m:MIDI_FILE [-n:ITERATIONS] [-bs:BLOCKSIZE] [-sr:SAMPLERATE] [-json:REPORT_FILE]");
+		print("Renders the MIDI file multiple times (default: 10) and reports the realtime factor, the");
+		print("block timings and the per-module CPU statistics as JSON.");
 
 		exit(0);
 	}
@@ -256,10 +269,13 @@ public:
 		else throwErrorAndQuit(pd.getFullPathName() + " is not a valid folder");
 	}
 	
-	static int loadPresetFile(const String& commandLine, const std::function<Result(BackendProcessor*)>& additionalFunction = {})
+	static int loadPresetFile(const String& commandLine, const std::function<Result(BackendProcessor*)>& additionalFunction = {}, bool printProgressToStdErr=false)
 	{
 		auto args = getCommandLineArgs(commandLine);
 
+		// Commands that print their result to stdout write the progress to stderr
+		std::ostream& progress = printProgressToStdErr ? std::cerr : std::cout;
+
 		CompileExporter::setExportingFromCommandLine();
 		
 		ScopedPointer<StandaloneProcessor> processor = new StandaloneProcessor();
@@ -282,7 +298,7 @@ public:
 			GET_PROJECT_HANDLER(mainSynthChain).setWorkingProject(projectDirectory);
 		}
 
-		std::cout << "Loading the preset...";
+		progress << "Loading the preset...";
 
 		try
 		{
@@ -312,7 +328,7 @@ public:
 			return 1;
 		}
 		
-		std::cout << "DONE" << std::endl << std::endl;
+		progress << "DONE" << std::endl << std::endl;
 
 		if (additionalFunction)
 		{
@@ -331,6 +347,91 @@ public:
 		return 0;
 	}
 
+	static int renderMidiFile(const String& commandLine, bool isBenchmark)
+	{
+		auto args = getCommandLineArgs(commandLine);
+
+		HeadlessRenderer::Options options;
+
+		auto midiPath = getArgument(args, "-m:");
+
+		if (midiPath.isEmpty())
+			throwErrorAndQuit("You need to supply a MIDI file with the `-m:` argument");
+
+		options.midiFile = File::isAbsolutePath(midiPath) ? File(midiPath) : File::getCurrentWorkingDirectory().getChildFile(midiPath);
+
+		if (!options.midiFile.existsAsFile())
+			throwErrorAndQuit("`" + midiPath + "` is not a valid MIDI file");
+
+		auto outputPath = getArgument(args, "-o:");
+
+		if (outputPath.isNotEmpty())
+			options.outputFile = File::isAbsolutePath(outputPath) ? File(outputPath) : File::getCurrentWorkingDirectory().getChildFile(outputPath);
+		else if (!isBenchmark)
+			throwErrorAndQuit("You need to supply an output file with the `-o:` argument");
+
+		auto blockSize = getArgument(args, "-bs:");
+		auto sampleRate = getArgument(args, "-sr:");
+		auto tail = getArgument(args, "-tail:");
+		auto iterations = getArgument(args, "-n:");
+
+		if (blockSize.isNotEmpty())
+			options.blockSize = blockSize.getIntValue();
+
+		if (sampleRate.isNotEmpty())
+			options.sampleRate = sampleRate.getDoubleValue();
+
+		if (tail.isNotEmpty())
+			options.tailSeconds = jmax(0.0, tail.getDoubleValue());
+
+		options.numIterations = isBenchmark ? 10 : 1;
+
+		if (iterations.isNotEmpty())
+			options.numIterations = jmax(1, iterations.getIntValue());
+
+		options.deterministic = args.contains("-deterministic");
+
+		if (options.blockSize <= 0 || options.blockSize % HISE_EVENT_RASTER != 0)
+			throwErrorAndQuit("The block size must be a multiple of " + String(HISE_EVENT_RASTER));
+
+		if (options.sampleRate <= 0.0)
+			throwErrorAndQuit("Invalid sample rate");
+
+		auto jsonPath = getArgument(args, "-json:");
+		File jsonFile;
+
+		if (jsonPath.isNotEmpty())
+			jsonFile = File::isAbsolutePath(jsonPath) ? File(jsonPath) : File::getCurrentWorkingDirectory().getChildFile(jsonPath);
+
+		return loadPresetFile(commandLine, [options, jsonFile](BackendProcessor* bp)
+		{
+			std::cerr << "Rendering " << options.midiFile.getFileName() << "...";
+
+			HeadlessRenderer renderer(bp, options);
+
+			auto ok = renderer.render();
+
+			if (ok.failed())
+				return ok;
+
+			std::cerr << "DONE" << std::endl << std::endl;
+
+			auto json = JSON::toString(renderer.getReport());
+
+			if (jsonFile != File())
+			{
+				if (!jsonFile.replaceWithText(json))
+					return Result::fail("Can't write the report to " + jsonFile.getFullPathName());
+
+				std::cerr << "The report was written to " << jsonFile.getFullPathName() << std::endl;
+			}
+			else
+				print(json);
+
+			return Result::ok();
+		}, true);
+	}
+
 	static void compileNetworks(const String& commandLine)
 	{
 		auto args = getCommandLineArgs(commandLine);
@@ -723,6 +824,19 @@ public:
 			}
 				
 
+			quit();
+			return;
+		}
+		else if (commandLine.startsWith("render ") || commandLine.startsWith("benchmark "))
+		{
+			auto ok = CommandLineActions::renderMidiFile(commandLine, commandLine.startsWith("benchmark "));
+
+			if (ok != 0)
+			{
+				exit(ok);
+				return;
+			}
+
 			quit();
 			return;
 		}